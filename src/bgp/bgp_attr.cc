@@ -903,6 +903,7 @@ BgpAttr::BgpAttr()
       med_(0), local_pref_(0), atomic_aggregate_(false),
       aggregator_as_num_(0), aggregator_as4_num_(0), params_(0) {
     refcount_ = 0;
+    encoding_cache_ = NULL;
 }
 
 BgpAttr::BgpAttr(BgpAttrDB *attr_db)
@@ -910,6 +911,7 @@ BgpAttr::BgpAttr(BgpAttrDB *attr_db)
       nexthop_(), med_(0), local_pref_(0), atomic_aggregate_(false),
       aggregator_as_num_(0), aggregator_as4_num_(0), params_(0) {
     refcount_ = 0;
+    encoding_cache_ = NULL;
 }
 
 BgpAttr::BgpAttr(BgpAttrDB *attr_db, const BgpAttrSpec &spec)
@@ -920,6 +922,7 @@ BgpAttr::BgpAttr(BgpAttrDB *attr_db, const BgpAttrSpec &spec)
       aggregator_as_num_(0), aggregator_as4_num_(0), 
       aggregator_address_(), params_(0) {
     refcount_ = 0;
+    encoding_cache_ = NULL;
     for (vector<BgpAttribute *>::const_iterator it = spec.begin();
          it < spec.end(); it++) {
         (*it)->ToCanonical(this);
@@ -952,6 +955,56 @@ BgpAttr::BgpAttr(const BgpAttr &rhs)
       leaf_olist_(rhs.leaf_olist_),
       sub_protocol_(rhs.sub_protocol_) {
     refcount_ = 0;
+    encoding_cache_ = NULL;
+}
+
+struct BgpAttr::EncodingCache {
+    EncodingCache() {
+        for (int idx = 0; idx < kEncodingVariantCount; ++idx) {
+            encodings[idx] = NULL;
+        }
+    }
+    ~EncodingCache() {
+        for (int idx = 0; idx < kEncodingVariantCount; ++idx) {
+            delete encodings[idx].load();
+        }
+    }
+    std::atomic<Encoding *> encodings[kEncodingVariantCount];
+};
+
+BgpAttr::~BgpAttr() {
+    delete encoding_cache_.load();
+}
+
+const BgpAttr::Encoding *BgpAttr::GetEncoding(int variant) const {
+    assert(variant >= 0 && variant < kEncodingVariantCount);
+    EncodingCache *cache = encoding_cache_;
+    return cache ? cache->encodings[variant].load() : NULL;
+}
+
+//
+// Concurrency: may be called from multiple bgp::SendUpdate tasks at the same
+// time. The first encoding to be set for a variant is kept and returned, and
+// the caller's encoding is deleted if it loses the race.
+//
+const BgpAttr::Encoding *BgpAttr::SetEncoding(int variant,
+    Encoding *encoding) const {
+    assert(variant >= 0 && variant < kEncodingVariantCount);
+    EncodingCache *cache = encoding_cache_;
+    if (!cache) {
+        EncodingCache *new_cache = new EncodingCache;
+        if (encoding_cache_.compare_exchange_strong(cache, new_cache)) {
+            cache = new_cache;
+        } else {
+            delete new_cache;
+        }
+    }
+
+    Encoding *current = NULL;
+    if (cache->encodings[variant].compare_exchange_strong(current, encoding))
+        return encoding;
+    delete encoding;
+    return current;
 }
 
 void BgpAttr::set_as_path(AsPathPtr aspath) {
@@ -828,7 +828,7 @@ public:
     explicit BgpAttr(BgpAttrDB *attr_db);
     explicit BgpAttr(const BgpAttr &rhs);
     BgpAttr(BgpAttrDB *attr_db, const BgpAttrSpec &spec);
-    virtual ~BgpAttr() { }
+    virtual ~BgpAttr();
     virtual void Remove();
 
     int CompareTo(const BgpAttr &rhs) const;
@@ -938,6 +938,18 @@ public:
     bool evpn_single_active() const;
     MacAddress mac_address() const;
 
+    // Wire encoding of the path attributes in an UPDATE message. There is a
+    // separate encoding for each variant of the message e.g. with 2 or 4
+    // byte AS numbers, see BgpMessage. Variants starting at
+    // kXmppEncodingVariantBase hold XMPP item templates, see BgpXmppMessage.
+    // The encoding is built on demand and kept as long as the attribute,
+    // which is immutable once located in the BgpAttrDB.
+    typedef std::vector<uint8_t> Encoding;
+    static const int kXmppEncodingVariantBase = 8;
+    static const int kEncodingVariantCount = 20;
+    const Encoding *GetEncoding(int variant) const;
+    const Encoding *SetEncoding(int variant, Encoding *encoding) const;
+
 private:
     friend class BgpAttrDB;
     friend class BgpAttrTest;
@@ -945,7 +957,10 @@ private:
     friend int intrusive_ptr_del_ref(const BgpAttr *cattrp);
     friend void intrusive_ptr_release(const BgpAttr *cattrp);
 
+    struct EncodingCache;
+
     mutable std::atomic<int> refcount_;
+    mutable std::atomic<EncodingCache *> encoding_cache_;
     BgpAttrDB *attr_db_;
     BgpAttrOrigin::OriginType origin_;
     IpAddress nexthop_;
@@ -112,8 +112,16 @@ struct BgpProtoPrefix : public ParseObject {
 // Base class to manage BGP Path Attributes database. This class provides
 // thread safe access to the data base.
 //
-// Lock contention can be tuned by varying the hash table size passed to the
-// constructor.
+// The data base is partitioned into shards by the hash of the attribute
+// contents, each with its own set and mutex, so that concurrent Locate and
+// Delete calls from different db::DBTable task instances only contend when
+// they hit the same shard. The shards are cache line aligned so that the
+// mutexes of adjacent shards don't share a line.
+//
+// Lock contention can be tuned by varying the number of shards passed to the
+// constructor, which can also be set via BGP_PATH_ATTRIBUTE_DB_HASH_SIZE.
+// Each shard counts the number of times its mutex was found to be held when
+// it was needed.
 //
 // Attribute contents must be hashable via hash_value() and hashed using
 // boost::hash_combine() to partition the attribute database.
@@ -122,27 +130,57 @@ template <class Type, class TypePtr, class TypeSpec, typename TypeCompare,
           class TypeDB>
 class BgpPathAttributeDB {
 public:
+    static const size_t kDefaultHashSize = 64;
+
+    struct Stats {
+        Stats()
+            : locates(0), inserts(0), deletes(0), contended(0), retries(0) {
+        }
+
+        uint64_t locates;
+        uint64_t inserts;
+        uint64_t deletes;
+        uint64_t contended;
+        uint64_t retries;
+    };
+
     explicit BgpPathAttributeDB(int hash_size = GetHashSize())
-        : hash_size_(hash_size),
-          set_(new Set[hash_size]),
-          mutex_(new std::mutex[hash_size]) {
+        : hash_size_(hash_size ? hash_size : 1),
+          shard_(new Shard[hash_size_]) {
     }
 
     size_t Size() {
         size_t size = 0;
 
         for (size_t i = 0; i < hash_size_; i++) {
-            std::scoped_lock lock(mutex_[i]);
-            size += set_[i].size();
+            std::scoped_lock lock(shard_[i].mutex);
+            size += shard_[i].set.size();
         }
         return size;
     }
 
+    size_t hash_size() const { return hash_size_; }
+
+    // Sum of the counters of all the shards.
+    void GetStats(Stats *stats) {
+        for (size_t i = 0; i < hash_size_; i++) {
+            std::scoped_lock lock(shard_[i].mutex);
+            const Stats &shard_stats = shard_[i].stats;
+            stats->locates += shard_stats.locates;
+            stats->inserts += shard_stats.inserts;
+            stats->deletes += shard_stats.deletes;
+            stats->contended += shard_stats.contended;
+            stats->retries += shard_stats.retries;
+        }
+    }
+
     void Delete(Type *attr) {
-        size_t hash = HashCompute(attr);
+        Shard *shard = &shard_[HashCompute(attr)];
 
-        std::scoped_lock lock(mutex_[hash]);
-        assert(set_[hash].erase(attr));
+        std::unique_lock<std::mutex> lock;
+        Lock(shard, &lock);
+        assert(shard->set.erase(attr));
+        shard->stats.deletes++;
     }
 
     // Locate passed in attribute in the data base based on the attr ptr.
@@ -157,6 +195,14 @@ public:
     }
 
 private:
+    typedef std::set<Type *, TypeCompare> Set;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Set set;
+        Stats stats;
+    };
+
     const size_t HashCompute(Type *attr) const {
         if (hash_size_ <= 1) return 0;
 
@@ -168,11 +214,19 @@ private:
     static size_t GetHashSize() {
         char *str = getenv("BGP_PATH_ATTRIBUTE_DB_HASH_SIZE");
 
-        // Use just one bucket for now.
-        if (!str) return 1;
+        if (!str) return kDefaultHashSize;
         return strtoul(str, NULL, 0);
     }
 
+    // Acquire the mutex of the shard, counting the times it is already held.
+    static void Lock(Shard *shard, std::unique_lock<std::mutex> *lock) {
+        *lock = std::unique_lock<std::mutex>(shard->mutex, std::try_to_lock);
+        if (!lock->owns_lock()) {
+            lock->lock();
+            shard->stats.contended++;
+        }
+    }
+
     // This template safely retrieves an attribute entry from its data base.
     // If the entry is not found, it is inserted into the database.
     //
@@ -180,14 +234,15 @@ private:
     // existing entry is returned.
     TypePtr LocateInternal(Type *attr) {
         // Hash attribute contents to to avoid potential mutex contention.
-        size_t hash = HashCompute(attr);
+        Shard *shard = &shard_[HashCompute(attr)];
         while (true) {
             // Grab mutex to keep db access thread safe.
-            std::scoped_lock lock(mutex_[hash]);
+            std::unique_lock<std::mutex> lock;
+            Lock(shard, &lock);
             std::pair<typename Set::iterator, bool> ret;
 
             // Try to insert the passed entry into the database.
-            ret = set_[hash].insert(attr);
+            ret = shard->set.insert(attr);
 
             // Take a reference to prevent this entry from getting deleted.
             // Counter is automatically incremented, hence we get thread safety
@@ -196,6 +251,9 @@ private:
 
             // Check if passed in entry did get into the data base.
             if (ret.second) {
+                shard->stats.locates++;
+                shard->stats.inserts++;
+
                 // Take intrusive pointer, thereby incrementing the refcount.
                 TypePtr ptr = TypePtr(*ret.first);
 
@@ -216,6 +274,7 @@ private:
             if (prev > 0) {
                 // Free passed in attribute, as it is already in the database.
                 delete attr;
+                shard->stats.locates++;
 
                 // Take intrusive pointer, thereby incrementing the refcount.
                 TypePtr ptr = TypePtr(*ret.first);
@@ -230,16 +289,15 @@ private:
             // which is about to be deleted. Instead, retry inserting the passed
             // entry again, into the database.
             intrusive_ptr_del_ref(*ret.first);
+            shard->stats.retries++;
         }
 
         assert(false);
         return NULL;
     }
 
-    typedef std::set<Type *, TypeCompare> Set;
     size_t hash_size_;
-    boost::scoped_array<Set> set_;
-    boost::scoped_array<std::mutex> mutex_;
+    boost::scoped_array<Shard> shard_;
 };
 
 #endif  // SRC_BGP_BGP_ATTR_BASE_H_
@@ -714,7 +714,11 @@ EvpnManagerPartition::EvpnManagerPartition(EvpnManager *evpn_manager,
       mac_update_trigger_(new TaskTrigger(
           boost::bind(&EvpnManagerPartition::ProcessMacUpdateList, this),
           TaskScheduler::GetInstance()->GetTaskId("db::DBTable"),
-          part_id)) {
+          part_id)),
+      mac_update_requests_(0),
+      mac_updates_coalesced_(0),
+      mac_updates_(0),
+      mac_update_batches_(0) {
     table_partition_ = evpn_manager_->GetTablePartition(part_id);
 }
 
@@ -884,20 +888,30 @@ void EvpnManagerPartition::UpdateMcastNode(EvpnMcastNode *node, EvpnRoute *rt) {
 void EvpnManagerPartition::TriggerMacRouteUpdate(EvpnRoute *route) {
     CHECK_CONCURRENCY("db::DBTable", "bgp::EvpnSegment");
 
-    mac_update_list_.insert(route);
+    mac_update_requests_++;
+    if (!mac_update_list_.insert(route).second)
+        mac_updates_coalesced_++;
     mac_update_trigger_->Set();
 }
 
 //
 // Process the MAC route update list for this EvpnManagerPartition.
 //
+// At most kMaxMacUpdateBatch routes are processed in one run. Return false
+// to get the task rescheduled if there are more routes on the list.
+//
 bool EvpnManagerPartition::ProcessMacUpdateList() {
     CHECK_CONCURRENCY("db::DBTable");
 
     BgpTable *table = evpn_manager_->table();
     int listener_id = evpn_manager_->listener_id();
 
-    BOOST_FOREACH(EvpnRoute *route, mac_update_list_) {
+    size_t count = 0;
+    for (EvpnRouteList::iterator it = mac_update_list_.begin();
+         it != mac_update_list_.end() && count < kMaxMacUpdateBatch;
+         it = mac_update_list_.erase(it), ++count) {
+        EvpnRoute *route = *it;
+
         // Skip if the route is on the change list. We will get another
         // chance to process it after the MacAdvertisement listener sees
         // it and changes the EvpnMacState to point to the updated value
@@ -924,7 +938,10 @@ bool EvpnManagerPartition::ProcessMacUpdateList() {
         }
     }
 
-    mac_update_list_.clear();
+    mac_updates_ += count;
+    mac_update_batches_++;
+    if (!mac_update_list_.empty())
+        return false;
     evpn_manager_->RetryDelete();
     return true;
 }
@@ -1655,6 +1672,21 @@ void EvpnManager::FillShowInfo(ShowEvpnTable *sevt) const {
     sevt->set_regular_nves(regular_nves);
     sevt->set_ar_replicators(ar_replicators);
     sevt->set_ar_leafs(ar_leafs);
+
+    uint64_t mac_update_requests = 0;
+    uint64_t mac_updates_coalesced = 0;
+    uint64_t mac_updates = 0;
+    uint64_t mac_update_batches = 0;
+    BOOST_FOREACH(const EvpnManagerPartition *partition, partitions_) {
+        mac_update_requests += partition->mac_update_requests();
+        mac_updates_coalesced += partition->mac_updates_coalesced();
+        mac_updates += partition->mac_updates();
+        mac_update_batches += partition->mac_update_batches();
+    }
+    sevt->set_mac_update_requests(mac_update_requests);
+    sevt->set_mac_updates_coalesced(mac_updates_coalesced);
+    sevt->set_mac_updates(mac_updates);
+    sevt->set_mac_update_batches(mac_update_batches);
 }
 
 //
@@ -11,6 +11,7 @@
 
 #include <list>
 #include <set>
+#include <unordered_set>
 #include <vector>
 #include <atomic>
 
@@ -191,7 +192,9 @@ private:
 /// on it. There's a list entry in the vector for each DB partition.  All the
 /// MAC routes in a given partition that are associated with the EvpnSegment are
 /// in inserted in the list for that partition. The lists are updated as and
-/// when the EvpnSegment for MAC routes is updated.
+/// when the EvpnSegment for MAC routes is updated. The lists are hash sets
+/// since they are only walked as a whole, so adding and removing a MAC route
+/// during VM mobility doesn't have to rebalance a tree.
 ///
 /// An EvpnSegment contains a list of Remote PEs that have advertised per-ESI
 /// AD routes for the EVPN segment in question. The list is updated when paths
@@ -259,7 +262,7 @@ public:
     bool single_active() const { return single_active_; }
 
 private:
-    typedef std::set<EvpnRoute *> RouteList;
+    typedef std::unordered_set<EvpnRoute *> RouteList;
     typedef std::vector<RouteList> RouteListVector;
 
     EvpnManager *evpn_manager_;
@@ -415,12 +418,16 @@ private:
 ///
 /// An EvpnManagerPartition contains a set of MAC routes whose alias paths need
 /// to be updated. Entries are added to the list using the TriggerMacRouteUpdate
-/// method.
+/// method. Repeated updates for a MAC route coalesce into one entry, and the
+/// set is processed in batches of kMaxMacUpdateBatch routes so that a burst of
+/// MAC moves doesn't hold up other work in the db::DBTable partition task.
 class EvpnManagerPartition {
 public:
     typedef EvpnState::SG SG;
     typedef std::map<SG, std::set<EvpnMcastNode *> > EvpnMcastNodeList;
 
+    static const size_t kMaxMacUpdateBatch = 1024;
+
     EvpnManagerPartition(EvpnManager *evpn_manager, size_t part_id);
     ~EvpnManagerPartition();
 
@@ -489,11 +496,16 @@ public:
 
     size_t part_id() const { return part_id_; }
 
+    uint64_t mac_update_requests() const { return mac_update_requests_; }
+    uint64_t mac_updates_coalesced() const { return mac_updates_coalesced_; }
+    uint64_t mac_updates() const { return mac_updates_; }
+    uint64_t mac_update_batches() const { return mac_update_batches_; }
+
 private:
     friend class EvpnManager;
     friend class BgpEvpnManagerTest;
 
-    typedef std::set<EvpnRoute *> EvpnRouteList;
+    typedef std::unordered_set<EvpnRoute *> EvpnRouteList;
 
     /// @brief Process the MAC route update list for this EvpnManagerPartition.
     bool ProcessMacUpdateList();
@@ -529,6 +541,10 @@ private:
     EvpnMcastNodeList ir_client_node_list_;
     EvpnRouteList mac_update_list_;
     boost::scoped_ptr<TaskTrigger> mac_update_trigger_;
+    std::atomic<uint64_t> mac_update_requests_;
+    std::atomic<uint64_t> mac_updates_coalesced_;
+    std::atomic<uint64_t> mac_updates_;
+    std::atomic<uint64_t> mac_update_batches_;
 
     DISALLOW_COPY_AND_ASSIGN(EvpnManagerPartition);
 };
@@ -657,6 +673,7 @@ public:
 private:
     friend class BgpEvpnManagerTest;
     friend class BgpEvpnAliasingTest;
+    friend class EvpnMacChurnTest;
 
     class DeleteActor;
     typedef std::vector<EvpnManagerPartition *> PartitionList;
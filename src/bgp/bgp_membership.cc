@@ -8,6 +8,7 @@
 
 #include "base/task_annotations.h"
 #include "base/task_trigger.h"
+#include "base/time_util.h"
 #include "bgp/bgp_export.h"
 #include "bgp/bgp_log.h"
 #include "bgp/bgp_peer_types.h"
@@ -905,7 +906,8 @@ BgpMembershipManager::RibState::~RibState() {
 //
 void BgpMembershipManager::RibState::EnqueuePeerRibState(PeerRibState *prs) {
     request_count_++;
-    pending_peer_rib_list_.insert(prs);
+    if (pending_peer_rib_list_.insert(prs).second)
+        prs->set_request_at(ClockMonotonicUsec());
     manager_->EnqueueRibState(this);
 }
 
@@ -965,7 +967,11 @@ BgpMembershipManager::PeerRibState::PeerRibState(BgpMembershipManager *manager,
       ribin_registered_(false),
       ribout_registered_(false),
       instance_id_(-1),
-      subscription_gen_id_(0) {
+      subscription_gen_id_(0),
+      request_at_(0),
+      walk_wait_usecs_(0),
+      walk_usecs_(0),
+      walk_count_(0) {
 }
 
 //
@@ -1068,6 +1074,9 @@ void BgpMembershipManager::PeerRibState::FillMembershipInfo(
     smpi->set_ribout_registered(ribout_registered_);
     smpi->set_instance_id(instance_id_);
     smpi->set_generation_id(subscription_gen_id_);
+    smpi->set_walks(walk_count_);
+    smpi->set_last_walk_wait_usecs(walk_wait_usecs_);
+    smpi->set_last_walk_usecs(walk_usecs_);
 }
 
 //
@@ -1078,12 +1087,12 @@ BgpMembershipManager::Walker::Walker(BgpMembershipManager *manager)
       trigger_(new TaskTrigger(
           boost::bind(&BgpMembershipManager::Walker::WalkTrigger, this),
           TaskScheduler::GetInstance()->GetTaskId("bgp::PeerMembership"), 0)),
+      max_walks_(kDefaultMaxWalks),
       postpone_walk_(false),
-      walk_started_(false),
-      walk_completed_(false),
-      rs_(NULL),
-      rib_state_list_size_(0),
-      ribout_state_list_size_(0) {
+      rib_state_list_size_(0) {
+    char *str = getenv("BGP_MEMBERSHIP_MAX_WALKS");
+    if (str && strtoul(str, NULL, 0) > 0)
+        max_walks_ = strtoul(str, NULL, 0);
 }
 
 //
@@ -1093,17 +1102,12 @@ BgpMembershipManager::Walker::~Walker() {
     assert(rib_state_set_.empty());
     assert(rib_state_list_.empty());
     assert(!postpone_walk_);
-    assert(!rs_);
-    assert(walk_ref_ == NULL);
-    assert(peer_rib_list_.empty());
-    assert(peer_list_.empty());
-    assert(ribout_state_map_.empty());
-    assert(ribout_state_list_.empty());
+    assert(walk_map_.empty());
 }
 
 //
 // Add the given RibState to the RibStateList if it's not already present.
-// Trigger processing of the RibStateList if a walk is not already in progress.
+// Trigger processing of the RibStateList if another walk can be started.
 //
 void BgpMembershipManager::Walker::Enqueue(RibState *rs) {
     if (rib_state_set_.find(rs) != rib_state_set_.end())
@@ -1111,7 +1115,7 @@ void BgpMembershipManager::Walker::Enqueue(RibState *rs) {
     rib_state_set_.insert(rs);
     rib_state_list_.push_back(rs);
     rib_state_list_size_++;
-    if (!walk_started_)
+    if (walk_map_.size() < max_walks_)
         trigger_->Set();
 }
 
@@ -1119,14 +1123,151 @@ void BgpMembershipManager::Walker::Enqueue(RibState *rs) {
 // Return true if the Walk does not have any pending items.
 //
 bool BgpMembershipManager::Walker::IsQueueEmpty() const {
-    return (rib_state_list_.empty() && !trigger_->IsSet() && !rs_);
+    return (rib_state_list_.empty() && !trigger_->IsSet() &&
+            walk_map_.empty());
+}
+
+//
+// Start a walk for the BgpTable corresponding to the first RibState in the
+// RibStateList that does not have an ongoing walk.
+// Return false if there's no such RibState.
+//
+bool BgpMembershipManager::Walker::WalkStart() {
+    CHECK_CONCURRENCY("bgp::PeerMembership");
+
+    assert(rib_state_list_size_ == rib_state_set_.size());
+    for (RibStateList::iterator it = rib_state_list_.begin();
+         it != rib_state_list_.end(); ++it) {
+        RibState *rs = *it;
+        if (walk_map_.find(rs) != walk_map_.end())
+            continue;
+
+        // Remove the RibState from the RibStateList and start the walk.
+        rib_state_list_.erase(it);
+        rib_state_list_size_--;
+        assert(rib_state_set_.erase(rs) == 1);
+        TableWalk *walk = new TableWalk(this, rs);
+        walk_map_.insert(make_pair(rs, walk));
+        walk->Start(postpone_walk_);
+        return true;
+    }
+    return false;
+}
+
+//
+// Handler for TaskTrigger.
+// Finish processing for all completed walks and start new ones as long as
+// the number of ongoing walks is below the maximum.
+//
+bool BgpMembershipManager::Walker::WalkTrigger() {
+    CHECK_CONCURRENCY("bgp::PeerMembership");
+
+    for (TableWalkMap::iterator it = walk_map_.begin(), next = it;
+         it != walk_map_.end(); it = next) {
+        ++next;
+        TableWalk *walk = it->second;
+        if (!walk->completed())
+            continue;
+        walk->Finish();
+        walk_map_.erase(it);
+        delete walk;
+    }
+
+    while (walk_map_.size() < max_walks_ && WalkStart()) {
+    }
+    return true;
+}
+
+size_t BgpMembershipManager::Walker::GetPeerListSize() const {
+    size_t size = 0;
+    for (TableWalkMap::const_iterator it = walk_map_.begin();
+         it != walk_map_.end(); ++it) {
+        size += it->second->peer_list_size();
+    }
+    return size;
+}
+
+size_t BgpMembershipManager::Walker::GetPeerRibListSize() const {
+    size_t size = 0;
+    for (TableWalkMap::const_iterator it = walk_map_.begin();
+         it != walk_map_.end(); ++it) {
+        size += it->second->peer_rib_list_size();
+    }
+    return size;
+}
+
+size_t BgpMembershipManager::Walker::GetRibOutStateListSize() const {
+    size_t size = 0;
+    for (TableWalkMap::const_iterator it = walk_map_.begin();
+         it != walk_map_.end(); ++it) {
+        size += it->second->ribout_state_list_size();
+    }
+    return size;
+}
+
+//
+// Disable the TaskTrigger so that the Walker can accumulate RibStates in the
+// RibStateList.
+// Testing only.
+//
+void BgpMembershipManager::Walker::SetQueueDisable(bool value) {
+    if (value) {
+        trigger_->set_disable();
+    } else {
+        trigger_->set_enable();
+    }
+}
+
+//
+// Force the Walker to postpone walks that are started from now on.
+// Testing only.
+//
+void BgpMembershipManager::Walker::PostponeWalk() {
+    assert(walk_map_.empty());
+    postpone_walk_ = true;
+}
+
+//
+// Tell the DBTableWalkMgr to resume walks that were postponed previously.
+// Testing only.
+//
+void BgpMembershipManager::Walker::ResumeWalk() {
+    assert(!walk_map_.empty());
+    postpone_walk_ = false;
+    for (TableWalkMap::iterator it = walk_map_.begin();
+         it != walk_map_.end(); ++it) {
+        it->second->Resume();
+    }
+}
+
+//
+// Constructor.
+//
+BgpMembershipManager::Walker::TableWalk::TableWalk(Walker *walker,
+    RibState *rs)
+    : walker_(walker),
+      rs_(rs),
+      completed_(false),
+      start_at_(0),
+      ribout_state_list_size_(0) {
+}
+
+//
+// Destructor.
+//
+BgpMembershipManager::Walker::TableWalk::~TableWalk() {
+    assert(walk_ref_ == NULL);
+    assert(peer_rib_list_.empty());
+    assert(peer_list_.empty());
+    assert(ribout_state_map_.empty());
+    assert(ribout_state_list_.empty());
 }
 
 //
 // Find or create the RibOutState for given RibOut.
 //
 BgpMembershipManager::Walker::RibOutState *
-BgpMembershipManager::Walker::LocateRibOutState(RibOut *ribout) {
+BgpMembershipManager::Walker::TableWalk::LocateRibOutState(RibOut *ribout) {
     RibOutStateMap::iterator loc = ribout_state_map_.find(ribout);
     if (loc == ribout_state_map_.end()) {
         RibOutState *ros = new RibOutState(ribout);
@@ -1142,8 +1283,8 @@ BgpMembershipManager::Walker::LocateRibOutState(RibOut *ribout) {
 //
 // Process table walk callback from DB infrastructure.
 //
-bool BgpMembershipManager::Walker::WalkCallback(DBTablePartBase *tpart,
-    DBEntryBase *db_entry) {
+bool BgpMembershipManager::Walker::TableWalk::WalkCallback(
+    DBTablePartBase *tpart, DBEntryBase *db_entry) {
     CHECK_CONCURRENCY("db::DBTable");
 
     // Walk all RibOutStates and handle join/leave processing.
@@ -1197,39 +1338,21 @@ bool BgpMembershipManager::Walker::WalkCallback(DBTablePartBase *tpart,
 // Just note that the walk has completed and trigger processing from the
 // bgp::PeerMembership task.
 //
-void BgpMembershipManager::Walker::WalkDoneCallback(DBTableBase *table_base) {
+void BgpMembershipManager::Walker::TableWalk::WalkDoneCallback(
+    DBTableBase *table_base) {
     CHECK_CONCURRENCY("db::Walker");
     assert(rs_->table() == table_base);
-    walk_completed_ = true;
-    trigger_->Set();
+    completed_ = true;
+    walker_->trigger_->Set();
 }
 
 //
-// Start a walk for the BgpTable corresponding to the next RibState in the
-// RibStateList.
+// Start the walk of the BgpTable for the RibState.
 //
-void BgpMembershipManager::Walker::WalkStart() {
+void BgpMembershipManager::Walker::TableWalk::Start(bool postpone) {
     CHECK_CONCURRENCY("bgp::PeerMembership");
 
-    assert(walk_ref_ == NULL);
-    assert(!rs_);
-    assert(peer_rib_list_.empty());
-    assert(peer_list_.empty());
-    assert(ribout_state_map_.empty());
-    assert(ribout_state_list_.empty());
-    assert(rib_state_list_size_ == rib_state_set_.size());
-
-    // Bail if the list if empty.
-    if (rib_state_list_.empty())
-        return;
-
-    // Get and remove the first RibState from the RibStateList.
-    rs_ = rib_state_list_.front();
-    rib_state_list_.pop_front();
-    rib_state_list_size_--;
-    assert(rib_state_set_.erase(rs_) == 1);
-
-    // Process all pending PeerRibStates for chosen RibState.
+    // Process all pending PeerRibStates for the RibState.
     // Insert the PeerRibStates into PeerRibList for post processing when
     // table walk is complete.
     for (RibState::iterator it = rs_->begin(); it != rs_->end(); ++it) {
@@ -1272,49 +1395,65 @@ void BgpMembershipManager::Walker::WalkStart() {
 
     // Start the walk.
     rs_->increment_walk_count();
+    start_at_ = ClockMonotonicUsec();
     BgpTable *table = rs_->table();
     walk_ref_ = table->AllocWalker(
-        boost::bind(&BgpMembershipManager::Walker::WalkCallback, this, _1, _2),
-        boost::bind(&BgpMembershipManager::Walker::WalkDoneCallback, this, _2));
-    walk_started_ = true;
-    if (!postpone_walk_)
+        boost::bind(&BgpMembershipManager::Walker::TableWalk::WalkCallback,
+            this, _1, _2),
+        boost::bind(&BgpMembershipManager::Walker::TableWalk::WalkDoneCallback,
+            this, _2),
+        DBTable::WALK_PRIORITY_HIGH);
+    if (!postpone)
         table->WalkTable(walk_ref_);
 }
 
 //
-// Finish processing of the walk of BgpTable for current RibState.
+// Resume a postponed walk.
+// Testing only.
+//
+void BgpMembershipManager::Walker::TableWalk::Resume() {
+    assert(!completed_);
+    assert(walk_ref_ != NULL);
+    rs_->table()->WalkTable(walk_ref_);
+}
+
+//
+// Finish processing of the walk of BgpTable for the RibState.
 //
 // The walk complete notification is handled by WalkDoneCallback but all the
 // book-keeping and triggering of Events is handled by this method since it
 // needs to happen in bgp::PeerMembership task.
 //
-void BgpMembershipManager::Walker::WalkFinish() {
+void BgpMembershipManager::Walker::TableWalk::Finish() {
     CHECK_CONCURRENCY("bgp::PeerMembership");
 
     assert(walk_ref_ != NULL);
-    assert(rs_);
+    assert(completed_);
     assert(!peer_rib_list_.empty());
     assert(!peer_list_.empty() || !ribout_state_map_.empty());
-    assert(rib_state_list_size_ == rib_state_set_.size());
     assert(ribout_state_list_size_ == ribout_state_map_.size());
 
+    BgpMembershipManager *manager = walker_->manager_;
+    uint64_t finish_at = ClockMonotonicUsec();
     BgpTable *table = rs_->table();
     for (PeerRibList::iterator it = peer_rib_list_.begin();
          it != peer_rib_list_.end(); ++it) {
         PeerRibState *prs = *it;
         IPeer *peer = prs->peer_state()->peer();
+        prs->set_walk_times(start_at_ - prs->request_at(),
+                            finish_at - start_at_);
 
         switch (prs->action()) {
         case RIBOUT_ADD:
-            manager_->TriggerRegisterRibCompleteEvent(peer, table);
+            manager->TriggerRegisterRibCompleteEvent(peer, table);
             break;
         case RIBIN_DELETE:
         case RIBIN_WALK:
-            manager_->TriggerWalkRibCompleteEvent(peer, table);
+            manager->TriggerWalkRibCompleteEvent(peer, table);
             break;
         case RIBIN_WALK_RIBOUT_DELETE:
         case RIBIN_DELETE_RIBOUT_DELETE:
-            manager_->TriggerUnregisterRibCompleteEvent(peer, table);
+            manager->TriggerUnregisterRibCompleteEvent(peer, table);
             break;
         default:
             assert(false);
@@ -1323,67 +1462,9 @@ void BgpMembershipManager::Walker::WalkFinish() {
     }
 
     table->ReleaseWalker(walk_ref_);
-    rs_ = NULL;
     peer_rib_list_.clear();
     peer_list_.clear();
     ribout_state_list_.clear();
     ribout_state_list_size_ = 0;
     STLDeleteElements(&ribout_state_map_);
-
-    walk_started_ = false;
-    walk_completed_ = false;
-}
-
-//
-// Handler for TaskTrigger.
-// Start a new walk or finish processing for the current walk and start a new
-// one.
-//
-bool BgpMembershipManager::Walker::WalkTrigger() {
-    CHECK_CONCURRENCY("bgp::PeerMembership");
-
-    if (!walk_started_) {
-        assert(!walk_completed_);
-        WalkStart();
-    } else if (walk_completed_) {
-        WalkFinish();
-        WalkStart();
-    }
-    return true;
-}
-
-//
-// Disable the TaskTrigger so that the Walker can accumulate RibStates in the
-// RibStateList.
-// Testing only.
-//
-void BgpMembershipManager::Walker::SetQueueDisable(bool value) {
-    if (value) {
-        trigger_->set_disable();
-    } else {
-        trigger_->set_enable();
-    }
-}
-
-//
-// Force the Walker to trigger walks that are postponed.
-// Testing only.
-//
-void BgpMembershipManager::Walker::PostponeWalk() {
-    assert(!walk_started_);
-    assert(walk_ref_ == NULL);
-    postpone_walk_ = true;
-}
-
-//
-// Tell the DBTableWalkMgr to resume walk that was postponed previously.
-// Testing only.
-//
-void BgpMembershipManager::Walker::ResumeWalk() {
-    assert(walk_started_);
-    assert(!walk_completed_);
-    assert(walk_ref_ != NULL);
-    postpone_walk_ = false;
-    BgpTable *table = rs_->table();
-    table->WalkTable(walk_ref_);
 }
@@ -375,6 +375,13 @@ public:
     void set_subscription_gen_id(uint64_t subscription_gen_id) {
         subscription_gen_id_ = subscription_gen_id;
     }
+    uint64_t request_at() const { return request_at_; }
+    void set_request_at(uint64_t request_at) { request_at_ = request_at; }
+    void set_walk_times(uint64_t wait_usecs, uint64_t walk_usecs) {
+        walk_wait_usecs_ = wait_usecs;
+        walk_usecs_ = walk_usecs;
+        walk_count_++;
+    }
 
 private:
     BgpMembershipManager *manager_;
@@ -387,6 +394,10 @@ private:
     bool ribout_registered_;
     int instance_id_;
     uint64_t subscription_gen_id_;
+    uint64_t request_at_;
+    uint64_t walk_wait_usecs_;
+    uint64_t walk_usecs_;
+    uint32_t walk_count_;
 
     DISALLOW_COPY_AND_ASSIGN(PeerRibState);
 };
@@ -394,12 +405,22 @@ private:
 //
 // This class is responsible for efficient implementation of BgpTable walks
 // for the BgpMembershipManager. It accepts walk requests for any number of
-// RibStates and triggers table walks one at a time. It has a maximum of one
-// ongoing table walk at any given time.
+// RibStates and triggers table walks for them. It has a maximum of
+// max_walks_ ongoing table walks at any given time, each for a different
+// RibState.
+//
+// Keeping more than one walk outstanding lets the DBTableWalkMgr take up the
+// walk for the next BgpTable as soon as the current one is done, instead of
+// waiting for the bgp::PeerMembership task to finish the current walk and
+// start the next one. This matters when a large number of peers register or
+// unregister with a large number of tables e.g. when all agents reconnect.
+// The maximum can be set via BGP_MEMBERSHIP_MAX_WALKS.
 //
 // The RibStateList contains all RibStates for which walks have not yet been
-// started. The Walker removes the first RibState from the list and starts a
-// table walk for it.
+// started. The Walker starts a table walk for the first RibState in the list
+// that does not already have an ongoing walk. All PeerRibStates that become
+// pending for a RibState before its walk is started are handled in a single
+// walk.
 //
 // The RibStateSet is used to prevent duplicates in the RibStateList. Using
 // just the RibStateSet to maintain the pending RibStates would have caused
@@ -413,16 +434,16 @@ private:
 // There's no issues with concurrent access in the former case. In the latter
 // case, access is serialized because of the mutex in BgpMembershipManager.
 //
-// The Walker creates temporary internal state when it starts a table walk so
-// that walk callbacks for each DBEntry can be handled with minimal processing
-// overhead. Details on this temporary state are as follows:
+// The Walker creates a TableWalk with temporary internal state when it starts
+// a table walk so that walk callbacks for each DBEntry can be handled with
+// minimal processing overhead. Details on this temporary state are as follows:
 //
-// - walk_ref_ is the walker for the current walk
+// - walk_ref_ is the walker for the walk
 // - rs_ is the RibState for which the walk was started
-// - peer_rib_list_ is the list of PeerRibStates for the current RibState
-//   that have a pending action. The pending list in RibState is logically
-//   moved to this field. This allows the RibState to accumulate a new set
-//   of pending PeerRibStates that can be serviced in a subsequent walk.
+// - peer_rib_list_ is the list of PeerRibStates for the RibState that have
+//   a pending action. The pending list in RibState is logically moved to
+//   this field. This allows the RibState to accumulate a new set of pending
+//   PeerRibStates that can be serviced in a subsequent walk.
 //   The peer_rib_list_ is used to create and enqueue events when the table
 //   walk finishes.
 // - peer_list_ is the list of IPeers to be notified about BgpPaths added
@@ -445,6 +466,8 @@ private:
 //
 class BgpMembershipManager::Walker {
 public:
+    static const size_t kDefaultMaxWalks = 4;
+
     explicit Walker(BgpMembershipManager *manager);
     ~Walker();
 
@@ -473,6 +496,8 @@ private:
         DISALLOW_COPY_AND_ASSIGN(RibOutState);
     };
 
+    class TableWalk;
+
     typedef BgpMembershipManager::Event Event;
     typedef BgpMembershipManager::RibState RibState;
     typedef BgpMembershipManager::PeerRibState PeerRibState;
@@ -482,20 +507,18 @@ private:
     typedef std::map<RibOut *, RibOutState *> RibOutStateMap;
     typedef std::list<RibOutState *> RibOutStateList;
     typedef std::set<const IPeer *> PeerList;
+    typedef std::map<RibState *, TableWalk *> TableWalkMap;
 
-    RibOutState *LocateRibOutState(RibOut *ribout);
-    bool WalkCallback(DBTablePartBase *tpart, DBEntryBase *db_entry);
-    void WalkDoneCallback(DBTableBase *table);
-    void WalkStart();
-    void WalkFinish();
+    bool WalkStart();
     bool WalkTrigger();
 
     // Testing only.
     void SetQueueDisable(bool value);
+    void SetMaxWalks(size_t max_walks) { max_walks_ = max_walks; }
     size_t GetQueueSize() const { return rib_state_list_size_; }
-    size_t GetPeerListSize() const { return peer_list_.size(); }
-    size_t GetPeerRibListSize() const { return peer_rib_list_.size(); }
-    size_t GetRibOutStateListSize() const { return ribout_state_list_size_; }
+    size_t GetPeerListSize() const;
+    size_t GetPeerRibListSize() const;
+    size_t GetRibOutStateListSize() const;
     void PostponeWalk();
     void ResumeWalk();
 
@@ -504,19 +527,49 @@ private:
     RibStateList rib_state_list_;
     boost::scoped_ptr<TaskTrigger> trigger_;
 
+    size_t max_walks_;
     bool postpone_walk_;
-    bool walk_started_;
-    bool walk_completed_;
-    DBTable::DBTableWalkRef walk_ref_;
+    TableWalkMap walk_map_;
+    size_t rib_state_list_size_;
+
+    DISALLOW_COPY_AND_ASSIGN(Walker);
+};
+
+//
+// State for an ongoing walk of the BgpTable for a RibState.
+//
+class BgpMembershipManager::Walker::TableWalk {
+public:
+    TableWalk(Walker *walker, RibState *rs);
+    ~TableWalk();
+
+    void Start(bool postpone);
+    void Resume();
+    void Finish();
+
+    RibState *rib_state() { return rs_; }
+    bool completed() const { return completed_; }
+    size_t peer_list_size() const { return peer_list_.size(); }
+    size_t peer_rib_list_size() const { return peer_rib_list_.size(); }
+    size_t ribout_state_list_size() const { return ribout_state_list_size_; }
+
+private:
+    RibOutState *LocateRibOutState(RibOut *ribout);
+    bool WalkCallback(DBTablePartBase *tpart, DBEntryBase *db_entry);
+    void WalkDoneCallback(DBTableBase *table);
+
+    Walker *walker_;
     RibState *rs_;
+    DBTable::DBTableWalkRef walk_ref_;
+    bool completed_;
+    uint64_t start_at_;
     PeerRibList peer_rib_list_;
     PeerList peer_list_;
     RibOutStateMap ribout_state_map_;
     RibOutStateList ribout_state_list_;
-    size_t rib_state_list_size_;
     size_t ribout_state_list_size_;
 
-    DISALLOW_COPY_AND_ASSIGN(Walker);
+    DISALLOW_COPY_AND_ASSIGN(TableWalk);
 };
 
 #endif  // SRC_BGP_BGP_MEMBERSHIP_H_
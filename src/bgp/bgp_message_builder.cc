@@ -4,6 +4,7 @@
 
 #include "bgp/bgp_message_builder.h"
 
+#include <cstring>
 #include <vector>
 
 #include "bgp/bgp_log.h"
@@ -16,16 +17,26 @@
 
 using std::unique_ptr;
 
-BgpMessage::BgpMessage() : table_(NULL), datalen_(0) {
+bool BgpMessage::encoding_cache_enabled_ = true;
+
+BgpMessage::BgpMessage()
+    : table_(NULL),
+      msg_length_offset_(-1),
+      attr_length_offset_(-1),
+      nlri_length_offset_(-1),
+      datalen_(0) {
 }
 
 BgpMessage::~BgpMessage() {
 }
 
-bool BgpMessage::StartReach(const RibOut *ribout, const RibOutAttr *roattr,
-                            const BgpRoute *route) {
+//
+// Encode all path attributes other than MP_REACH_NLRI for the variant of
+// the message needed by the RibOut.
+//
+bool BgpMessage::EncodeAttributes(const RibOut *ribout, const BgpAttr *attr,
+                                  BgpAttr::Encoding *encoding) const {
     BgpProto::Update update;
-    const BgpAttr *attr = roattr->attr();
     Address::Family family = table_->family();
 
     BgpAttrOrigin *origin = new BgpAttrOrigin(attr->origin());
@@ -195,6 +206,74 @@ bool BgpMessage::StartReach(const RibOut *ribout, const RibOutAttr *roattr,
         update.path_attributes.push_back(pmsi_spec);
     }
 
+    uint8_t data[BgpProto::kMaxMessageSize];
+    EncodeOffsets offsets;
+    int result = BgpProto::Encode(&update, data, sizeof(data), &offsets,
+                                  ribout->as4_supported());
+    if (result <= 0)
+        return false;
+    int offset = offsets.FindOffset("BgpPathAttribute");
+    if (offset < 0)
+        return false;
+    encoding->assign(data + offset + 2, data + result);
+    return true;
+}
+
+//
+// Get the encoding of the path attributes for the RibOut. The encoding is
+// cached in the BgpAttr since an attribute is typically shared by a large
+// number of routes.
+//
+const BgpAttr::Encoding *BgpMessage::GetAttributeEncoding(
+    const RibOut *ribout, const BgpAttr *attr) {
+    Address::Family family = table_->family();
+    int variant = 0;
+    if ((BgpAf::FamilyToAfi(family) == BgpAf::IPv4) &&
+        (BgpAf::FamilyToSafi(family) == BgpAf::Unicast)) {
+        variant |= kEncodeNextHop;
+    }
+    if (ribout->peer_type() == BgpProto::IBGP)
+        variant |= kEncodeLocalPref;
+    if (ribout->as4_supported())
+        variant |= kEncodeAs4;
+
+    if (!encoding_cache_enabled_) {
+        if (!EncodeAttributes(ribout, attr, &attr_encoding_))
+            return NULL;
+        return &attr_encoding_;
+    }
+
+    const BgpAttr::Encoding *encoding = attr->GetEncoding(variant);
+    if (encoding)
+        return encoding;
+    BgpAttr::Encoding *new_encoding = new BgpAttr::Encoding;
+    if (!EncodeAttributes(ribout, attr, new_encoding)) {
+        delete new_encoding;
+        return NULL;
+    }
+    return attr->SetEncoding(variant, new_encoding);
+}
+
+//
+// Encode an UPDATE with just the MP_REACH_NLRI attribute and splice the
+// encoding of the other path attributes in front of it.
+//
+bool BgpMessage::StartReach(const RibOut *ribout, const RibOutAttr *roattr,
+                            const BgpRoute *route) {
+    BgpProto::Update update;
+    const BgpAttr *attr = roattr->attr();
+    Address::Family family = table_->family();
+
+    const BgpAttr::Encoding *attr_encoding =
+        GetAttributeEncoding(ribout, attr);
+    if (!attr_encoding) {
+        BGP_LOG_WARNING_STR(BgpMessageSend, BGP_LOG_FLAG_ALL,
+            "Error encoding attributes for route " << route->ToString() <<
+            " in table " << (table_ ? table_->name() : "unknown"));
+        table_->server()->increment_message_build_error();
+        return false;
+    }
+
     std::vector<uint8_t> nh;
 
     route->BuildBgpProtoNextHop(nh, attr->nexthop());
@@ -209,9 +288,13 @@ bool BgpMessage::StartReach(const RibOut *ribout, const RibOutAttr *roattr,
     route->BuildProtoPrefix(prefix, attr, label, roattr->l3_label());
     nlri->nlri.push_back(prefix);
 
+    EncodeOffsets offsets;
     int result = BgpProto::Encode(&update, data_, sizeof(data_),
-                                  &encode_offsets_, ribout->as4_supported());
-    if (result <= 0) {
+                                  &offsets, ribout->as4_supported());
+    int attr_length_offset = offsets.FindOffset("BgpPathAttribute");
+    int delta = attr_encoding->size();
+    if (result <= 0 || attr_length_offset < 0 ||
+        result + delta > static_cast<int>(sizeof(data_))) {
         BGP_LOG_WARNING_STR(BgpMessageSend, BGP_LOG_FLAG_ALL,
             "Error encoding reach message for route " << route->ToString() <<
             " in table " << (table_ ? table_->name() : "unknown"));
@@ -219,8 +302,21 @@ bool BgpMessage::StartReach(const RibOut *ribout, const RibOutAttr *roattr,
         return false;
     }
 
+    uint8_t *attr_start = data_ + attr_length_offset + 2;
+    memmove(attr_start + delta, attr_start, data_ + result - attr_start);
+    memcpy(attr_start, attr_encoding->data(), delta);
+
+    msg_length_offset_ = offsets.FindOffset("BgpMsgLength");
+    attr_length_offset_ = attr_length_offset;
+    nlri_length_offset_ = offsets.FindOffset("MpReachUnreachNlri") + delta;
+    if (!UpdateLength(msg_length_offset_, 2, delta) ||
+        !UpdateLength(attr_length_offset_, 2, delta)) {
+        assert(false);
+        return false;
+    }
+
     num_reach_route_++;
-    datalen_ = result;
+    datalen_ = result + delta;
     return true;
 }
 
@@ -237,8 +333,8 @@ bool BgpMessage::StartUnreach(const BgpRoute *route) {
     route->BuildProtoPrefix(prefix);
     nlri->nlri.push_back(prefix);
 
-    int result =
-        BgpProto::Encode(&update, data_, sizeof(data_), &encode_offsets_);
+    EncodeOffsets offsets;
+    int result = BgpProto::Encode(&update, data_, sizeof(data_), &offsets);
     if (result <= 0) {
         BGP_LOG_WARNING_STR(BgpMessageSend, BGP_LOG_FLAG_ALL,
             "Error encoding unreach message for route " << route->ToString() <<
@@ -247,6 +343,9 @@ bool BgpMessage::StartUnreach(const BgpRoute *route) {
         return false;
     }
 
+    msg_length_offset_ = offsets.FindOffset("BgpMsgLength");
+    attr_length_offset_ = offsets.FindOffset("BgpPathAttribute");
+    nlri_length_offset_ = offsets.FindOffset("MpReachUnreachNlri");
     num_unreach_route_++;
     datalen_ = result;
     return true;
@@ -255,7 +354,9 @@ bool BgpMessage::StartUnreach(const BgpRoute *route) {
 void BgpMessage::Reset() {
     Message::Reset();
     table_ = NULL;
-    encode_offsets_.ClearOffsets();
+    msg_length_offset_ = -1;
+    attr_length_offset_ = -1;
+    nlri_length_offset_ = -1;
     datalen_ = 0;
 }
 
@@ -271,8 +372,7 @@ bool BgpMessage::Start(const RibOut *ribout, bool cache_repr,
     }
 }
 
-bool BgpMessage::UpdateLength(const char *tag, int size, int delta) {
-    int offset = encode_offsets_.FindOffset(tag);
+bool BgpMessage::UpdateLength(int offset, int size, int delta) {
     if (offset < 0) {
         return false;
     }
@@ -311,17 +411,17 @@ bool BgpMessage::AddRoute(const BgpRoute *route, const RibOutAttr *roattr) {
         num_unreach_route_++;
     }
 
-    if (!UpdateLength("BgpMsgLength", 2, result)) {
+    if (!UpdateLength(msg_length_offset_, 2, result)) {
         assert(false);
         return false;
     }
 
-    if (!UpdateLength("BgpPathAttribute", 2, result)) {
+    if (!UpdateLength(attr_length_offset_, 2, result)) {
         assert(false);
         return false;
     }
 
-    if (!UpdateLength("MpReachUnreachNlri", 2, result)) {
+    if (!UpdateLength(nlri_length_offset_, 2, result)) {
         assert(false);
         return false;
     }
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "bgp/bgp_attr.h"
 #include "bgp/bgp_proto.h"
 #include "bgp/message_builder.h"
 
@@ -24,15 +25,35 @@ public:
                                    const std::string **msg_str,
                                    std::string *temp);
 
+    // Enable or disable caching of path attribute encodings in BgpAttr.
+    static void SetEncodingCacheEnabled(bool enabled) {
+        encoding_cache_enabled_ = enabled;
+    }
+    static bool encoding_cache_enabled() { return encoding_cache_enabled_; }
+
 private:
+    // Path attribute encoding variants, see BgpAttr::GetEncoding.
+    static const int kEncodeNextHop = 1 << 0;
+    static const int kEncodeLocalPref = 1 << 1;
+    static const int kEncodeAs4 = 1 << 2;
+
+    static bool encoding_cache_enabled_;
+
     virtual void Reset();
+    bool EncodeAttributes(const RibOut *ribout, const BgpAttr *attr,
+                          BgpAttr::Encoding *encoding) const;
+    const BgpAttr::Encoding *GetAttributeEncoding(const RibOut *ribout,
+                                                  const BgpAttr *attr);
     bool StartReach(const RibOut *ribout, const RibOutAttr *roattr,
                     const BgpRoute *route);
     bool StartUnreach(const BgpRoute *route);
-    bool UpdateLength(const char *tag, int size, int delta);
+    bool UpdateLength(int offset, int size, int delta);
 
     const BgpTable *table_;
-    EncodeOffsets encode_offsets_;
+    int msg_length_offset_;
+    int attr_length_offset_;
+    int nlri_length_offset_;
+    BgpAttr::Encoding attr_encoding_;
     uint8_t data_[BgpProto::kMaxMessageSize];
     size_t datalen_;
 
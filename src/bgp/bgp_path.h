@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/util.h"
+#include "db/db_arena.h"
 #include "route/path.h"
 #include "bgp/bgp_attr.h"
 
@@ -61,6 +62,14 @@ public:
     virtual ~BgpPath() {
     }
 
+    // Paths are allocated from the DB arena.
+    static void *operator new(size_t size) {
+        return DBArena::GetInstance()->Alloc(size);
+    }
+    static void operator delete(void *ptr, size_t size) {
+        DBArena::GetInstance()->Free(ptr, size);
+    }
+
     void AddExtCommunitySubCluster(uint32_t subcluster_id);
 
     RouteDistinguisher GetSourceRouteDistinguisher() const;
@@ -1814,6 +1814,9 @@ void BgpPeer::ProcessNlri(Address::Family family, DBRequest::DBOperation oper,
     TableT *table = static_cast<TableT *>(rtinstance_->GetTable(family));
     assert(table);
 
+    // Hand all prefixes in the NLRI to the table as a single batch.
+    DBTableBase::RequestList req_list;
+    req_list.reserve(nlri->nlri.size());
     for (vector<BgpProtoPrefix *>::const_iterator it = nlri->nlri.begin();
          it != nlri->nlri.end(); ++it) {
         PrefixT prefix;
@@ -1831,15 +1834,18 @@ void BgpPeer::ProcessNlri(Address::Family family, DBRequest::DBOperation oper,
             continue;
         }
 
-        DBRequest req;
-        req.oper = oper;
+        DBRequest *req = new DBRequest(oper);
         if (oper == DBRequest::DB_ENTRY_ADD_CHANGE) {
-            req.data.reset(new typename TableT::RequestData(
+            req->data.reset(new typename TableT::RequestData(
                 new_attr, flags, label, l3_label, 0));
         }
-        req.key.reset(new typename TableT::RequestKey(prefix, this));
-        table->Enqueue(&req);
+        req->key.reset(new typename TableT::RequestKey(prefix, this));
+        req_list.push_back(req);
     }
+
+    if (!req_list.empty())
+        table->EnqueueBatch(req_list);
+    STLDeleteValues(&req_list);
 }
 
 template <typename PrefixT>
@@ -1979,6 +1985,8 @@ void BgpPeer::ProcessUpdate(const BgpProto::Update *msg, size_t msgsize) {
             return;
         }
 
+        DBTableBase::RequestList req_list;
+        req_list.reserve(msg->withdrawn_routes.size() + msg->nlri.size());
         unreach_count += msg->withdrawn_routes.size();
         for (vector<BgpProtoPrefix *>::const_iterator it =
              msg->withdrawn_routes.begin(); it != msg->withdrawn_routes.end();
@@ -1998,11 +2006,9 @@ void BgpPeer::ProcessUpdate(const BgpProto::Update *msg, size_t msgsize) {
                               prefix.prefixlen(), attr, 0);
             }
 
-            DBRequest req;
-            req.oper = DBRequest::DB_ENTRY_DELETE;
-            req.data.reset(NULL);
-            req.key.reset(new InetTable::RequestKey(prefix, this));
-            table->Enqueue(&req);
+            DBRequest *req = new DBRequest(DBRequest::DB_ENTRY_DELETE);
+            req->key.reset(new InetTable::RequestKey(prefix, this));
+            req_list.push_back(req);
         }
 
         uint32_t flags = GetPathFlags(Address::INET, attr.get());
@@ -2018,11 +2024,10 @@ void BgpPeer::ProcessUpdate(const BgpProto::Update *msg, size_t msgsize) {
                 continue;
             }
 
-            DBRequest req;
-            req.oper = DBRequest::DB_ENTRY_ADD_CHANGE;
-            req.data.reset(new InetTable::RequestData(attr, flags, 0, 0, 0));
-            req.key.reset(new InetTable::RequestKey(prefix, this));
-            table->Enqueue(&req);
+            DBRequest *req = new DBRequest(DBRequest::DB_ENTRY_ADD_CHANGE);
+            req->data.reset(new InetTable::RequestData(attr, flags, 0, 0, 0));
+            req->key.reset(new InetTable::RequestKey(prefix, this));
+            req_list.push_back(req);
 
             if ((router_type_ == "bgpaas-client") ||
                 (router_type_ == "bgpaas-server")) {
@@ -2030,6 +2035,11 @@ void BgpPeer::ProcessUpdate(const BgpProto::Update *msg, size_t msgsize) {
                               prefix.prefixlen(), attr, flags);
             }
         }
+
+        // Withdrawn routes precede reachable ones within each partition.
+        if (!req_list.empty())
+            table->EnqueueBatch(req_list);
+        STLDeleteValues(&req_list);
     }
 
     for (vector<BgpAttribute *>::const_iterator ait =
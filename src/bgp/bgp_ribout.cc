@@ -5,6 +5,7 @@
 #include "bgp/bgp_ribout.h"
 
 #include <boost/bind/bind.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <algorithm>
 
@@ -24,8 +25,14 @@
 #include "db/db.h"
 
 using std::find;
+using std::string;
+using std::vector;
 using namespace boost::placeholders;
 
+const RibOutAttr::NextHopList RibOutAttr::kEmptyNextHopList;
+const string RibOutAttr::kEmptyRepr;
+std::atomic<uint64_t> AdvertiseInfo::count_;
+
 RibOutAttr::NextHop::NextHop(const BgpTable *table, IpAddress address,
     const MacAddress &mac, uint32_t label, uint32_t l3_label,
     const ExtCommunity *ext_community, const LargeCommunity *large_community,
@@ -70,6 +77,20 @@ int RibOutAttr::NextHop::CompareTo(const NextHop &rhs) const {
     return 0;
 }
 
+//
+// Memory used by the NextHop, including the encap strings and the tags.
+//
+size_t RibOutAttr::NextHop::MemoryBytes() const {
+    size_t bytes = sizeof(NextHop);
+    bytes += encap_.capacity() * sizeof(string);
+    for (vector<string>::const_iterator it = encap_.begin();
+         it != encap_.end(); ++it) {
+        bytes += it->capacity();
+    }
+    bytes += tag_list_.capacity() * sizeof(uint64_t);
+    return bytes;
+}
+
 bool RibOutAttr::NextHop::operator==(const NextHop &rhs) const {
     return CompareTo(rhs) == 0;
 }
@@ -82,6 +103,60 @@ bool RibOutAttr::NextHop::operator<(const NextHop &rhs) const {
     return CompareTo(rhs) < 0;
 }
 
+RibOutAttr::NextHopListEntry::NextHopListEntry(
+    RibOutNextHopListDB *nexthop_list_db, const NextHopList &nexthop_list)
+    : nexthop_list_db_(nexthop_list_db),
+      nexthop_list_(nexthop_list),
+      hash_(0),
+      bytes_(sizeof(NextHopListEntry)) {
+    refcount_ = 0;
+    for (NextHopList::const_iterator it = nexthop_list_.begin();
+         it != nexthop_list_.end(); ++it) {
+        if (it->address().is_v4()) {
+            boost::hash_combine(hash_, it->address().to_v4().to_ulong());
+        }
+        boost::hash_combine(hash_, it->label());
+        boost::hash_combine(hash_, it->l3_label());
+        boost::hash_combine(hash_, it->origin_vn_index());
+        bytes_ += it->MemoryBytes();
+    }
+    nexthop_list_db_->UpdateBytes(bytes_);
+}
+
+RibOutAttr::NextHopListEntry::~NextHopListEntry() {
+    nexthop_list_db_->UpdateBytes(-static_cast<int64_t>(bytes_));
+}
+
+void RibOutAttr::NextHopListEntry::Remove() {
+    nexthop_list_db_->Delete(this);
+}
+
+int RibOutAttr::NextHopListEntry::CompareTo(
+    const NextHopListEntry &rhs) const {
+    KEY_COMPARE(nexthop_list_.size(), rhs.nexthop_list_.size());
+    for (size_t idx = 0; idx < nexthop_list_.size(); ++idx) {
+        KEY_COMPARE(nexthop_list_[idx], rhs.nexthop_list_[idx]);
+    }
+    return 0;
+}
+
+//
+// The database is never deleted so that RibOutAttrs in objects that are
+// destroyed at exit can still release their NextHopLists.
+//
+RibOutNextHopListDB *RibOutAttr::nexthop_list_db() {
+    static RibOutNextHopListDB *nexthop_list_db = new RibOutNextHopListDB;
+    return nexthop_list_db;
+}
+
+void RibOutAttr::set_nexthop_list(const NextHopList &nexthop_list) {
+    if (nexthop_list.empty()) {
+        nexthops_.reset();
+    } else {
+        nexthops_ = nexthop_list_db()->Locate(nexthop_list);
+    }
+}
+
 RibOutAttr::RibOutAttr()
     : label_(0),
       l3_label_(0),
@@ -95,7 +170,7 @@ RibOutAttr::RibOutAttr()
 //
 RibOutAttr::RibOutAttr(const RibOutAttr &rhs) {
     attr_out_ = rhs.attr_out_;
-    nexthop_list_ = rhs.nexthop_list_;
+    nexthops_ = rhs.nexthops_;
     label_ = rhs.label_;
     l3_label_ = rhs.l3_label_;
     source_address_ = rhs.source_address_;
@@ -111,9 +186,9 @@ RibOutAttr::RibOutAttr(const BgpTable *table, const BgpAttr *attr,
       is_xmpp_(is_xmpp),
       vrf_originated_(false) {
     if (attr && is_xmpp) {
-        nexthop_list_.push_back(NextHop(table, attr->nexthop(),
+        set_nexthop_list(NextHopList(1, NextHop(table, attr->nexthop(),
             attr->mac_address(), label, l3_label, attr->ext_community(),
-            attr->large_community(), false));
+            attr->large_community(), false)));
     }
 }
 
@@ -126,9 +201,9 @@ RibOutAttr::RibOutAttr(const BgpTable *table, const BgpRoute *route,
       vrf_originated_(route->BestPath()->IsVrfOriginated()) {
     if (attr && include_nh) {
         if (is_xmpp) {
-            nexthop_list_.push_back(NextHop(table, attr->nexthop(),
+            set_nexthop_list(NextHopList(1, NextHop(table, attr->nexthop(),
                 attr->mac_address(), label, 0, attr->ext_community(),
-                attr->large_community(), vrf_originated_));
+                attr->large_community(), vrf_originated_)));
         } else {
             label_ = label;
             l3_label_ = 0;
@@ -157,6 +232,8 @@ RibOutAttr::RibOutAttr(const BgpRoute *route, const BgpAttr *attr,
         route->BestPath()->GetL3Label(), route->BestPath()->IsVrfOriginated(),
         is_xmpp);
 
+    // Build the full list before interning it.
+    NextHopList ecmp_list(nexthop_list());
     for (Route::PathList::const_iterator it = route->GetPathList().begin();
         it != route->GetPathList().end(); ++it) {
         const BgpPath *path = static_cast<const BgpPath *>(it.operator->());
@@ -180,12 +257,14 @@ RibOutAttr::RibOutAttr(const BgpRoute *route, const BgpAttr *attr,
             path->GetAttr()->large_community(), path->IsVrfOriginated());
 
         // Skip if we have already encoded this next-hop
-        if (find(nexthop_list_.begin(), nexthop_list_.end(), nexthop) !=
-                nexthop_list_.end()) {
+        if (find(ecmp_list.begin(), ecmp_list.end(), nexthop) !=
+                ecmp_list.end()) {
             continue;
         }
-        nexthop_list_.push_back(nexthop);
+        ecmp_list.push_back(nexthop);
     }
+    if (ecmp_list.size() > 1)
+        set_nexthop_list(ecmp_list);
 }
 
 //
@@ -194,7 +273,7 @@ RibOutAttr::RibOutAttr(const BgpRoute *route, const BgpAttr *attr,
 //
 RibOutAttr &RibOutAttr::operator=(const RibOutAttr &rhs) {
     attr_out_ = rhs.attr_out_;
-    nexthop_list_ = rhs.nexthop_list_;
+    nexthops_ = rhs.nexthops_;
     label_ = rhs.label_;
     l3_label_ = rhs.l3_label_;
     source_address_ = rhs.source_address_;
@@ -205,14 +284,12 @@ RibOutAttr &RibOutAttr::operator=(const RibOutAttr &rhs) {
 
 //
 // Comparator for RibOutAttr.
-// First compare the BgpAttr and then the nexthops.
+// First compare the BgpAttr and then the nexthops. Both are interned, so it
+// is sufficient to compare the pointers.
 //
 int RibOutAttr::CompareTo(const RibOutAttr &rhs) const {
     KEY_COMPARE(attr_out_.get(), rhs.attr_out_.get());
-    KEY_COMPARE(nexthop_list_.size(), rhs.nexthop_list_.size());
-    for (size_t idx = 0; idx < nexthop_list_.size(); ++idx) {
-        KEY_COMPARE(nexthop_list_[idx], rhs.nexthop_list_[idx]);
-    }
+    KEY_COMPARE(nexthops_.get(), rhs.nexthops_.get());
     KEY_COMPARE(label_, rhs.label());
     KEY_COMPARE(l3_label_, rhs.l3_label());
     KEY_COMPARE(source_address_, rhs.source_address());
@@ -225,12 +302,12 @@ void RibOutAttr::set_attr(const BgpTable *table, const BgpAttrPtr &attrp,
     uint32_t label, uint32_t l3_label, bool vrf_originated, bool is_xmpp) {
     if (!attr_out_) {
         attr_out_ = attrp;
-        assert(nexthop_list_.empty());
+        assert(!nexthops_);
         if (is_xmpp) {
             NextHop nexthop(table, attrp->nexthop(), attrp->mac_address(),
                 label, l3_label, attrp->ext_community(),
                 attrp->large_community(), vrf_originated);
-            nexthop_list_.push_back(nexthop);
+            set_nexthop_list(NextHopList(1, nexthop));
         } else {
             label_ = label;
             l3_label_ = l3_label;
@@ -550,6 +627,19 @@ int RibOut::GetPeerIndex(IPeerUpdate *peer) const {
 // Fill introspect information.
 // Accumulate counters from all RibOutUpdates.
 //
+//
+// Fill memory used by the advertised state of all RibOuts. The BgpAttrs are
+// accounted for in the attribute database.
+//
+void RibOut::FillMemoryInfo(ShowRibOutMemory *srom) {
+    RibOutNextHopListDB *nexthop_list_db = RibOutAttr::nexthop_list_db();
+    srom->set_advertise_infos(AdvertiseInfo::count());
+    srom->set_advertise_info_bytes(
+        AdvertiseInfo::count() * sizeof(AdvertiseInfo));
+    srom->set_nexthop_lists(nexthop_list_db->Size());
+    srom->set_nexthop_list_bytes(nexthop_list_db->bytes());
+}
+
 void RibOut::FillStatisticsInfo(vector<ShowRibOutStatistics> *sros_list) const {
     for (int qid = RibOutUpdates::QFIRST; qid < RibOutUpdates::QCOUNT; ++qid) {
         RibOutUpdates::Stats stats;
@@ -7,8 +7,11 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/intrusive/slist.hpp>
+#include <boost/intrusive_ptr.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,7 +25,9 @@
 
 class IPeer;
 class IPeerUpdate;
+class RibOutNextHopListDB;
 class RibOutUpdates;
+class ShowRibOutMemory;
 class ShowRibOutStatistics;
 class BgpTable;
 class BgpExport;
@@ -37,6 +42,12 @@ class UpdateInfoSList;
 // and a label. The label is not included in BgpAttr in order to maximize
 // sharing of the BgpAttr.
 //
+// The list of nexthops is interned in the RibOutNextHopListDB in the same
+// way as the BgpAttr, so copies of a RibOutAttr in the UpdateInfos and the
+// AdvertiseInfos of a route, and RibOutAttrs of different routes with the
+// same nexthops (e.g. routes from an agent with the same label) share one
+// list. Comparing the nexthops of two RibOutAttrs is a pointer comparison.
+//
 class RibOutAttr {
 public:
     // This nested class represents an ecmp element for a ribout entry. A
@@ -59,8 +70,9 @@ public:
             uint32_t l3_label() const { return l3_label_; }
             const Ip4Address &source_address() const { return source_address_; }
             int origin_vn_index() const { return origin_vn_index_; }
-            std::vector<std::string> encap() const { return encap_; }
-            std::vector<uint64_t> tag_list() const { return tag_list_; }
+            const std::vector<std::string> &encap() const { return encap_; }
+            const std::vector<uint64_t> &tag_list() const { return tag_list_; }
+            size_t MemoryBytes() const;
 
             int CompareTo(const NextHop &rhs) const;
             bool operator==(const NextHop &rhs) const;
@@ -80,6 +92,36 @@ public:
 
     typedef std::vector<NextHop> NextHopList;
 
+    // Interned, immutable NextHopList.
+    class NextHopListEntry {
+    public:
+        NextHopListEntry(RibOutNextHopListDB *nexthop_list_db,
+                         const NextHopList &nexthop_list);
+        ~NextHopListEntry();
+        void Remove();
+        int CompareTo(const NextHopListEntry &rhs) const;
+
+        const NextHopList &nexthop_list() const { return nexthop_list_; }
+        size_t bytes() const { return bytes_; }
+
+        friend std::size_t hash_value(const NextHopListEntry &entry) {
+            return entry.hash_;
+        }
+
+    private:
+        friend int intrusive_ptr_add_ref(const NextHopListEntry *centry);
+        friend int intrusive_ptr_del_ref(const NextHopListEntry *centry);
+        friend void intrusive_ptr_release(const NextHopListEntry *centry);
+
+        mutable std::atomic<int> refcount_;
+        RibOutNextHopListDB *nexthop_list_db_;
+        NextHopList nexthop_list_;
+        size_t hash_;
+        size_t bytes_;
+    };
+
+    typedef boost::intrusive_ptr<const NextHopListEntry> NextHopListPtr;
+
     RibOutAttr();
     RibOutAttr(const RibOutAttr &rhs);
     RibOutAttr(const BgpRoute *route, const BgpAttr *attr, bool is_xmpp);
@@ -94,7 +136,9 @@ public:
     bool operator!=(const RibOutAttr &rhs) const { return CompareTo(rhs) != 0; }
     bool IsReachable() const { return attr_out_.get() != NULL; }
 
-    const NextHopList &nexthop_list() const { return nexthop_list_; }
+    const NextHopList &nexthop_list() const {
+        return nexthops_ ? nexthops_->nexthop_list() : kEmptyNextHopList;
+    }
     const BgpAttr *attr() const { return attr_out_.get(); }
     void set_attr(const BgpTable *table, const BgpAttrPtr &attrp) {
         set_attr(table, attrp, 0, 0, false, false);
@@ -111,35 +155,101 @@ public:
 
     void clear() {
         attr_out_.reset();
-        nexthop_list_.clear();
+        nexthops_.reset();
     }
     uint32_t label() const {
-        return nexthop_list_.empty() ? label_ : nexthop_list_[0].label();
+        return nexthops_ ? nexthop_list()[0].label() : label_;
     }
     uint32_t l3_label() const {
-        return nexthop_list_.empty() ? l3_label_ : nexthop_list_[0].l3_label();
+        return nexthops_ ? nexthop_list()[0].l3_label() : l3_label_;
     }
     const Ip4Address &source_address() const { return source_address_; }
     Ip4Address *source_address() { return &source_address_; }
     bool is_xmpp() const { return is_xmpp_; }
     bool vrf_originated() const { return vrf_originated_; }
-    const std::string &repr() const { return repr_; }
+    const std::string &repr() const {
+        return repr_ ? *repr_ : kEmptyRepr;
+    }
     void set_repr(const std::string &repr, size_t pos = 0) const {
-        repr_.clear();
-        repr_.append(repr, pos, std::string::npos);
+        if (!repr_)
+            repr_.reset(new std::string);
+        repr_->clear();
+        repr_->append(repr, pos, std::string::npos);
     }
 
+    static RibOutNextHopListDB *nexthop_list_db();
+
 private:
+    static const NextHopList kEmptyNextHopList;
+    static const std::string kEmptyRepr;
+
     int CompareTo(const RibOutAttr &rhs) const;
+    void set_nexthop_list(const NextHopList &nexthop_list);
 
     BgpAttrPtr attr_out_;
-    NextHopList nexthop_list_;
+    NextHopListPtr nexthops_;
     uint32_t label_;
     uint32_t l3_label_;
     Ip4Address source_address_;
     bool is_xmpp_;
     bool vrf_originated_;
-    mutable std::string repr_;
+
+    // The string representation is only built for RibOutAttrs in UpdateInfos
+    // that are being encoded, so don't carry an empty string in every
+    // AdvertiseInfo.
+    mutable std::unique_ptr<std::string> repr_;
+};
+
+inline int intrusive_ptr_add_ref(const RibOutAttr::NextHopListEntry *centry) {
+    return centry->refcount_.fetch_add(1);
+}
+
+inline int intrusive_ptr_del_ref(const RibOutAttr::NextHopListEntry *centry) {
+    return centry->refcount_.fetch_sub(1);
+}
+
+inline void intrusive_ptr_release(
+    const RibOutAttr::NextHopListEntry *centry) {
+    int prev = centry->refcount_.fetch_sub(1);
+    if (prev == 1) {
+        RibOutAttr::NextHopListEntry *entry =
+            const_cast<RibOutAttr::NextHopListEntry *>(centry);
+        entry->Remove();
+        assert(entry->refcount_ == 0);
+        delete entry;
+    }
+}
+
+struct RibOutNextHopListCompare {
+    bool operator()(const RibOutAttr::NextHopListEntry *lhs,
+                    const RibOutAttr::NextHopListEntry *rhs) const {
+        return lhs->CompareTo(*rhs) < 0;
+    }
+};
+
+//
+// Process wide database of interned NextHopLists. Unlike the path attribute
+// databases it is not owned by a BgpServer since RibOutAttrs are also built
+// without a table. The contents of a NextHopList do not depend on the server
+// once built, so sharing between servers is safe.
+//
+class RibOutNextHopListDB : public BgpPathAttributeDB<
+                                RibOutAttr::NextHopListEntry,
+                                RibOutAttr::NextHopListPtr,
+                                RibOutAttr::NextHopList,
+                                RibOutNextHopListCompare,
+                                RibOutNextHopListDB> {
+public:
+    RibOutNextHopListDB() : bytes_(0) { }
+
+    // Memory used by the interned lists, including the NextHops.
+    uint64_t bytes() const { return bytes_; }
+    void UpdateBytes(int64_t delta) {
+        bytes_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> bytes_;
 };
 
 //
@@ -160,18 +270,32 @@ class RibPeerSet : public BitSet {
 // attributes.  This representation allows us to keep track of a different
 // set of attributes for each set of peers.
 //
+// The RibOutAttr only holds references to the interned BgpAttr and list of
+// nexthops, so an AdvertiseInfo is small and identical advertisements of
+// different routes don't duplicate any state.  The number of AdvertiseInfos
+// is tracked for memory statistics.
+//
 struct AdvertiseInfo {
-    AdvertiseInfo() { }
-    explicit AdvertiseInfo(const RibOutAttr *roattr) : roattr(*roattr) { }
+    AdvertiseInfo() { count_.fetch_add(1, std::memory_order_relaxed); }
+    explicit AdvertiseInfo(const RibOutAttr *roattr) : roattr(*roattr) {
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
     AdvertiseInfo(const AdvertiseInfo &rhs)
         : bitset(rhs.bitset), roattr(rhs.roattr) {
+        count_.fetch_add(1, std::memory_order_relaxed);
     }
+    ~AdvertiseInfo() { count_.fetch_sub(1, std::memory_order_relaxed); }
+
+    static uint64_t count() { return count_; }
 
     // Intrusive slist node for RouteState.
     boost::intrusive::slist_member_hook<> slist_node;
 
     RibPeerSet bitset;
     RibOutAttr roattr;
+
+private:
+    static std::atomic<uint64_t> count_;
 };
 
 //
@@ -348,6 +472,7 @@ public:
     uint32_t cluster_id() const { return policy_.cluster_id; }
 
     void FillStatisticsInfo(std::vector<ShowRibOutStatistics> *sros_list) const;
+    static void FillMemoryInfo(ShowRibOutMemory *srom);
 
 private:
     struct PeerState {
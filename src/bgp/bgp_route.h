@@ -11,6 +11,7 @@
 
 #include "bgp/bgp_path.h"
 #include "base/address.h"
+#include "db/db_arena.h"
 #include "route/route.h"
 
 class BgpAttr;
@@ -25,6 +26,14 @@ public:
     BgpRoute();
     ~BgpRoute();
 
+    // Routes of all families are allocated from the DB arena.
+    static void *operator new(size_t size) {
+        return DBArena::GetInstance()->Alloc(size);
+    }
+    static void operator delete(void *ptr, size_t size) {
+        DBArena::GetInstance()->Free(ptr, size);
+    }
+
     bool HasPaths() const { return front() != NULL; }
     const BgpPath *BestPath() const;
 
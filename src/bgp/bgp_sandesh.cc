@@ -19,6 +19,9 @@
 #include "bgp/mvpn/mvpn_table.h"
 #include "bgp/routing-instance/peer_manager.h"
 #include "bgp/routing-instance/routing_instance.h"
+#include "db/db.h"
+#include "db/db_partition.h"
+#include "db/db_table_walk_mgr.h"
 
 using boost::assign::list_of;
 using std::string;
@@ -631,6 +634,19 @@ public:
         bsc->bgp_server->session_manager()->GetTxSocketStats(&peer_socket_stats);
         resp->set_tx_socket_stats(peer_socket_stats);
 
+        vector<ShowDBPartition> db_partitions;
+        DB *db = bsc->bgp_server->database();
+        for (int idx = 0; idx < DB::PartitionCount(); ++idx) {
+            ShowDBPartition db_partition;
+            db->GetPartition(idx)->FillStats(&db_partition);
+            db_partitions.push_back(db_partition);
+        }
+        resp->set_db_partitions(db_partitions);
+
+        vector<ShowDBTableWalkRequest> db_walk_requests;
+        db->GetWalkMgr()->FillWalkRequests(&db_walk_requests);
+        resp->set_db_walk_requests(db_walk_requests);
+
         resp->set_context(req->context());
         resp->Response();
         return true;
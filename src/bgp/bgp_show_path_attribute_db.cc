@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include "bgp/bgp_show_handler.h"
+
+#include "bgp/bgp_aspath.h"
+#include "bgp/bgp_attr.h"
+#include "bgp/bgp_origin_vn_path.h"
+#include "bgp/bgp_peer_internal_types.h"
+#include "bgp/bgp_ribout.h"
+#include "bgp/bgp_server.h"
+#include "bgp/community.h"
+
+using std::string;
+using std::vector;
+
+//
+// Handler for ShowBgpPathAttributeDBReq.
+//
+class ShowBgpPathAttributeDBHandler {
+public:
+    template <typename TypeDB>
+    static void FillDBInfo(const string &name, TypeDB *db,
+                           vector<ShowBgpPathAttributeDB> *databases) {
+        typename TypeDB::Stats stats;
+        db->GetStats(&stats);
+
+        ShowBgpPathAttributeDB sbpad;
+        sbpad.set_name(name);
+        sbpad.set_size(db->Size());
+        sbpad.set_shards(db->hash_size());
+        sbpad.set_locates(stats.locates);
+        sbpad.set_inserts(stats.inserts);
+        sbpad.set_deletes(stats.deletes);
+        sbpad.set_contended(stats.contended);
+        sbpad.set_retries(stats.retries);
+        databases->push_back(sbpad);
+    }
+
+    static bool CallbackS1(const Sandesh *sr,
+            const RequestPipeline::PipeSpec ps, int stage, int instNum,
+            RequestPipeline::InstData *data) {
+        const ShowBgpPathAttributeDBReq *req =
+            static_cast<const ShowBgpPathAttributeDBReq *>(
+                ps.snhRequest_.get());
+        BgpSandeshContext *bsc =
+            static_cast<BgpSandeshContext *>(req->client_context());
+        BgpServer *server = bsc->bgp_server;
+
+        vector<ShowBgpPathAttributeDB> databases;
+        FillDBInfo("attribute", server->attr_db(), &databases);
+        FillDBInfo("as-path", server->aspath_db(), &databases);
+        FillDBInfo("as-path-4byte", server->aspath_4byte_db(), &databases);
+        FillDBInfo("as4-path", server->as4path_db(), &databases);
+        FillDBInfo("cluster-list", server->cluster_list_db(), &databases);
+        FillDBInfo("community", server->comm_db(), &databases);
+        FillDBInfo("ext-community", server->extcomm_db(), &databases);
+        FillDBInfo("large-community", server->largecomm_db(), &databases);
+        FillDBInfo("olist", server->olist_db(), &databases);
+        FillDBInfo("origin-vn-path", server->ovnpath_db(), &databases);
+        FillDBInfo("pmsi-tunnel", server->pmsi_tunnel_db(), &databases);
+        FillDBInfo("edge-discovery", server->edge_discovery_db(), &databases);
+        FillDBInfo("edge-forwarding", server->edge_forwarding_db(),
+                   &databases);
+        FillDBInfo("ribout-nexthop-list", RibOutAttr::nexthop_list_db(),
+                   &databases);
+
+        ShowBgpPathAttributeDBResp *resp = new ShowBgpPathAttributeDBResp;
+        resp->set_databases(databases);
+        resp->set_context(req->context());
+        resp->Response();
+        return true;
+    }
+};
+
+void ShowBgpPathAttributeDBReq::HandleRequest() const {
+    RequestPipeline::PipeSpec ps(this);
+    RequestPipeline::StageSpec s1;
+    TaskScheduler *scheduler = TaskScheduler::GetInstance();
+
+    s1.taskId_ = scheduler->GetTaskId("bgp::ShowCommand");
+    s1.cbFn_ = ShowBgpPathAttributeDBHandler::CallbackS1;
+    s1.instances_.push_back(0);
+    ps.stages_.push_back(s1);
+    RequestPipeline rp(ps);
+}
@@ -6,8 +6,10 @@
 
 #include "base/regex.h"
 #include "bgp/bgp_peer_internal_types.h"
+#include "bgp/bgp_ribout.h"
 #include "bgp/bgp_server.h"
 #include "bgp/bgp_table.h"
+#include "bgp/bgp_update_sender.h"
 #include "bgp/routing-instance/routing_instance.h"
 
 using contrail::regex;
@@ -71,6 +73,9 @@ void BgpShowHandler<ShowRibOutStatisticsReq, ShowRibOutStatisticsReqIterate,
     ShowRibOutStatisticsResp *resp,
     const vector<ShowRibOutStatistics> &show_list) {
     resp->set_ribouts(show_list);
+    ShowRibOutMemory srom;
+    RibOut::FillMemoryInfo(&srom);
+    resp->set_memory(srom);
 }
 
 //
@@ -120,3 +125,40 @@ void ShowRibOutStatisticsReqIterate::HandleRequest() const {
     ps.stages_.push_back(s1);
     RequestPipeline rp(ps);
 }
+
+//
+// Handler for ShowBgpSenderStatisticsReq.
+//
+class ShowBgpSenderStatisticsHandler {
+public:
+    static bool CallbackS1(const Sandesh *sr,
+            const RequestPipeline::PipeSpec ps, int stage, int instNum,
+            RequestPipeline::InstData *data) {
+        const ShowBgpSenderStatisticsReq *req =
+            static_cast<const ShowBgpSenderStatisticsReq *>(
+                ps.snhRequest_.get());
+        BgpSandeshContext *bsc =
+            static_cast<BgpSandeshContext *>(req->client_context());
+
+        ShowBgpSenderStatisticsResp *resp = new ShowBgpSenderStatisticsResp;
+        resp->set_max_iterations(BgpUpdateSender::worker_max_iterations());
+        vector<ShowBgpSenderPartition> partitions;
+        bsc->bgp_server->update_sender()->FillStatisticsInfo(&partitions);
+        resp->set_partitions(partitions);
+        resp->set_context(req->context());
+        resp->Response();
+        return true;
+    }
+};
+
+void ShowBgpSenderStatisticsReq::HandleRequest() const {
+    RequestPipeline::PipeSpec ps(this);
+    RequestPipeline::StageSpec s1;
+    TaskScheduler *scheduler = TaskScheduler::GetInstance();
+
+    s1.taskId_ = scheduler->GetTaskId("bgp::ShowCommand");
+    s1.cbFn_ = ShowBgpSenderStatisticsHandler::CallbackS1;
+    s1.instances_.push_back(0);
+    ps.stages_.push_back(s1);
+    RequestPipeline rp(ps);
+}
@@ -9,6 +9,7 @@
 #include "bgp/bgp_server.h"
 #include "bgp/bgp_table.h"
 #include "bgp/routing-instance/routing_instance.h"
+#include "db/db_arena.h"
 
 using contrail::regex;
 using contrail::regex_match;
@@ -42,6 +43,11 @@ static void FillRouteTableSummaryInfo(ShowRouteTableSummary *srts,
     srts->set_markers(markers);
     srts->set_listeners(table->GetListenerCount());
     srts->set_walkers(table->walker_count());
+    srts->set_walk_entries(table->walk_entry_count());
+    srts->set_walk_yields(table->walk_yield_count());
+    srts->set_last_walk_wait_usecs(table->last_walk_wait_usecs());
+    srts->set_last_walk_usecs(table->last_walk_usecs());
+    srts->set_max_walk_usecs(table->max_walk_usecs());
 }
 
 //
@@ -103,6 +109,9 @@ void BgpShowHandler<ShowRouteSummaryReq, ShowRouteSummaryReqIterate,
     ShowRouteSummaryResp *resp,
     const vector<ShowRouteTableSummary> &show_list) {
     resp->set_tables(show_list);
+    ShowDBArena arena;
+    DBArena::GetInstance()->FillStats(&arena);
+    resp->set_arena(arena);
 }
 
 //
@@ -12,7 +12,9 @@
 #include "bgp/bgp_peer_internal_types.h"
 #include "bgp/bgp_server.h"
 #include "bgp/bgp_table.h"
+#include "bgp/bgp_path.h"
 #include "bgp/routing-instance/peer_manager.h"
+#include "bgp/routing-instance/routepath_replicator.h"
 #include "bgp/routing-instance/routing_instance.h"
 #include "bgp/routing-policy/routing_policy.h"
 
@@ -44,6 +46,17 @@ static void FillRoutingInstanceTableInfo(ShowRoutingInstanceTable *srit,
     srit->set_stale_paths(table->GetStalePathCount());
     srit->set_llgr_stale_paths(table->GetLlgrStalePathCount());
     srit->set_paths(srit->get_primary_paths() + srit->get_secondary_paths());
+    srit->set_secondary_path_bytes(
+        srit->get_secondary_paths() * sizeof(BgpSecondaryPath));
+
+    // Replication state kept for paths replicated from this table.
+    const RoutePathReplicator *replicator = table->server()->replicator(
+        Address::VpnFamilyFromFamily(table->family()));
+    if (replicator) {
+        srit->set_replicated_paths(replicator->GetReplicatedPathCount(table));
+        srit->set_replication_state_bytes(
+            replicator->GetReplicationStateBytes(table));
+    }
 }
 
 //
@@ -12,7 +12,9 @@
 #include <atomic>
 
 #include "base/task_annotations.h"
+#include "base/time_util.h"
 #include "bgp/ipeer.h"
+#include "bgp/bgp_peer_internal_types.h"
 #include "bgp/bgp_ribout.h"
 #include "bgp/bgp_ribout_updates.h"
 #include "db/db.h"
@@ -384,27 +386,49 @@ public:
     virtual bool Run() {
         CHECK_CONCURRENCY("bgp::SendUpdate");
 
-        while (true) {
+        uint64_t start = ClockMonotonicUsec();
+        int max_iterations = BgpUpdateSender::worker_max_iterations();
+        bool done = true;
+        for (int count = 0; true; ++count) {
+            // Yield if there's more work, it gets picked up when the Worker
+            // is scheduled again.
+            if (max_iterations && count >= max_iterations &&
+                !partition_->work_queue_.empty()) {
+                done = false;
+                break;
+            }
             unique_ptr<WorkBase> wentry = partition_->WorkDequeue();
             if (!wentry.get())
                 break;
-            if (!wentry->valid)
+            if (!wentry->valid) {
+                partition_->stats_.invalid_work++;
                 continue;
+            }
             switch (wentry->type) {
             case WorkBase::WRibOut: {
                 WorkRibOut *workrib = static_cast<WorkRibOut *>(wentry.get());
+                partition_->stats_.ribout_work++;
                 partition_->UpdateRibOut(workrib->ribout, workrib->queue_id);
                 break;
             }
             case WorkBase::WPeer: {
                 WorkPeer *workpeer = static_cast<WorkPeer *>(wentry.get());
+                partition_->stats_.peer_work++;
                 partition_->UpdatePeer(workpeer->peer);
                 break;
             }
             }
         }
 
-        return true;
+        uint64_t elapsed = ClockMonotonicUsec() - start;
+        Stats *stats = &partition_->stats_;
+        stats->runs++;
+        if (!done)
+            stats->yields++;
+        stats->run_usecs += elapsed;
+        if (elapsed > stats->max_run_usecs)
+            stats->max_run_usecs = elapsed;
+        return done;
     }
     string Description() const { return "BgpSenderPartition::Worker"; }
 
@@ -412,6 +436,17 @@ private:
     BgpSenderPartition *partition_;
 };
 
+BgpSenderPartition::Stats::Stats()
+    : runs(0),
+      yields(0),
+      ribout_work(0),
+      peer_work(0),
+      invalid_work(0),
+      max_work_queue_len(0),
+      run_usecs(0),
+      max_run_usecs(0) {
+}
+
 BgpSenderPartition::BgpSenderPartition(BgpUpdateSender *sender, int index)
     : sender_(sender),
       index_(index),
@@ -433,6 +468,21 @@ int BgpSenderPartition::task_id() const {
     return sender_->task_id();
 }
 
+void BgpSenderPartition::FillStatisticsInfo(
+    ShowBgpSenderPartition *spart) const {
+    spart->set_index(index_);
+    spart->set_running(running_);
+    spart->set_work_queue_len(work_queue_.size());
+    spart->set_max_work_queue_len(stats_.max_work_queue_len);
+    spart->set_runs(stats_.runs);
+    spart->set_yields(stats_.yields);
+    spart->set_ribout_work(stats_.ribout_work);
+    spart->set_peer_work(stats_.peer_work);
+    spart->set_invalid_work(stats_.invalid_work);
+    spart->set_run_usecs(stats_.run_usecs);
+    spart->set_max_run_usecs(stats_.max_run_usecs);
+}
+
 //
 // Add the (RibOut, IPeerUpdate) combo to the BgpSenderPartition.
 // Find or create the corresponding RibState and PeerState and sets up the
@@ -572,6 +622,8 @@ void BgpSenderPartition::WorkEnqueue(WorkBase *wentry) {
         "bgp::PeerMembership");
 
     work_queue_.push_back(wentry);
+    if (work_queue_.size() > stats_.max_work_queue_len)
+        stats_.max_work_queue_len = work_queue_.size();
     MaybeStartWorker();
 }
 
@@ -951,6 +1003,8 @@ bool BgpSenderPartition::CheckInvariants() const {
     return true;
 }
 
+int BgpUpdateSender::worker_max_iterations_ = 0;
+
 //
 // Constructor for BgpUpdateSender.
 // Initialize send ready WorkQueue and allocate BgpSenderPartitions.
@@ -961,6 +1015,15 @@ BgpUpdateSender::BgpUpdateSender(BgpServer *server)
       send_ready_queue_(
           TaskScheduler::GetInstance()->GetTaskId("bgp::SendReadyTask"), 0,
           boost::bind(&BgpUpdateSender::SendReadyCallback, this, _1)) {
+    static bool init_ = false;
+    if (!init_) {
+        // Limit the work done by a Worker in one run, see BgpSenderPartition.
+        char *max_iterations_str = getenv("BGP_SEND_UPDATE_MAX_ITERATIONS");
+        if (max_iterations_str) {
+            worker_max_iterations_ = strtol(max_iterations_str, NULL, 0);
+        }
+        init_ = true;
+    }
     for (int idx = 0; idx < DB::PartitionCount(); ++idx) {
         partitions_.push_back(new BgpSenderPartition(this, idx));
     }
@@ -1065,6 +1128,18 @@ bool BgpUpdateSender::CheckInvariants() const {
     return true;
 }
 
+//
+// Fill statistics for all BgpSenderPartitions.
+//
+void BgpUpdateSender::FillStatisticsInfo(
+    vector<ShowBgpSenderPartition> *sparts) const {
+    BOOST_FOREACH(const BgpSenderPartition *partition, partitions_) {
+        ShowBgpSenderPartition spart;
+        partition->FillStatisticsInfo(&spart);
+        sparts->push_back(spart);
+    }
+}
+
 //
 // Disable all BgpSenderPartitions.
 //
@@ -18,6 +18,7 @@ class BgpUpdateSender;
 class IPeerUpdate;
 class RibOut;
 class RibPeerSet;
+class ShowBgpSenderPartition;
 
 //
 // This class maintains state to generate updates for a DB partition for all
@@ -45,6 +46,12 @@ class RibPeerSet;
 // WorkRibOut entry after adding a RouteUpdate to an empty UpdateQueue, and
 // IPeerUpdate class which creates a WorkPeer entry when it becomes unblocked.
 //
+// The Worker normally runs till the work queue is empty. If a limit on the
+// number of WorkBase entries per run is set, the Worker yields after that
+// many entries so that the db::DBTable task for the same partition, which
+// it excludes, can export more routes while the updates for the previous
+// ones are being built and sent.
+//
 class BgpSenderPartition {
 public:
     BgpSenderPartition(BgpUpdateSender *sender, int index);
@@ -65,6 +72,8 @@ public:
     int task_id() const;
     int index() const { return index_; }
 
+    void FillStatisticsInfo(ShowBgpSenderPartition *spart) const;
+
     // For unit testing.
     void set_disabled(bool disabled);
 
@@ -108,6 +117,18 @@ private:
     typedef IndexMap<IPeerUpdate *, PeerState> PeerStateMap;
     typedef IndexMap<RibOut *, RibState> RibStateMap;
 
+    struct Stats {
+        Stats();
+        uint64_t runs;
+        uint64_t yields;
+        uint64_t ribout_work;
+        uint64_t peer_work;
+        uint64_t invalid_work;
+        uint64_t max_work_queue_len;
+        uint64_t run_usecs;
+        uint64_t max_run_usecs;
+    };
+
     void MaybeStartWorker();
     std::unique_ptr<WorkBase> WorkDequeue();
     void WorkEnqueue(WorkBase *wentry);
@@ -141,6 +162,7 @@ private:
     Worker *worker_task_;
     PeerStateMap peer_state_imap_;
     RibStateMap rib_state_imap_;
+    Stats stats_;
 
     DISALLOW_COPY_AND_ASSIGN(BgpSenderPartition);
 };
@@ -172,6 +194,15 @@ public:
     int task_id() const { return task_id_; }
     bool CheckInvariants() const;
 
+    // Maximum number of WorkBase entries processed by a Worker before it
+    // yields. 0 means that the Worker runs till the work queue is empty.
+    static void SetWorkerMaxIterations(int max_iterations) {
+        worker_max_iterations_ = max_iterations;
+    }
+    static int worker_max_iterations() { return worker_max_iterations_; }
+
+    void FillStatisticsInfo(std::vector<ShowBgpSenderPartition> *sparts) const;
+
     // For unit testing.
     void DisableProcessing();
     void EnableProcessing();
@@ -184,6 +215,8 @@ private:
     bool SendReadyCallback(IPeerUpdate *peer);
     BgpSenderPartition *partition(int index) { return partitions_[index]; }
 
+    static int worker_max_iterations_;
+
     BgpServer *server_;
     int task_id_;
     std::vector<BgpSenderPartition *> partitions_;
@@ -47,6 +47,7 @@
 #include "xml/xml_pugi.h"
 #include "xmpp/xmpp_connection.h"
 #include "xmpp/xmpp_init.h"
+#include "xmpp/xmpp_item_reader.h"
 #include "xmpp/xmpp_server.h"
 #include "xmpp/sandesh/xmpp_peer_info_types.h"
 
@@ -495,6 +496,7 @@ BgpXmppChannel::BgpXmppChannel(XmppChannel *channel,
       peer_close_(new BgpXmppPeerClose(this)),
       peer_stats_(new PeerStats(this)),
       bgp_policy_(BgpProto::XMPP, RibExportPolicy::XMPP, -1, 0),
+      batch_enqueue_(false),
       manager_(manager),
       delete_in_progress_(false),
       deleted_(false),
@@ -972,7 +974,7 @@ bool BgpXmppChannel::ProcessMcastItem(string vrf_name,
         " source " << item.entry.nlri.source <<
         " and label range " << label_range <<
         " enqueued for " << (add_change ? "add/change" : "delete"));
-    table->Enqueue(&req);
+    EnqueueRequest(table, &req);
     return true;
 }
 
@@ -1139,7 +1141,7 @@ bool BgpXmppChannel::ProcessMvpnItem(string vrf_name,
         "Multicast group " << item.entry.nlri.group <<
         " source " << item.entry.nlri.source <<
         " enqueued for " << (add_change ? "add/change" : "delete"));
-    table->Enqueue(&req);
+    EnqueueRequest(table, &req);
     return true;
 }
 
@@ -1423,7 +1425,7 @@ bool BgpXmppChannel::ProcessItem(string vrf_name,
         " with next-hop " << nh_address << " and label " << label <<
         " enqueued for " << (add_change ? "add/change" : "delete") <<
         " to table " << table->name());
-    table->Enqueue(&req);
+    EnqueueRequest(table, &req);
 
     if (add_change) {
         stats_[RX].reach++;
@@ -1749,7 +1751,7 @@ bool BgpXmppChannel::ProcessInet6Item(string vrf_name,
             " with next-hop " << nh_address << " and label " << label <<
             " enqueued for " << (add_change ? "add/change" : "delete") <<
             " to table " << table->name());
-        table->Enqueue(&req);
+        EnqueueRequest(table, &req);
     }
 
     if (add_change) {
@@ -2137,7 +2139,7 @@ bool BgpXmppChannel::ProcessEnetItem(string vrf_name,
         " with next-hop " << nh_address <<
         " label " << label << " l3-label " << l3_label <<
         " enqueued for " << (add_change ? "add/change" : "delete"));
-    table->Enqueue(&req);
+    EnqueueRequest(table, &req);
     return true;
 }
 
@@ -2172,6 +2174,28 @@ void BgpXmppChannel::DequeueRequest(const string &table_name,
     table->Enqueue(ptr.get());
 }
 
+// Enqueue the request to the table, or add it to the batch for the table
+// while the items of a publish are processed.
+void BgpXmppChannel::EnqueueRequest(BgpTable *table, DBRequest *req) {
+    if (!batch_enqueue_) {
+        table->Enqueue(req);
+        return;
+    }
+
+    DBRequest *request_entry = new DBRequest();
+    request_entry->Swap(req);
+    request_batch_[table].push_back(request_entry);
+}
+
+void BgpXmppChannel::EnqueueRequestBatch() {
+    for (RequestBatch::iterator it = request_batch_.begin();
+         it != request_batch_.end(); ++it) {
+        it->first->EnqueueBatch(it->second);
+        STLDeleteValues(&it->second);
+    }
+    request_batch_.clear();
+}
+
 bool BgpXmppChannel::ResumeClose() {
     peer_->Close(true);
     return true;
@@ -2960,10 +2984,17 @@ void BgpXmppChannel::ReceiveUpdate(const XmppStanza::XmppMessage *msg) {
             } else if (iq->action.compare("unsubscribe") == 0) {
                 ProcessSubscriptionRequest(iq->node, iq, false);
             } else if (iq->action.compare("publish") == 0) {
-                XmlBase *impl = msg->dom.get();
                 stats_[RX].rt_updates++;
-                XmlPugi *pugi = reinterpret_cast<XmlPugi *>(impl);
-                xml_node item = pugi->FindNode("item");
+                XmppItemReader reader(iq);
+                xml_node item = reader.Next();
+
+                // Items that can't be parsed don't make an empty items-list.
+                if (item == 0 && reader.error_count()) {
+                    BGP_LOG_PEER_WARNING(Message, Peer(), BGP_LOG_FLAG_ALL,
+                        BGP_PEER_DIR_IN, "Dropped publish for " << iq->node <<
+                        " with " << reader.error_count() << " bad items");
+                    return;
+                }
 
                 // Empty items-list can be considered as EOR Marker for all afis
                 if (item == 0) {
@@ -2974,9 +3005,8 @@ void BgpXmppChannel::ReceiveUpdate(const XmppStanza::XmppMessage *msg) {
                     ReceiveEndOfRIB(Address::UNSPEC);
                     return;
                 }
-                for (; item; item = item.next_sibling()) {
-                    if (strcmp(item.name(), "item") != 0) continue;
-
+                batch_enqueue_ = true;
+                for (; item; item = reader.Next()) {
                     string id(iq->as_node.c_str());
                     char *str = const_cast<char *>(id.c_str());
                     char *saveptr;
@@ -3002,6 +3032,14 @@ void BgpXmppChannel::ReceiveUpdate(const XmppStanza::XmppMessage *msg) {
                         ProcessEnetItem(iq->node, item, iq->is_as_node);
                     }
                 }
+                batch_enqueue_ = false;
+                EnqueueRequestBatch();
+
+                if (reader.error_count()) {
+                    BGP_LOG_PEER_WARNING(Message, Peer(), BGP_LOG_FLAG_ALL,
+                        BGP_PEER_DIR_IN, "Dropped " << reader.error_count() <<
+                        " bad items in publish for " << iq->node);
+                }
             }
         }
     }
@@ -3030,8 +3068,10 @@ BgpXmppChannelManager::BgpXmppChannelManager(XmppServer *xmpp_server,
     subscription_gen_id_ = 1;
     deleting_count_ = 0;
 
-    if (xmpp_server)
+    if (xmpp_server) {
         xmpp_server->CreateConfigUpdater(server->config_manager());
+        xmpp_server->set_stream_items(true);
+    }
     queue_.SetEntryCallback(
             boost::bind(&BgpXmppChannelManager::IsReadyForDeletion, this));
     if (xmpp_server) {
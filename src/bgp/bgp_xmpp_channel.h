@@ -19,6 +19,7 @@
 #include "base/queue_task.h"
 #include "bgp/bgp_rib_policy.h"
 #include "bgp/routing-instance/routing_instance.h"
+#include "db/db_table.h"
 #include "io/tcp_session.h"
 #include "net/rd.h"
 #include "schema/xmpp_mvpn_types.h"
@@ -272,6 +273,7 @@ private:
     // values of same key.
     typedef std::pair<const std::string, const std::string> VrfTableName;
     typedef std::multimap<VrfTableName, DBRequest *> DeferQ;
+    typedef std::map<BgpTable *, DBTableBase::RequestList> RequestBatch;
 
     virtual void ReceiveUpdate(const XmppStanza::XmppMessage *msg);
 
@@ -325,6 +327,8 @@ private:
     void UnregisterTable(int line, BgpTable *table);
     void MembershipRequestCallback(BgpTable *table);
     void DequeueRequest(const std::string &table_name, DBRequest *request);
+    void EnqueueRequest(BgpTable *table, DBRequest *req);
+    void EnqueueRequestBatch();
     bool XmppDecodeAddress(int af, const std::string &address,
                            IpAddress *addrp, bool zero_ok = false);
     bool ResumeClose();
@@ -354,6 +358,11 @@ private:
     // DB Requests pending membership request response.
     DeferQ defer_q_;
 
+    // DB Requests built from the items of the publish being processed,
+    // enqueued to each table as one batch once all items are parsed.
+    bool batch_enqueue_;
+    RequestBatch request_batch_;
+
     TableMembershipRequestMap table_membership_request_map_;
     InstanceMembershipRequestMap instance_membership_request_map_;
     BgpXmppChannelManager *manager_;
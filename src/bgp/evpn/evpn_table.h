@@ -38,6 +38,9 @@ public:
 
     virtual size_t Hash(const DBEntry *entry) const;
     virtual size_t Hash(const DBRequestKey *key) const;
+    virtual PartitionIndexType GetPartitionIndexType() const {
+        return PARTITION_INDEX_FLAT;
+    }
 
     virtual BgpRoute *RouteReplicate(BgpServer *server, BgpTable *src_table,
                                      BgpRoute *src_rt, const BgpPath *path,
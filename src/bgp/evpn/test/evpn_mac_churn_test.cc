@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <iterator>
+
+#include "base/task_annotations.h"
+#include "base/test/task_test_util.h"
+#include "bgp/bgp_evpn.h"
+#include "bgp/bgp_factory.h"
+#include "bgp/evpn/evpn_table.h"
+#include "bgp/extended-community/esi_label.h"
+#include "bgp/test/bgp_server_test_util.h"
+#include "bgp/tunnel_encap/tunnel_encap.h"
+#include "bgp/xmpp_message_builder.h"
+#include "control-node/control_node.h"
+#include "io/test/event_manager_test.h"
+
+using std::string;
+using std::vector;
+
+class PeerMock : public IPeer {
+public:
+    PeerMock(const Ip4Address address, uint32_t label)
+        : address_(address), label_(label) {
+        address_str_ = address.to_string();
+    }
+    virtual ~PeerMock() { }
+
+    virtual void UpdateTotalPathCount(int count) const { }
+    const Ip4Address &address() const {
+        return address_;
+    }
+    void set_address(Ip4Address address) {
+        address_ = address;
+        address_str_ = address.to_string();
+    }
+    uint32_t label() {
+        return label_;
+    }
+    void set_label(uint32_t label) {
+        label_ = label;
+    }
+    virtual const std::string &ToString() const {
+        return address_str_;
+    }
+    virtual const std::string &ToUVEKey() const {
+        return address_str_;
+    }
+    virtual bool SendUpdate(const uint8_t *msg, size_t msgsize) {
+        return true;
+    }
+    virtual BgpServer *server() { return NULL; }
+    virtual BgpServer *server() const { return NULL; }
+    virtual IPeerClose *peer_close() { return NULL; }
+    virtual IPeerClose *peer_close() const { return NULL; }
+    virtual void UpdateCloseRouteStats(Address::Family family,
+        const BgpPath *old_path, uint32_t path_flags) const {
+    }
+    virtual IPeerDebugStats *peer_stats() {
+        return NULL;
+    }
+    virtual const IPeerDebugStats *peer_stats() const {
+        return NULL;
+    }
+    virtual bool IsReady() const {
+        return true;
+    }
+    virtual bool IsXmppPeer() const {
+        return false;
+    }
+    virtual bool IsRegistrationRequired() const {
+        return false;
+    }
+    virtual void Close(bool graceful) { }
+    BgpProto::BgpPeerType PeerType() const {
+        return BgpProto::IBGP;
+    }
+    virtual uint32_t bgp_identifier() const {
+        return htonl(address_.to_ulong());
+    }
+    virtual const std::string GetStateName() const {
+        return "";
+    }
+    virtual void UpdateTotalPathCount(int count) { }
+    virtual int GetTotalPathCount() const { return 0; }
+    virtual bool IsAs4Supported() const { return false; }
+    virtual void UpdatePrimaryPathCount(int count,
+        Address::Family family) const { }
+    virtual int GetPrimaryPathCount() const { return 0; }
+    virtual void ProcessPathTunnelEncapsulation(const BgpPath *path,
+        BgpAttr *attr, ExtCommunityDB *extcomm_db, const BgpTable *table)
+        const {
+    }
+    virtual const std::vector<std::string> GetDefaultTunnelEncap(
+        Address::Family family) const {
+        return std::vector<std::string>();
+    }
+    virtual void MembershipRequestCallback(BgpTable *table) { }
+    virtual bool MembershipPathCallback(DBTablePartBase *tpart,
+        BgpRoute *route, BgpPath *path) { return false; }
+    virtual bool CanUseMembershipManager() const { return true; }
+    virtual bool IsInGRTimerWaitState() const { return false; }
+    virtual bool IsRouterTypeBGPaaS() const { return false; }
+
+private:
+    Ip4Address address_;
+    uint32_t label_;
+    std::string address_str_;
+};
+
+static const char *config = "\
+<config>\
+    <bgp-router name=\'local\'>\
+        <autonomous-system>64512</autonomous-system>\
+        <identifier>192.168.0.1</identifier>\
+        <address>127.0.0.1</address>\
+    </bgp-router>\
+    <virtual-network name='blue'>\
+        <network-id>1</network-id>\
+    </virtual-network>\
+    <routing-instance name='blue'>\
+        <virtual-network>blue</virtual-network>\
+        <vrf-target>target:64512:1</vrf-target>\
+    </routing-instance>\
+</config>\
+";
+
+//
+// Verify that the EvpnManager settles aliased paths when many MAC routes
+// move between all-active EvpnSegments, as happens when a large number of
+// VMs migrate at once.
+//
+class EvpnMacChurnTest : public ::testing::Test {
+protected:
+    EvpnMacChurnTest()
+        : thread_(&evm_), blue_(NULL), blue_manager_(NULL) {
+    }
+
+    virtual void SetUp() {
+        server_.reset(new BgpServerTest(&evm_, "local"));
+        thread_.Start();
+        server_->Configure(config);
+        task_util::WaitForIdle();
+
+        DB *db = server_->database();
+        TASK_UTIL_EXPECT_TRUE(db->FindTable("blue.evpn.0") != NULL);
+        blue_ = static_cast<EvpnTable *>(db->FindTable("blue.evpn.0"));
+        blue_manager_ = blue_->GetEvpnManager();
+
+        for (int idx = 1; idx <= 3; ++idx) {
+            boost::system::error_code ec;
+            string address_str = string("20.1.1.") + integerToString(idx);
+            Ip4Address address = Ip4Address::from_string(address_str, ec);
+            assert(ec.value() == 0);
+            peers_.push_back(new PeerMock(address, 1000));
+        }
+
+        boost::system::error_code ec;
+        esi1_ = EthernetSegmentId::FromString(
+            "11:22:33:44:55:66:77:88:99:01", &ec);
+        assert(ec.value() == 0);
+        esi2_ = EthernetSegmentId::FromString(
+            "11:22:33:44:55:66:77:88:99:02", &ec);
+        assert(ec.value() == 0);
+    }
+
+    virtual void TearDown() {
+        task_util::WaitForIdle();
+        server_->Shutdown();
+        task_util::WaitForIdle();
+        evm_.Shutdown();
+        thread_.Join();
+        task_util::WaitForIdle();
+        STLDeleteValues(&peers_);
+    }
+
+    static EvpnPrefix BuildMacPrefix(int idx) {
+        char mac_str[32];
+        snprintf(mac_str, sizeof(mac_str), "00:00:%02x:%02x:%02x:01",
+                 (idx >> 16) & 0xff, (idx >> 8) & 0xff, idx & 0xff);
+        boost::system::error_code ec;
+        MacAddress mac_addr = MacAddress::FromString(mac_str, &ec);
+        assert(ec.value() == 0);
+        return EvpnPrefix(RouteDistinguisher::kZeroRd, 0, mac_addr,
+                          IpAddress());
+    }
+
+    void AddMacRoute(PeerMock *peer, int idx, const EthernetSegmentId &esi) {
+        BgpAttrSpec attr_spec;
+        ExtCommunitySpec ext_comm;
+        TunnelEncap tun_encap("vxlan");
+        ext_comm.communities.push_back(tun_encap.GetExtCommunityValue());
+        attr_spec.push_back(&ext_comm);
+        BgpAttrNextHop nexthop(peer->address().to_ulong());
+        attr_spec.push_back(&nexthop);
+        BgpAttrEsi esi_spec(esi);
+        attr_spec.push_back(&esi_spec);
+        BgpAttrPtr attr = server_->attr_db()->Locate(attr_spec);
+
+        DBRequest addReq;
+        addReq.key.reset(new EvpnTable::RequestKey(BuildMacPrefix(idx), peer));
+        addReq.data.reset(
+            new EvpnTable::RequestData(attr, 0, peer->label()));
+        addReq.oper = DBRequest::DB_ENTRY_ADD_CHANGE;
+        blue_->Enqueue(&addReq);
+    }
+
+    void DelMacRoute(PeerMock *peer, int idx) {
+        DBRequest delReq;
+        delReq.key.reset(new EvpnTable::RequestKey(BuildMacPrefix(idx), peer));
+        delReq.oper = DBRequest::DB_ENTRY_DELETE;
+        blue_->Enqueue(&delReq);
+    }
+
+    void AddAutoDiscoveryRoute(PeerMock *peer, const EthernetSegmentId &esi) {
+        EvpnPrefix prefix(RouteDistinguisher::kZeroRd, esi,
+                          EvpnPrefix::kMaxTag);
+
+        BgpAttrSpec attr_spec;
+        ExtCommunitySpec ext_comm;
+        TunnelEncap tun_encap("vxlan");
+        ext_comm.communities.push_back(tun_encap.GetExtCommunityValue());
+        EsiLabel esi_label(false);
+        ext_comm.communities.push_back(esi_label.GetExtCommunityValue());
+        attr_spec.push_back(&ext_comm);
+        BgpAttrNextHop nexthop(peer->address().to_ulong());
+        attr_spec.push_back(&nexthop);
+        BgpAttrPtr attr = server_->attr_db()->Locate(attr_spec);
+
+        DBRequest addReq;
+        addReq.key.reset(new EvpnTable::RequestKey(prefix, peer));
+        addReq.data.reset(new EvpnTable::RequestData(attr, 0, 0));
+        addReq.oper = DBRequest::DB_ENTRY_ADD_CHANGE;
+        blue_->Enqueue(&addReq);
+    }
+
+    void DelAutoDiscoveryRoute(PeerMock *peer, const EthernetSegmentId &esi) {
+        EvpnPrefix prefix(RouteDistinguisher::kZeroRd, esi,
+                          EvpnPrefix::kMaxTag);
+
+        DBRequest delReq;
+        delReq.key.reset(new EvpnTable::RequestKey(prefix, peer));
+        delReq.oper = DBRequest::DB_ENTRY_DELETE;
+        blue_->Enqueue(&delReq);
+    }
+
+    // Return the number of paths for the MAC route or -1 if there's none.
+    int GetMacRoutePathCount(int idx) {
+        task_util::TaskSchedulerLock lock;
+        EvpnTable::RequestKey key(BuildMacPrefix(idx), NULL);
+        EvpnRoute *route = static_cast<EvpnRoute *>(blue_->Find(&key));
+        return route ? route->count() : -1;
+    }
+
+    // Return true if the EvpnSegment has the given number of PEs.
+    bool CheckSegmentPeCount(const EthernetSegmentId &esi, size_t count) {
+        task_util::TaskSchedulerLock lock;
+        EvpnSegment *segment = blue_manager_->FindSegment(esi);
+        if (!segment)
+            return count == 0;
+        return static_cast<size_t>(
+            std::distance(segment->begin(), segment->end())) == count;
+    }
+
+    uint64_t GetMacUpdates() {
+        uint64_t count = 0;
+        for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id)
+            count += blue_manager_->GetPartition(part_id)->mac_updates();
+        return count;
+    }
+
+    uint64_t GetMacUpdateBatches() {
+        uint64_t count = 0;
+        for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id) {
+            count +=
+                blue_manager_->GetPartition(part_id)->mac_update_batches();
+        }
+        return count;
+    }
+
+    // Return the index of MAC routes that hash to the given partition.
+    vector<int> GetPartitionMacs(int part_id, size_t count) {
+        vector<int> mac_list;
+        for (int idx = 0; mac_list.size() < count; ++idx) {
+            EvpnTable::RequestKey key(BuildMacPrefix(idx), NULL);
+            if (blue_->GetTablePartition(&key)->index() == part_id)
+                mac_list.push_back(idx);
+        }
+        return mac_list;
+    }
+
+    void DisableMacUpdateProcessing() {
+        task_util::TaskFire(
+            boost::bind(&EvpnManager::DisableMacUpdateProcessing,
+                blue_manager_), "bgp::Config");
+    }
+
+    void EnableMacUpdateProcessing() {
+        task_util::TaskFire(
+            boost::bind(&EvpnManager::EnableMacUpdateProcessing,
+                blue_manager_), "bgp::Config");
+    }
+
+    EventManager evm_;
+    ServerThread thread_;
+    BgpServerTestPtr server_;
+    EvpnTable *blue_;
+    EvpnManager *blue_manager_;
+    vector<PeerMock *> peers_;
+    EthernetSegmentId esi1_, esi2_;
+};
+
+//
+// MAC routes from the first PE move back and forth between an EvpnSegment
+// that's multi-homed to all 3 PEs and one that's multi-homed to the first 2.
+//
+TEST_F(EvpnMacChurnTest, MacMove) {
+    const int kMacCount = 1024;
+    const int kMoveCount = 4;
+
+    for (size_t idx = 0; idx < peers_.size(); ++idx) {
+        AddAutoDiscoveryRoute(peers_[idx], esi1_);
+        if (idx < 2)
+            AddAutoDiscoveryRoute(peers_[idx], esi2_);
+    }
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi1_, 3));
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi2_, 2));
+
+    for (int idx = 0; idx < kMacCount; ++idx) {
+        AddMacRoute(peers_[0], idx, esi1_);
+    }
+    task_util::WaitForIdle();
+    for (int idx = 0; idx < kMacCount; ++idx) {
+        TASK_UTIL_EXPECT_EQ(3, GetMacRoutePathCount(idx));
+    }
+
+    for (int move = 1; move <= kMoveCount; ++move) {
+        const EthernetSegmentId &esi = (move % 2) ? esi2_ : esi1_;
+        for (int idx = 0; idx < kMacCount; ++idx) {
+            AddMacRoute(peers_[0], idx, esi);
+        }
+        task_util::WaitForIdle();
+        for (int idx = 0; idx < kMacCount; ++idx) {
+            TASK_UTIL_EXPECT_EQ((move % 2) ? 2 : 3,
+                                GetMacRoutePathCount(idx));
+        }
+    }
+
+    for (int idx = 0; idx < kMacCount; ++idx) {
+        DelMacRoute(peers_[0], idx);
+    }
+    task_util::WaitForIdle();
+    for (int idx = 0; idx < kMacCount; ++idx) {
+        TASK_UTIL_EXPECT_EQ(-1, GetMacRoutePathCount(idx));
+    }
+
+    // Every route is processed at least once in each phase.
+    uint64_t mac_updates = GetMacUpdates();
+    uint64_t mac_update_batches = GetMacUpdateBatches();
+    EXPECT_LE(static_cast<uint64_t>(kMacCount * (kMoveCount + 2)),
+              mac_updates);
+    EXPECT_LT(0, mac_update_batches);
+    EXPECT_LE(mac_update_batches, mac_updates);
+
+    for (size_t idx = 0; idx < peers_.size(); ++idx) {
+        DelAutoDiscoveryRoute(peers_[idx], esi1_);
+        if (idx < 2)
+            DelAutoDiscoveryRoute(peers_[idx], esi2_);
+    }
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi1_, 0));
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi2_, 0));
+}
+
+//
+// More MAC routes than kMaxMacUpdateBatch are queued for update on the same
+// partition while MAC update processing is disabled. The partition processes
+// them in more than one batch and every route gets its aliased paths.
+//
+TEST_F(EvpnMacChurnTest, MacUpdateBatch) {
+    const size_t kMacCount = 2 * EvpnManagerPartition::kMaxMacUpdateBatch + 1;
+    vector<int> mac_list = GetPartitionMacs(0, kMacCount);
+    EvpnManagerPartition *partition = blue_manager_->GetPartition(0);
+
+    for (size_t idx = 0; idx < peers_.size(); ++idx) {
+        AddAutoDiscoveryRoute(peers_[idx], esi1_);
+    }
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi1_, 3));
+
+    DisableMacUpdateProcessing();
+    uint64_t mac_updates = partition->mac_updates();
+    uint64_t mac_update_batches = partition->mac_update_batches();
+    for (vector<int>::const_iterator it = mac_list.begin();
+         it != mac_list.end(); ++it) {
+        AddMacRoute(peers_[0], *it, esi1_);
+    }
+    task_util::WaitForIdle();
+    for (vector<int>::const_iterator it = mac_list.begin();
+         it != mac_list.end(); ++it) {
+        TASK_UTIL_EXPECT_EQ(1, GetMacRoutePathCount(*it));
+    }
+    EXPECT_EQ(mac_updates, partition->mac_updates());
+    EXPECT_EQ(mac_update_batches, partition->mac_update_batches());
+
+    EnableMacUpdateProcessing();
+    task_util::WaitForIdle();
+    for (vector<int>::const_iterator it = mac_list.begin();
+         it != mac_list.end(); ++it) {
+        TASK_UTIL_EXPECT_EQ(3, GetMacRoutePathCount(*it));
+    }
+    EXPECT_LE(mac_updates + kMacCount, partition->mac_updates());
+    EXPECT_LE(mac_update_batches + 3, partition->mac_update_batches());
+
+    for (vector<int>::const_iterator it = mac_list.begin();
+         it != mac_list.end(); ++it) {
+        DelMacRoute(peers_[0], *it);
+    }
+    task_util::WaitForIdle();
+    for (vector<int>::const_iterator it = mac_list.begin();
+         it != mac_list.end(); ++it) {
+        TASK_UTIL_EXPECT_EQ(-1, GetMacRoutePathCount(*it));
+    }
+
+    for (size_t idx = 0; idx < peers_.size(); ++idx) {
+        DelAutoDiscoveryRoute(peers_[idx], esi1_);
+    }
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_TRUE(CheckSegmentPeCount(esi1_, 0));
+}
+
+static void SetUp() {
+    ControlNode::SetDefaultSchedulingPolicy();
+    BgpServerTest::GlobalSetUp();
+    BgpStaticObjectFactory::LinkImpl<BgpXmppMessageBuilder,
+        BgpXmppMessageBuilder>();
+}
+
+static void TearDown() {
+    TaskScheduler *scheduler = TaskScheduler::GetInstance();
+    scheduler->Terminate();
+}
+
+int main(int argc, char **argv) {
+    bgp_log_test::init();
+    ::testing::InitGoogleTest(&argc, argv);
+    SetUp();
+    int result = RUN_ALL_TESTS();
+    TearDown();
+    return result;
+}
@@ -38,6 +38,9 @@ public:
 
     virtual size_t Hash(const DBEntry *entry) const;
     virtual size_t Hash(const DBRequestKey *key) const;
+    virtual PartitionIndexType GetPartitionIndexType() const {
+        return PARTITION_INDEX_FLAT;
+    }
 
     virtual bool Export(RibOut *ribout, Route *route,
                         const RibPeerSet &peerset,
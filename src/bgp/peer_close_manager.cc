@@ -11,6 +11,7 @@
 #include <boost/foreach.hpp>
 
 #include "base/task_annotations.h"
+#include "base/time_util.h"
 #include "bgp/bgp_log.h"
 #include "bgp/bgp_membership.h"
 #include "bgp/bgp_peer_types.h"
@@ -39,6 +40,7 @@
     do {                                                                       \
         assert(state_ != state);                                               \
         PEER_CLOSE_MANAGER_LOG("Move to state " << GetStateName(state));       \
+        UpdateStateTime();                                                     \
         state_ = state;                                                        \
     } while (false)
 
@@ -52,9 +54,11 @@ PeerCloseManager::PeerCloseManager(IPeerClose *peer_close,
                      peer_close_->GetTaskInstance(),
                      boost::bind(&PeerCloseManager::EventCallback, this, _1))),
         state_(NONE), close_again_(false), graceful_(true), gr_elapsed_(0),
-        llgr_elapsed_(0), membership_state_(MEMBERSHIP_NONE) {
+        llgr_elapsed_(0), membership_state_(MEMBERSHIP_NONE),
+        state_start_usecs_(0) {
     stats_.init++;
     membership_req_pending_ = 0;
+    ResetStalePathCount();
     gr_timer_ = TimerManager::CreateTimer(*io_service,
                                           "Graceful Restart Timer");
 }
@@ -68,9 +72,11 @@ PeerCloseManager::PeerCloseManager(IPeerClose *peer_close) :
                      peer_close_->GetTaskInstance(),
                      boost::bind(&PeerCloseManager::EventCallback, this, _1))),
         state_(NONE), close_again_(false), graceful_(true), gr_elapsed_(0),
-        llgr_elapsed_(0), membership_state_(MEMBERSHIP_NONE) {
+        llgr_elapsed_(0), membership_state_(MEMBERSHIP_NONE),
+        state_start_usecs_(0) {
     stats_.init++;
     membership_req_pending_ = 0;
+    ResetStalePathCount();
     if (peer_close->peer() && peer_close->peer()->server()) {
         gr_timer_ =
            TimerManager::CreateTimer(*peer_close->peer()->server()->ioservice(),
@@ -104,6 +110,25 @@ std::string PeerCloseManager::GetStateName(State state) const {
     return "";
 }
 
+// Account the time spent in the current state. Called when moving out of it.
+void PeerCloseManager::UpdateStateTime() {
+    uint64_t now = ClockMonotonicUsec();
+    if (state_ != NONE) {
+        Stats::StateTime *state_time = &stats_.state_times[state_];
+        state_time->last_usecs = now - state_start_usecs_;
+        state_time->total_usecs += state_time->last_usecs;
+        if (state_time->last_usecs > state_time->max_usecs)
+            state_time->max_usecs = state_time->last_usecs;
+    }
+    state_start_usecs_ = now;
+}
+
+void PeerCloseManager::ResetStalePathCount() {
+    for (size_t i = 0; i < Address::NUM_FAMILIES; i++) {
+        stale_path_count_[i] = 0;
+    }
+}
+
 std::string PeerCloseManager::GetMembershipStateName(
         MembershipState state) const {
     switch (state) {
@@ -495,8 +520,7 @@ void PeerCloseManager::MembershipRequest(Event *evnet) {
                     "MembershipManager::Unregister");
                 Unregister(table);
             } else if (state_ == PeerCloseManager::SWEEP) {
-                PEER_CLOSE_MANAGER_TABLE_LOG("MembershipManager::WalkRibIn");
-                WalkRibIn(table);
+                SweepRibIn(table);
             } else {
                 PEER_CLOSE_MANAGER_TABLE_LOG(
                     "MembershipManager::UnregisterRibOut");
@@ -508,6 +532,8 @@ void PeerCloseManager::MembershipRequest(Event *evnet) {
                 PEER_CLOSE_MANAGER_TABLE_LOG(
                     "MembershipManager::UnregisterRibIn");
                 UnregisterRibIn(table);
+            } else if (state_ == PeerCloseManager::SWEEP) {
+                SweepRibIn(table);
             } else {
                 PEER_CLOSE_MANAGER_TABLE_LOG("MembershipManager::WalkRibIn");
                 WalkRibIn(table);
@@ -516,6 +542,21 @@ void PeerCloseManager::MembershipRequest(Event *evnet) {
     }
 }
 
+// Walk the RibIn to delete the paths that are still stale. Skip the walk if
+// the peer has no stale paths left in the family, and complete the request
+// right away as the membership manager would have after the walk.
+void PeerCloseManager::SweepRibIn(BgpTable *table) {
+    if (!HasStalePaths(table->family())) {
+        PEER_CLOSE_MANAGER_TABLE_LOG("Skip sweep, no stale paths");
+        stats_.sweep_walks_skipped++;
+        MembershipRequestCallback();
+        return;
+    }
+    PEER_CLOSE_MANAGER_TABLE_LOG("MembershipManager::WalkRibIn");
+    stats_.sweep_walks++;
+    WalkRibIn(table);
+}
+
 void PeerCloseManager::MembershipRequestCallback() {
     EnqueueEvent(new Event(MEMBERSHIP_REQUEST_COMPLETE_CALLBACK));
 }
@@ -540,6 +581,9 @@ bool PeerCloseManager::MembershipRequestCallback(Event *event) {
 
     if (state_ == DELETE) {
         MOVE_TO_STATE(NONE);
+
+        // All paths of the peer are gone.
+        ResetStalePathCount();
         peer_close_->Delete();
         gr_elapsed_ = 0;
         llgr_elapsed_ = 0;
@@ -621,6 +665,24 @@ void PeerCloseManager::FillRouteCloseInfo(PeerCloseInfo *close_info) const {
         close_info->set_route_stats(route_stats);
 }
 
+void PeerCloseManager::FillStateTimeInfo(PeerCloseInfo *close_info) const {
+    std::map<std::string, PeerCloseStateTime> state_times;
+
+    for (int i = BEGIN_STATE; i <= END_STATE; i++) {
+        const Stats::StateTime &state_time = stats_.state_times[i];
+        if (!state_time.total_usecs)
+            continue;
+        PeerCloseStateTime state_time_info;
+        state_time_info.set_last_usecs(state_time.last_usecs);
+        state_time_info.set_total_usecs(state_time.total_usecs);
+        state_time_info.set_max_usecs(state_time.max_usecs);
+        state_times[GetStateName(static_cast<State>(i))] = state_time_info;
+    }
+
+    if (!state_times.empty())
+        close_info->set_state_times(state_times);
+}
+
 BgpNeighborResp *PeerCloseManager::FillCloseInfo(BgpNeighborResp *resp) const {
     PeerCloseInfo peer_close_info;
     peer_close_info.set_state(GetStateName(state_));
@@ -637,7 +699,10 @@ BgpNeighborResp *PeerCloseManager::FillCloseInfo(BgpNeighborResp *resp) const {
     peer_close_info.set_sweep(stats_.sweep);
     peer_close_info.set_gr_timer(stats_.gr_timer);
     peer_close_info.set_llgr_timer(stats_.llgr_timer);
+    peer_close_info.set_sweep_walks(stats_.sweep_walks);
+    peer_close_info.set_sweep_walks_skipped(stats_.sweep_walks_skipped);
     FillRouteCloseInfo(&peer_close_info);
+    FillStateTimeInfo(&peer_close_info);
 
     resp->set_peer_close_info(peer_close_info);
 
@@ -646,6 +711,17 @@ BgpNeighborResp *PeerCloseManager::FillCloseInfo(BgpNeighborResp *resp) const {
 
 void PeerCloseManager::UpdateRouteStats(Address::Family family,
         const BgpPath *old_path, uint32_t path_flags) const {
+    // Track paths entering and leaving the stale state in all states since
+    // stale paths can also be added outside of the close process.
+    bool old_stale =
+        old_path && (old_path->IsStale() || old_path->IsLlgrStale());
+    bool new_stale = path_flags & (BgpPath::Stale | BgpPath::LlgrStale);
+    if (!old_stale && new_stale) {
+        stale_path_count_[family]++;
+    } else if (old_stale && !new_stale) {
+        stale_path_count_[family]--;
+    }
+
     if (state_ == NONE)
         return;
 
@@ -677,6 +753,7 @@ bool PeerCloseManager::MembershipPathCallback(DBTablePartBase *root,
             // Stale paths must be deleted.
             if (!path->IsStale() && !path->IsLlgrStale())
                 return false;
+            stale_path_count_[table->family()]--;
             if (path->IsStale()) {
                 path->ResetStale();
                 table->UpdateStalePathCount(-1);
@@ -729,6 +806,8 @@ bool PeerCloseManager::MembershipPathCallback(DBTablePartBase *root,
             if (path->GetAttr()->community() &&
                 path->GetAttr()->community()->ContainsValue(
                     CommunityType::NoLlgr)) {
+                if (path->IsStale() || path->IsLlgrStale())
+                    stale_path_count_[table->family()]--;
                 oper = DBRequest::DB_ENTRY_DELETE;
                 attrs = NULL;
                 stats_.route_stats[table->family()].deleted++;
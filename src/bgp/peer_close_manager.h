@@ -36,6 +36,13 @@ class PeerCloseInfo;
 // Once RibIns and RibOuts are processed, notification callback function is
 // invoked to signal the completion of close process
 //
+// The number of stale and llgr stale paths of the peer is tracked per family
+// as paths are marked, refreshed and swept. The count may be higher than the
+// actual number of stale paths (e.g. when the peer withdraws a stale path)
+// but never lower, so the sweep walk of a RibIn is skipped when there are no
+// stale paths left for its family. This is typically the case when the peer
+// comes back and re-advertises all of its routes before the GR timer fires.
+//
 class PeerCloseManager {
 public:
     PeerCloseManager(IPeerClose *peer_close,
@@ -135,9 +142,19 @@ private:
             llgr_stale(0),
             sweep(0),
             gr_timer(0),
-            llgr_timer(0) {
+            llgr_timer(0),
+            sweep_walks(0),
+            sweep_walks_skipped(0) {
         }
 
+        // Time spent in a state, including the membership walks.
+        struct StateTime {
+            StateTime() : last_usecs(0), total_usecs(0), max_usecs(0) { }
+            uint64_t last_usecs;
+            uint64_t total_usecs;
+            uint64_t max_usecs;
+        };
+
         struct RouteStats {
             RouteStats() { reset(); }
             bool IsSet() const {
@@ -185,7 +202,10 @@ private:
         uint64_t sweep;
         uint64_t gr_timer;
         uint64_t llgr_timer;
+        uint64_t sweep_walks;
+        uint64_t sweep_walks_skipped;
         mutable RouteStats route_stats[Address::NUM_FAMILIES];
+        StateTime state_times[END_STATE + 1];
     };
 
     State state() const { return state_; }
@@ -198,9 +218,16 @@ private:
     void ProcessClosure();
     void CloseComplete();
     void TriggerSweepStateActions();
+    void UpdateStateTime();
+    bool HasStalePaths(Address::Family family) const {
+        return stale_path_count_[family] > 0;
+    }
+    void ResetStalePathCount();
+    void SweepRibIn(BgpTable *table);
     std::string GetStateName(State state) const;
     std::string GetMembershipStateName(MembershipState state) const;
     void FillRouteCloseInfo(PeerCloseInfo *close_info) const;
+    void FillStateTimeInfo(PeerCloseInfo *close_info) const;
     void CloseInternal();
     void MembershipRequest(Event *event);
     bool MembershipRequestCallback(Event *event);
@@ -238,6 +265,8 @@ private:
     IPeerClose::Families families_;
     Stats stats_;
     std::atomic<int> membership_req_pending_;
+    uint64_t state_start_usecs_;
+    mutable std::atomic<int64_t> stale_path_count_[Address::NUM_FAMILIES];
 };
 
 #endif  // SRC_BGP_PEER_CLOSE_MANAGER_H_
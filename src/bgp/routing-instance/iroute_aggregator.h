@@ -30,6 +30,8 @@ public:
 private:
     friend class RouteAggregatorTest;
 
+    virtual uint64_t GetContributingRouteCount() const = 0;
+
     // Enable/Disable task triggers
     virtual void DisableRouteAggregateUpdate() = 0;
     virtual void EnableRouteAggregateUpdate() = 0;
@@ -4,6 +4,8 @@
 
 #include "bgp/routing-instance/path_resolver.h"
 
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 
 #include "base/lifetime.h"
@@ -11,6 +13,7 @@
 #include "base/task.h"
 #include "base/task_annotations.h"
 #include "base/task_trigger.h"
+#include "base/time_util.h"
 #include "bgp/bgp_log.h"
 #include "bgp/bgp_peer_types.h"
 #include "bgp/bgp_server.h"
@@ -135,6 +138,8 @@ PathResolver::PathResolver(BgpTable *table)
           boost::bind(&PathResolver::ProcessResolverNexthopUpdateList, this),
           TaskScheduler::GetInstance()->GetTaskId("bgp::ResolverNexthop"),
           0)),
+      nexthop_update_count_(0),
+      nexthop_update_coalesced_count_(0),
       deleter_(new DeleteActor(this)),
       table_delete_ref_(this, table->deleter()) {
     for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id) {
@@ -225,9 +230,16 @@ void PathResolver::RegisterUnregisterResolverNexthop(
 // Add a ResolverNexthop to the update list and start the Task to process the
 // list.
 //
+// The time of the first update is retained if the ResolverNexthop is already
+// on the list.
+//
 void PathResolver::UpdateResolverNexthop(ResolverNexthop *rnexthop) {
     std::scoped_lock lock(mutex_);
-    nexthop_update_list_.insert(rnexthop);
+    nexthop_update_count_++;
+    if (!nexthop_update_list_.insert(
+        make_pair(rnexthop, ClockMonotonicUsec())).second) {
+        nexthop_update_coalesced_count_++;
+    }
     nexthop_update_trigger_->Set();
 }
 
@@ -291,7 +303,7 @@ ResolverNexthop *PathResolver::LocateResolverNexthop(IpAddress address,
 }
 
 //
-// Remove the ResolverNexthop from the map and the update list.
+// Remove the ResolverNexthop from the map and the update lists.
 // Called when ResolverPath is being unregistered from BgpConditionListener
 // as part of register/unregister list processing.
 //
@@ -311,6 +323,9 @@ void PathResolver::RemoveResolverNexthop(ResolverNexthop *rnexthop) {
     assert(loc != nexthop_map_.end());
     nexthop_map_.erase(loc);
     nexthop_update_list_.erase(rnexthop);
+    for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id) {
+        partitions_[part_id]->RemoveResolverNexthop(rnexthop);
+    }
 }
 
 //
@@ -419,11 +434,11 @@ bool PathResolver::ProcessResolverNexthopRegUnregList() {
 bool PathResolver::ProcessResolverNexthopUpdateList() {
     CHECK_CONCURRENCY("bgp::ResolverNexthop");
 
-    for (ResolverNexthopList::iterator it = nexthop_update_list_.begin();
+    for (ResolverNexthopUpdateMap::iterator it = nexthop_update_list_.begin();
          it != nexthop_update_list_.end(); ++it) {
-        ResolverNexthop *rnexthop = *it;
+        ResolverNexthop *rnexthop = it->first;
         assert(!rnexthop->deleted());
-        rnexthop->TriggerAllResolverPaths();
+        rnexthop->TriggerAllResolverPaths(it->second);
     }
     nexthop_update_list_.clear();
     return true;
@@ -602,11 +617,20 @@ void PathResolver::FillShowInfo(ShowPathResolver *spr, bool summary) const {
 
     size_t path_count = 0;
     size_t modified_path_count = 0;
+    uint64_t path_update_count = 0;
+    uint64_t nexthop_resolution_count = 0;
+    uint64_t resolution_latency_usecs = 0;
+    uint64_t resolution_latency_max_usecs = 0;
     vector<ShowPathResolverPath> sprp_list;
     for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id) {
         const PathResolverPartition *partition = partitions_[part_id];
         path_count += partition->rpath_map_.size();
-        modified_path_count += partition->rpath_update_list_.size();
+        modified_path_count += partition->GetModifiedPathCount();
+        path_update_count += partition->path_update_count_;
+        nexthop_resolution_count += partition->nexthop_resolution_count_;
+        resolution_latency_usecs += partition->resolution_latency_usecs_;
+        resolution_latency_max_usecs = std::max(resolution_latency_max_usecs,
+            partition->resolution_latency_max_usecs_);
         if (summary)
             continue;
         for (PathResolverPartition::PathToResolverPathMap::const_iterator it =
@@ -625,6 +649,13 @@ void PathResolver::FillShowInfo(ShowPathResolver *spr, bool summary) const {
     spr->set_nexthop_count(nexthop_map_.size());
     spr->set_modified_nexthop_count(nexthop_reg_unreg_list_.size() +
         nexthop_delete_list_.size() + nexthop_update_list_.size());
+    spr->set_nexthop_updates(nexthop_update_count_);
+    spr->set_nexthop_updates_coalesced(nexthop_update_coalesced_count_);
+    spr->set_path_updates(path_update_count);
+    spr->set_nexthop_resolutions(nexthop_resolution_count);
+    spr->set_resolution_latency_avg_usecs(nexthop_resolution_count ?
+        resolution_latency_usecs / nexthop_resolution_count : 0);
+    spr->set_resolution_latency_max_usecs(resolution_latency_max_usecs);
 
     if (summary)
         return;
@@ -663,7 +694,11 @@ PathResolverPartition::PathResolverPartition(int part_id,
           boost::bind(&PathResolverPartition::ProcessResolverPathUpdateList,
               this),
           TaskScheduler::GetInstance()->GetTaskId("bgp::ResolverPath"),
-          part_id)) {
+          part_id)),
+      path_update_count_(0),
+      nexthop_resolution_count_(0),
+      resolution_latency_usecs_(0),
+      resolution_latency_max_usecs_(0) {
 }
 
 //
@@ -673,6 +708,7 @@ PathResolverPartition::PathResolverPartition(int part_id,
 //
 PathResolverPartition::~PathResolverPartition() {
     assert(rpath_update_list_.empty());
+    assert(rnexthop_update_list_.empty());
     rpath_update_trigger_->Reset();
 }
 
@@ -743,6 +779,32 @@ void PathResolverPartition::DeferPathResolution(ResolverPath *rpath) {
     rpath_update_trigger_->Set();
 }
 
+//
+// Add a ResolverNexthop to the nexthop update list and start Task to process
+// the list. All ResolverPaths in the partition that depend on the nexthop get
+// re-evaluated when the list is processed.
+//
+// The time of the first update is retained if the ResolverNexthop is already
+// on the list.
+//
+void PathResolverPartition::TriggerNexthopResolution(
+    ResolverNexthop *rnexthop, uint64_t update_at) {
+    CHECK_CONCURRENCY("bgp::ResolverNexthop");
+
+    rnexthop_update_list_.insert(make_pair(rnexthop, update_at));
+    rpath_update_trigger_->Set();
+}
+
+//
+// Remove a ResolverNexthop from the nexthop update list.
+// Called when the ResolverNexthop is removed from the PathResolver.
+//
+void PathResolverPartition::RemoveResolverNexthop(ResolverNexthop *rnexthop) {
+    CHECK_CONCURRENCY("bgp::Config");
+
+    rnexthop_update_list_.erase(rnexthop);
+}
+
 //
 // Get the BgpTable partition corresponding to this PathResolverPartition.
 //
@@ -788,21 +850,80 @@ ResolverPath *PathResolverPartition::RemoveResolverPath(const BgpPath *path) {
 }
 
 //
-// Handle processing of all ResolverPaths on the update list.
+// Handle processing of all ResolverPaths on the update list and of all the
+// ResolverPaths that depend on ResolverNexthops on the nexthop update list.
+//
+// ResolverPaths on the update list whose ResolverNexthop is also on the
+// nexthop update list are skipped since they get re-evaluated as part of
+// the ResolverNexthop. Note that the ResolverPath stays in the dependent
+// list of the ResolverNexthop till it's deleted, even if resolution for it
+// has been stopped.
+//
+// ResolverPaths that are deferred get added to the update list again and
+// are handled when the list is processed the next time.
 //
 bool PathResolverPartition::ProcessResolverPathUpdateList() {
     CHECK_CONCURRENCY("bgp::ResolverPath");
 
     ResolverPathList update_list;
     rpath_update_list_.swap(update_list);
+    ResolverNexthopUpdateMap nexthop_update_list;
+    rnexthop_update_list_.swap(nexthop_update_list);
+
     for (ResolverPathList::iterator it = update_list.begin();
          it != update_list.end(); ++it) {
         ResolverPath *rpath = *it;
+        ResolverNexthop *rnexthop =
+            const_cast<ResolverNexthop *>(rpath->rnexthop());
+        if (nexthop_update_list.find(rnexthop) != nexthop_update_list.end())
+            continue;
+        path_update_count_++;
         if (rpath->UpdateResolvedPaths())
             delete rpath;
     }
 
-    return rpath_update_list_.empty();
+    for (ResolverNexthopUpdateMap::iterator it = nexthop_update_list.begin();
+         it != nexthop_update_list.end(); ++it) {
+        ResolverNexthop *rnexthop = it->first;
+        ResolverNexthop::ResolverPathList *rpath_list =
+            &rnexthop->rpath_lists_[part_id_];
+        for (ResolverNexthop::ResolverPathList::iterator rpath_it =
+             rpath_list->begin(); rpath_it != rpath_list->end(); ) {
+            ResolverPath *rpath = *rpath_it++;
+            path_update_count_++;
+            if (rpath->UpdateResolvedPaths())
+                delete rpath;
+        }
+
+        uint64_t latency = ClockMonotonicUsec() - it->second;
+        nexthop_resolution_count_++;
+        resolution_latency_usecs_ += latency;
+        if (latency > resolution_latency_max_usecs_)
+            resolution_latency_max_usecs_ = latency;
+    }
+
+    return (rpath_update_list_.empty() && rnexthop_update_list_.empty());
+}
+
+//
+// Get the number of ResolverPaths that are pending re-evaluation, either
+// directly or via a ResolverNexthop on the nexthop update list.
+//
+size_t PathResolverPartition::GetModifiedPathCount() const {
+    size_t count = 0;
+    for (ResolverNexthopUpdateMap::const_iterator it =
+         rnexthop_update_list_.begin(); it != rnexthop_update_list_.end();
+         ++it) {
+        count += it->first->rpath_lists_[part_id_].size();
+    }
+    for (ResolverPathList::const_iterator it = rpath_update_list_.begin();
+         it != rpath_update_list_.end(); ++it) {
+        ResolverNexthop *rnexthop =
+            const_cast<ResolverNexthop *>((*it)->rnexthop());
+        if (rnexthop_update_list_.find(rnexthop) == rnexthop_update_list_.end())
+            count++;
+    }
+    return count;
 }
 
 //
@@ -842,7 +963,7 @@ void PathResolverPartition::ResumeResolverPathUpdateProcessing() {
 // For testing only.
 //
 size_t PathResolverPartition::GetResolverPathUpdateListSize() const {
-    return rpath_update_list_.size();
+    return GetModifiedPathCount();
 }
 
 //
@@ -1316,18 +1437,18 @@ ResolverRouteState *ResolverNexthop::GetResolverRouteState() {
 
 //
 // Trigger update of resolved BgpPaths for all ResolverPaths that depend on
-// the ResolverNexthop. Actual update of the resolved BgpPaths happens when
-// the PathResolverPartitions process their update lists.
+// the ResolverNexthop. The ResolverNexthop is queued to each partition with
+// dependent ResolverPaths. Actual update of the resolved BgpPaths happens
+// when the PathResolverPartitions process their update lists.
 //
-void ResolverNexthop::TriggerAllResolverPaths() const {
+void ResolverNexthop::TriggerAllResolverPaths(uint64_t update_at) {
     CHECK_CONCURRENCY("bgp::ResolverNexthop");
 
     for (int part_id = 0; part_id < DB::PartitionCount(); ++part_id) {
-        for (ResolverPathList::iterator it = rpath_lists_[part_id].begin();
-             it != rpath_lists_[part_id].end(); ++it) {
-            ResolverPath *rpath = *it;
-            resolver_->GetPartition(part_id)->TriggerPathResolution(rpath);
-        }
+        if (rpath_lists_[part_id].empty())
+            continue;
+        resolver_->GetPartition(part_id)->TriggerNexthopResolution(
+            this, update_at);
     }
 }
 
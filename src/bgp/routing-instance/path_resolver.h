@@ -73,8 +73,12 @@ class TaskTrigger;
 // after the list is processed again.
 //
 // The update list is processed in the context of bgp::ResolverNexthop Task.
-// When an entry on this list is processed all it's dependent ResolverPaths
-// are queued for re-evaluation in the PathResolverPartition.
+// When an entry on this list is processed, it's queued for re-evaluation in
+// each PathResolverPartition that has dependent ResolverPaths. Expansion to
+// the individual ResolverPaths happens in the PathResolverPartitions so that
+// it's done in parallel and only once per batch of updates. The update list
+// also records when the ResolverNexthop was first queued so that the latency
+// of re-evaluation of its dependent ResolverPaths can be tracked.
 //
 // Concurrency Notes:
 //
@@ -126,6 +130,7 @@ private:
     typedef std::pair<IpAddress, BgpTable *> ResolverNexthopKey;
     typedef std::map<ResolverNexthopKey, ResolverNexthop *> ResolverNexthopMap;
     typedef std::set<ResolverNexthop *> ResolverNexthopList;
+    typedef std::map<ResolverNexthop *, uint64_t> ResolverNexthopUpdateMap;
 
     PathResolverPartition *GetPartition(int part_id);
     PathResolverPartition *GetPartition(int part_id) const;
@@ -166,8 +171,10 @@ private:
     ResolverNexthopMap nexthop_map_;
     ResolverNexthopList nexthop_reg_unreg_list_;
     boost::scoped_ptr<TaskTrigger> nexthop_reg_unreg_trigger_;
-    ResolverNexthopList nexthop_update_list_;
+    ResolverNexthopUpdateMap nexthop_update_list_;
     boost::scoped_ptr<TaskTrigger> nexthop_update_trigger_;
+    uint64_t nexthop_update_count_;
+    uint64_t nexthop_update_coalesced_count_;
     ResolverNexthopList nexthop_delete_list_;
     std::vector<PathResolverPartition *> partitions_;
 
@@ -187,7 +194,16 @@ private:
 // ResolverPath class. The list is processed in context of bgp::ResolverPath
 // Task with the partition index as the Task instance id. This allows all the
 // PathResolverPartitions to work concurrently.
-
+//
+// The nexthop update list contains ResolverNexthops whose BgpRoute has been
+// updated, along with the time at which the update was first seen. Entries
+// are added from the bgp::ResolverNexthop Task. When the list is processed,
+// all the ResolverPaths in the partition that depend on the ResolverNexthop
+// are re-evaluated. ResolverPaths that are on the update list and depend on
+// a ResolverNexthop in the nexthop update list are evaluated only once. This
+// avoids building a list of all dependent ResolverPaths every time the route
+// for a ResolverNexthop with a large number of dependents changes.
+//
 // Mutual exclusion of db::DBTable and bgp::ResolverPath Tasks ensures that
 // it's safe to add/delete/update resolved BgpPaths from the bgp::ResolverPath
 // Task. It also ensures that it's safe to access the BgpPaths of the nexthop
@@ -206,6 +222,8 @@ public:
 
     void TriggerPathResolution(ResolverPath *rpath);
     void DeferPathResolution(ResolverPath *rpath);
+    void TriggerNexthopResolution(ResolverNexthop *rnexthop,
+        uint64_t update_at);
 
     int part_id() const { return part_id_; }
     DBTableBase::ListenerId listener_id() const {
@@ -220,12 +238,15 @@ private:
 
     typedef std::map<const BgpPath *, ResolverPath *> PathToResolverPathMap;
     typedef std::set<ResolverPath *> ResolverPathList;
+    typedef std::map<ResolverNexthop *, uint64_t> ResolverNexthopUpdateMap;
 
     ResolverPath *CreateResolverPath(const BgpPath *path, BgpRoute *route,
         ResolverNexthop *rnexthop);
     ResolverPath *FindResolverPath(const BgpPath *path);
     ResolverPath *RemoveResolverPath(const BgpPath *path);
+    void RemoveResolverNexthop(ResolverNexthop *rnexthop);
     bool ProcessResolverPathUpdateList();
+    size_t GetModifiedPathCount() const;
 
     void DisableResolverPathUpdateProcessing();
     void EnableResolverPathUpdateProcessing();
@@ -237,7 +258,12 @@ private:
     PathResolver *resolver_;
     PathToResolverPathMap rpath_map_;
     ResolverPathList rpath_update_list_;
+    ResolverNexthopUpdateMap rnexthop_update_list_;
     boost::scoped_ptr<TaskTrigger> rpath_update_trigger_;
+    uint64_t path_update_count_;
+    uint64_t nexthop_resolution_count_;
+    uint64_t resolution_latency_usecs_;
+    uint64_t resolution_latency_max_usecs_;
 
     DISALLOW_COPY_AND_ASSIGN(PathResolverPartition);
 };
@@ -357,11 +383,14 @@ private:
 //
 // A ResolverNexthop maintains a vector of ResolverPathList, one entry per
 // partition. Each ResolverPathList is a set of ResolverPaths that use the
-// ResolverNexthop in question. When there's a change to the BgpRoute for
+// ResolverNexthop in question i.e. it's the reverse index from the nexthop
+// to the dependent ResolverPaths. When there's a change to the BgpRoute for
 // the IP address being tracked, the ResolverNexthop is added to the update
 // list in the PathResolver. The PathResolver processes the entries in this
 // list in the context of the bgp::ResolverNexthop Task. The action is to
-// trigger re-evaluation of all ResolverPaths that use the ResolverNexthop.
+// trigger re-evaluation of all ResolverPaths that use the ResolverNexthop
+// by adding it to the nexthop update list of every PathResolverPartition
+// with a non-empty ResolverPathList.
 //
 // When the last ResolverPath in a partition using a ResolverNexthop gets
 // removed, the ResolverNexthop is added to the registration/unregistration
@@ -401,7 +430,7 @@ public:
     void RemoveResolverPath(int part_id, ResolverPath *rpath);
     ResolverRouteState *GetResolverRouteState();
 
-    void TriggerAllResolverPaths() const;
+    void TriggerAllResolverPaths(uint64_t update_at);
 
     void ManagedDelete() { }
 
@@ -424,6 +453,8 @@ protected:
     ResolverRouteSet routes_;
 
 private:
+    friend class PathResolverPartition;
+
     typedef std::set<ResolverPath *> ResolverPathList;
 
     PathResolver *resolver_;
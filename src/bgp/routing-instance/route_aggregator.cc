@@ -174,12 +174,20 @@ public:
     }
 
     bool HasContributingRoutes() const {
-        BOOST_FOREACH(RouteList per_part_contributor, contribute_route_list()) {
-            if (!per_part_contributor.empty()) {
-                return true;
-            }
-        }
-        return false;
+        return (contributor_count_ != 0);
+    }
+
+    uint32_t contributor_count() const {
+        return contributor_count_;
+    }
+
+    // Returns false if the aggregate is already queued for evaluation.
+    bool SetEvaluatePending() {
+        return !evaluate_pending_.exchange(true);
+    }
+
+    void ClearEvaluatePending() {
+        evaluate_pending_ = false;
     }
 
     bool IsContributingRoute(BgpRoute *route) const {
@@ -207,13 +215,14 @@ public:
         return state;
     }
 
+    // Returns true if this is the first contributing route.
     bool AddContributingRoute(BgpRoute *route) {
         uint32_t part_id = route->get_table_partition()->index();
         contributors_[part_id].insert(route);
         RouteAggregatorState *state = LocateRouteState(route);
         state->set_contributing_info(AggregateRoutePtr(this));
         NotifyContributingRoute(route);
-        return (contributors_[part_id].size() == 1);
+        return (contributor_count_.fetch_add(1) == 0);
     }
 
     void ClearRouteState(BgpRoute *route, RouteAggregatorState *state) {
@@ -223,6 +232,7 @@ public:
         }
     }
 
+    // Returns true if this was the last contributing route.
     bool RemoveContributingRoute(BgpRoute *route) {
         uint32_t part_id = route->get_table_partition()->index();
         int num_deleted = contributors_[part_id].erase(route);
@@ -235,7 +245,9 @@ public:
         } else {
             assert(num_deleted != 1);
         }
-        return contributors_[part_id].empty();
+        if (num_deleted == 0)
+            return false;
+        return (contributor_count_.fetch_sub(1) == 1);
     }
 
     void FillShowInfo(AggregateRouteInfo *info, bool summary) const;
@@ -247,6 +259,8 @@ private:
     IpAddress nexthop_;
     BgpRoute *aggregate_route_;
     ContributingRouteList contributors_;
+    std::atomic<uint32_t> contributor_count_;
+    std::atomic<bool> evaluate_pending_;
 
     DISALLOW_COPY_AND_ASSIGN(AggregateRoute);
 };
@@ -260,7 +274,9 @@ AggregateRoute<T>::AggregateRoute(RoutingInstance *rtinstance,
       aggregate_route_prefix_(aggregate_route),
       nexthop_(nexthop),
       aggregate_route_(NULL),
-      contributors_(ContributingRouteList(DB::PartitionCount())) {
+      contributors_(ContributingRouteList(DB::PartitionCount())),
+      contributor_count_(0),
+      evaluate_pending_(false) {
 }
 
 // Compare config and return whether cfg has updated
@@ -538,6 +554,7 @@ void AggregateRoute<T>::FillShowInfo(AggregateRouteInfo *info,
     }
 
     info->set_nexthop(nexthop_.to_string());
+    info->set_contributor_count(contributor_count_);
 
     if (summary)
         return;
@@ -586,6 +603,9 @@ RouteAggregator<T>::RouteAggregator(RoutingInstance *rtinstance)
     unregister_list_trigger_(new TaskTrigger(
         boost::bind(&RouteAggregator::ProcessUnregisterList, this),
         TaskScheduler::GetInstance()->GetTaskId("bgp::Config"), 0)),
+    evaluate_request_count_(0),
+    evaluate_coalesced_count_(0),
+    evaluate_count_(0),
     deleter_(new DeleteActor(this)),
     instance_delete_ref_(this, rtinstance->deleter()) {
 }
@@ -701,8 +721,18 @@ void RouteAggregator<T>::RetryDelete() {
     deleter_->RetryDelete();
 }
 
+//
+// Queue the aggregate for evaluation unless it is already queued. Called from
+// Match() in db::DBTable task of every partition.
+//
 template <typename T>
 void RouteAggregator<T>::EvaluateAggregateRoute(AggregateRoutePtr entry) {
+    evaluate_request_count_++;
+    AggregateRouteT *aggregate = static_cast<AggregateRouteT *>(entry.get());
+    if (!aggregate->SetEvaluatePending()) {
+        evaluate_coalesced_count_++;
+        return;
+    }
     std::scoped_lock lock(mutex_);
     update_aggregate_list_.insert(entry);
     update_list_trigger_->Set();
@@ -755,6 +785,9 @@ bool RouteAggregator<T>::FillAggregateRouteInfo(AggregateRouteEntriesInfo *info,
         aggregate_route_list.push_back(aggregate_info);
     }
     info->set_aggregate_route_list(aggregate_route_list);
+    info->set_evaluate_requests(evaluate_request_count_);
+    info->set_evaluate_requests_coalesced(evaluate_coalesced_count_);
+    info->set_evaluations(evaluate_count_);
     return true;
 }
 
@@ -877,6 +910,8 @@ bool RouteAggregator<T>::ProcessUpdateList() {
          it = update_aggregate_list_.begin();
          it != update_aggregate_list_.end(); ++it) {
         AggregateRouteT *aggregate = static_cast<AggregateRouteT *>(it->get());
+        aggregate->ClearEvaluatePending();
+        evaluate_count_++;
         if (aggregate->aggregate_route()) {
             if (!aggregate->HasContributingRoutes())
                 aggregate->RemoveAggregateRoute();
@@ -892,6 +927,18 @@ bool RouteAggregator<T>::ProcessUpdateList() {
     return true;
 }
 
+template <typename T>
+uint64_t RouteAggregator<T>::GetContributingRouteCount() const {
+    uint64_t count = 0;
+    for (typename AggregateRouteMap::const_iterator it =
+         aggregate_route_map_.begin(); it != aggregate_route_map_.end(); ++it) {
+        const AggregateRouteT *aggregate =
+            static_cast<const AggregateRouteT *>(it->second.get());
+        count += aggregate->contributor_count();
+    }
+    return count;
+}
+
 // Need this to store the aggregate info in aggregated route as DBState
 template <typename T>
 bool RouteAggregator<T>::RouteListener(DBTablePartBase *root,
@@ -5,6 +5,7 @@
 #ifndef SRC_BGP_ROUTING_INSTANCE_ROUTE_AGGREGATOR_H_
 #define SRC_BGP_ROUTING_INSTANCE_ROUTE_AGGREGATOR_H_
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <mutex>
@@ -76,6 +77,14 @@ typedef ConditionMatchPtr AggregateRoutePtr;
 // in update_aggregate_list_ and trigger update_list_trigger_
 // task trigger to process the aggregate route.
 //
+// AggregateRoute also keeps a count of contributing routes across all
+// partitions. The count is updated in the Match() context and the aggregate
+// route is evaluated only when the count goes from zero to non-zero or back,
+// so adding or removing one of many contributing routes is constant work.
+// An AggregateRoute that is already queued for evaluation is not queued
+// again, which coalesces evaluations requested from all partitions till
+// update_list_trigger_ runs.
+//
 // In task trigger method for update_list_trigger_ is
 // responsible for creating and deleting the Aggregate route.
 // Aggregate route is added when first contributing route is added to
@@ -227,6 +236,8 @@ private:
 
     RoutingInstance *routing_instance() { return rtinstance_; }
 
+    virtual uint64_t GetContributingRouteCount() const;
+
     // Enable/Disable task triggers
     virtual void DisableRouteAggregateUpdate();
     virtual void EnableRouteAggregateUpdate();
@@ -245,6 +256,9 @@ private:
     std::mutex mutex_;
     AggregateRouteProcessList update_aggregate_list_;
     AggregateRouteProcessList unregister_aggregate_list_;
+    std::atomic<uint64_t> evaluate_request_count_;
+    std::atomic<uint64_t> evaluate_coalesced_count_;
+    uint64_t evaluate_count_;
     boost::scoped_ptr<DeleteActor> deleter_;
     LifetimeRef<RouteAggregator> instance_delete_ref_;
 
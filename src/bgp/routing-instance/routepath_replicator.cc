@@ -8,7 +8,6 @@
 
 #include <utility>
 
-#include "base/set_util.h"
 #include "base/task_annotations.h"
 #include "base/task_trigger.h"
 #include "bgp/bgp_config.h"
@@ -74,7 +73,8 @@ TableState::TableState(RoutePathReplicator *replicator, BgpTable *table)
       table_(table),
       listener_id_(DBTableBase::kInvalidId),
       deleter_(new DeleteActor(this)),
-      table_delete_ref_(this, table->deleter()) {
+      table_delete_ref_(this, table->deleter()),
+      replicated_path_count_(0) {
     assert(table->deleter() != NULL);
 }
 
@@ -134,17 +134,24 @@ RtReplicated::RtReplicated(RoutePathReplicator *replicator)
     : replicator_(replicator) {
 }
 
-void RtReplicated::AddRouteInfo(BgpTable *table, BgpRoute *rt,
-    ReplicatedRtPathList::const_iterator it) {
-    pair<ReplicatedRtPathList::iterator, bool> result;
-    result = replicate_list_.insert(*it);
-    assert(result.second);
-}
+//
+// Delete secondary paths that are not in the future list and replace the
+// list with the future list.
+//
+void RtReplicated::Update(BgpTable *table, BgpRoute *rt,
+    const SecondaryRouteInfoSet &future) {
+    SecondaryRouteInfoSet::const_iterator next = future.begin();
+    for (ReplicatedRtPathList::const_iterator it = replicate_list_.begin();
+         it != replicate_list_.end(); ++it) {
+        while (next != future.end() && *next < *it)
+            ++next;
+        if (next != future.end() && !(*it < *next))
+            continue;
+        replicator_->DeleteSecondaryPath(table, rt, *it);
+    }
 
-void RtReplicated::DeleteRouteInfo(BgpTable *table, BgpRoute *rt,
-    ReplicatedRtPathList::const_iterator it) {
-    replicator_->DeleteSecondaryPath(table, rt, *it);
-    replicate_list_.erase(it);
+    ReplicatedRtPathList replicate_list(future.begin(), future.end());
+    replicate_list_.swap(replicate_list);
 }
 
 //
@@ -248,7 +255,8 @@ RoutePathReplicator::RequestWalk(BgpTable *table) {
     if (!ts->walk_ref()) {
         DBTable::DBTableWalkRef walk_ref = table->AllocWalker(
           boost::bind(&RoutePathReplicator::RouteListener, this, ts, _1, _2),
-          boost::bind(&RoutePathReplicator::BulkReplicationDone, this, _2));
+          boost::bind(&RoutePathReplicator::BulkReplicationDone, this, _2),
+          DBTable::WALK_PRIORITY_LOW);
         table->WalkTable(walk_ref);
         ts->set_walk_ref(walk_ref);
     } else {
@@ -369,10 +377,11 @@ void RoutePathReplicator::Leave(BgpTable *table, const RouteTarget &rt,
 
 void RoutePathReplicator::DBStateSync(BgpTable *table, TableState *ts,
     BgpRoute *rt, RtReplicated *dbstate,
-    const RtReplicated::ReplicatedRtPathList *future) {
-    set_synchronize(dbstate->GetMutableList(), future,
-        boost::bind(&RtReplicated::AddRouteInfo, dbstate, table, rt, _1),
-        boost::bind(&RtReplicated::DeleteRouteInfo, dbstate, table, rt, _1));
+    const RtReplicated::SecondaryRouteInfoSet *future) {
+    int64_t count = dbstate->GetList().size();
+    dbstate->Update(table, rt, *future);
+    ts->UpdateReplicatedPathCount(
+        static_cast<int64_t>(dbstate->GetList().size()) - count);
 
     if (dbstate->GetList().empty()) {
         rt->ClearState(table, ts->listener_id());
@@ -472,7 +481,7 @@ bool RoutePathReplicator::RouteListener(TableState *ts,
     // Get the DBState.
     RtReplicated *dbstate =
         static_cast<RtReplicated *>(rt->GetState(table, id));
-    RtReplicated::ReplicatedRtPathList replicated_path_list;
+    RtReplicated::SecondaryRouteInfoSet replicated_path_list;
 
     //Flag to track if any change happenned to route in last 30 minutes
     bool route_unchanged = false;
@@ -530,7 +539,8 @@ bool RoutePathReplicator::RouteListener(TableState *ts,
     // Updating previousTables with the list of tables having the information
     // about the route.
     if (route_unchanged){
-        replicated_path_list = dbstate->GetList();
+        replicated_path_list.insert(dbstate->GetList().begin(),
+                                    dbstate->GetList().end());
         BOOST_FOREACH (RtReplicated::SecondaryRouteInfo path,
                        replicated_path_list){
             previousTables.insert(path.table_);
@@ -661,7 +671,7 @@ bool RoutePathReplicator::RouteListener(TableState *ts,
             // list.
             RtReplicated::SecondaryRouteInfo rtinfo(dest, path->GetPeer(),
                 path->GetPathId(), path->GetSource(), replicated_rt);
-            pair<RtReplicated::ReplicatedRtPathList::iterator, bool> result;
+            pair<RtReplicated::SecondaryRouteInfoSet::iterator, bool> result;
             result = replicated_path_list.insert(rtinfo);
             // Assert if the insertion to replication path list fails
 	    if (!route_unchanged)
@@ -688,6 +698,26 @@ const RtReplicated *RoutePathReplicator::GetReplicationState(
     return dbstate;
 }
 
+uint64_t RoutePathReplicator::GetReplicatedPathCount(
+    const BgpTable *table) const {
+    const TableState *ts = FindTableState(table);
+    if (!ts)
+        return 0;
+    return ts->replicated_path_count();
+}
+
+//
+// Approximate memory used by RtReplicated DBStates of the primary table.
+//
+uint64_t RoutePathReplicator::GetReplicationStateBytes(
+    const BgpTable *table) const {
+    const TableState *ts = FindTableState(table);
+    if (!ts)
+        return 0;
+    return ts->route_count() * sizeof(RtReplicated) +
+        ts->replicated_path_count() * sizeof(RtReplicated::SecondaryRouteInfo);
+}
+
 //
 // Return the list of secondary table names for the given primary path.
 //
@@ -8,6 +8,7 @@
 #include <boost/ptr_container/ptr_map.hpp>
 #include <sandesh/sandesh_trace.h>
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
@@ -43,7 +44,8 @@ class RouteTarget;
 // A TableState entry keeps track of all the export route targets for a VRF
 // by maintaining the GroupList. TableState cannot be deleted if GroupList
 // is non-empty and table has replicated routes. Replicated routes are tracked
-// using the DBStateCount of this listener
+// using the DBStateCount of this listener. The number of secondary paths for
+// the replicated routes is also kept for memory accounting.
 //
 class TableState {
 public:
@@ -72,6 +74,10 @@ public:
     }
 
     uint32_t route_count() const;
+    uint64_t replicated_path_count() const { return replicated_path_count_; }
+    void UpdateReplicatedPathCount(int64_t count) {
+        replicated_path_count_ += count;
+    }
 
     RoutePathReplicator *replicator() {
         return replicator_;
@@ -110,16 +116,23 @@ private:
     LifetimeRef<TableState> table_delete_ref_;
     GroupList list_;
     DBTable::DBTableWalkRef walk_ref_;
+    std::atomic<uint64_t> replicated_path_count_;
 
     DISALLOW_COPY_AND_ASSIGN(TableState);
 };
 
 //
 // This keeps track of the replication state for a route in the primary table.
-// The ReplicatedRtPathList is a set of SecondaryRouteInfo, where each element
-// represents a secondary path in a secondary table. An entry is added to the
-// set when a path is replicated to a secondary table removed when it's not
-// replicated anymore.
+// The ReplicatedRtPathList is a sorted list of SecondaryRouteInfo, where each
+// element represents a secondary path in a secondary table. An entry is added
+// to the list when a path is replicated to a secondary table removed when it's
+// not replicated anymore.
+//
+// There's a RtReplicated for every replicated route and an entry for every
+// secondary path, so the list is kept in a vector sized to fit rather than
+// in a std::set, which needs a separately allocated tree node per entry. The
+// new list is built as a SecondaryRouteInfoSet when the route is processed
+// and replaces the old one in Update().
 //
 // Changes to ReplicatedRtPathList may be triggered by changes in the primary
 // route, changes in the export targets of the primary table or changes in the
@@ -164,17 +177,15 @@ public:
         std::string ToString() const;
     };
 
-    typedef std::set<SecondaryRouteInfo> ReplicatedRtPathList;
+    typedef std::vector<SecondaryRouteInfo> ReplicatedRtPathList;
+    typedef std::set<SecondaryRouteInfo> SecondaryRouteInfoSet;
 
     explicit RtReplicated(RoutePathReplicator *replicator);
 
-    void AddRouteInfo(BgpTable *table, BgpRoute *rt,
-        ReplicatedRtPathList::const_iterator it);
-    void DeleteRouteInfo(BgpTable *table, BgpRoute *rt,
-        ReplicatedRtPathList::const_iterator it);
+    void Update(BgpTable *table, BgpRoute *rt,
+        const SecondaryRouteInfoSet &future);
 
     const ReplicatedRtPathList &GetList() const { return replicate_list_; }
-    ReplicatedRtPathList *GetMutableList() { return &replicate_list_; }
     std::vector<std::string> GetTableNameList(const BgpPath *path) const;
 
 private:
@@ -248,6 +259,10 @@ public:
     const RtReplicated *GetReplicationState(BgpTable *table,
                                             BgpRoute *rt) const;
 
+    // Memory accounting for the replication state of a primary table.
+    uint64_t GetReplicatedPathCount(const BgpTable *table) const;
+    uint64_t GetReplicationStateBytes(const BgpTable *table) const;
+
 private:
     friend class ReplicationTest;
     friend class BGPaaSRDTest;
@@ -277,7 +292,7 @@ private:
                              const RtReplicated::SecondaryRouteInfo &rtinfo);
     void DBStateSync(BgpTable *table, TableState *ts, BgpRoute *rt,
                      RtReplicated *dbstate,
-                     const RtReplicated::ReplicatedRtPathList *future);
+                     const RtReplicated::SecondaryRouteInfoSet *future);
 
     BgpServer *server() { return server_; }
     Address::Family family() const { return family_; }
@@ -17,6 +17,7 @@
 #include "db/db.h"
 
 using boost::assign::list_of;
+using std::make_pair;
 using std::pair;
 using std::string;
 using std::vector;
@@ -231,3 +232,67 @@ void RtGroup::FillShowSummaryInfo(ShowRtGroupInfo *info) const {
 void RtGroup::FillShowPeerInfo(ShowRtGroupInfo *info) const {
     FillShowInfoCommon(info, false, true);
 }
+
+RtGroupInterestIndex::RtGroupInterestIndex() : filter_(kFilterSize, 0) {
+}
+
+//
+// Mix all bits of the value so that RouteTargets that differ only in the
+// assigned number map to unrelated filter counters.
+//
+uint64_t RtGroupInterestIndex::Hash(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+void RtGroupInterestIndex::UpdateFilter(uint64_t value, bool add) {
+    uint64_t hash = Hash(value);
+    size_t idx1 = hash % kFilterSize;
+    size_t idx2 = (hash >> 32) % kFilterSize;
+    if (add) {
+        filter_[idx1]++;
+        filter_[idx2]++;
+    } else {
+        assert(filter_[idx1] != 0 && filter_[idx2] != 0);
+        filter_[idx1]--;
+        filter_[idx2]--;
+    }
+}
+
+//
+// Update the interested peers for the RouteTarget. The RouteTarget is
+// removed from the index if there are no interested peers.
+//
+void RtGroupInterestIndex::Update(const RouteTarget &rtarget,
+    const RtGroupInterestedPeerSet &peers) {
+    uint64_t value = rtarget.GetExtCommunityValue();
+    InterestMap::iterator loc = map_.find(value);
+    if (peers.empty()) {
+        if (loc == map_.end())
+            return;
+        map_.erase(loc);
+        UpdateFilter(value, false);
+    } else if (loc == map_.end()) {
+        map_.insert(make_pair(value, peers));
+        UpdateFilter(value, true);
+    } else {
+        loc->second = peers;
+    }
+}
+
+//
+// Find the interested peers for the RouteTarget with the given value.
+// Return NULL if there are none.
+//
+const RtGroupInterestedPeerSet *RtGroupInterestIndex::Find(
+    uint64_t value) const {
+    uint64_t hash = Hash(value);
+    if (!filter_[hash % kFilterSize] || !filter_[(hash >> 32) % kFilterSize])
+        return NULL;
+    InterestMap::const_iterator loc = map_.find(value);
+    return (loc != map_.end() ? &loc->second : NULL);
+}
@@ -8,6 +8,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/bitset.h"
@@ -25,6 +26,44 @@ class ShowRtGroupInfo;
 class RtGroupInterestedPeerSet : public BitSet {
 };
 
+//
+// This is an index of RouteTargets that have one or more interested peers.
+// It's used to compute the set of interested peers when exporting VPN routes
+// without having to look up a RtGroup for every RouteTarget of every route.
+//
+// The index is keyed by the 64 bit value of the RouteTarget and is backed by
+// a counting filter that has 2 counters per RouteTarget. A lookup for a value
+// for which either counter is 0 is rejected without consulting the map. This
+// makes lookups for RouteTargets without interested peers, which is the most
+// common case for routes with many RouteTargets, very cheap.
+//
+// The index is updated from the bgp::RTFilter task when the InterestedPeerList
+// of a RtGroup changes and is read from the db::DBTable task when exporting
+// routes. These tasks are mutually exclusive, so no locking is needed.
+//
+class RtGroupInterestIndex {
+public:
+    static const size_t kFilterSize = 8192;
+
+    RtGroupInterestIndex();
+
+    void Update(const RouteTarget &rtarget,
+        const RtGroupInterestedPeerSet &peers);
+    const RtGroupInterestedPeerSet *Find(uint64_t value) const;
+    size_t size() const { return map_.size(); }
+
+private:
+    typedef std::unordered_map<uint64_t, RtGroupInterestedPeerSet> InterestMap;
+
+    static uint64_t Hash(uint64_t value);
+    void UpdateFilter(uint64_t value, bool add);
+
+    std::vector<uint32_t> filter_;
+    InterestMap map_;
+
+    DISALLOW_COPY_AND_ASSIGN(RtGroupInterestIndex);
+};
+
 //
 // This class keeps track of state per RouteTarget.  It maintains three main
 // pieces of information.
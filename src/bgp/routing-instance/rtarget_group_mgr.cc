@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/map_util.h"
+#include "base/parse_object.h"
 #include "base/set_util.h"
 #include "base/task_annotations.h"
 #include "base/task_trigger.h"
@@ -85,6 +86,7 @@ void RTargetGroupMgr::RTargetPeerSync(BgpTable *table, RTargetRoute *rt,
             rt, _1),
         boost::bind(&RTargetState::DeleteInterestedPeer, dbstate, this, rtgroup,
             rt, _1));
+    interest_index_.Update(rtarget, rtgroup->GetInterestedPeers());
 
     if (dbstate->GetList()->empty()) {
         rt->ClearState(table, id);
@@ -409,20 +411,34 @@ void RTargetGroupMgr::RemoveRtGroup(const RouteTarget &rt) {
     remove_rtgroup_trigger_->Set();
 }
 
+//
+// Build the set of peers interested in any of the RouteTargets in the given
+// ExtCommunity. Peers interested in the null RouteTarget are always included.
+//
+void RTargetGroupMgr::GetInterestedPeers(const ExtCommunity *ext_community,
+             RtGroupInterestedPeerSet *peer_set) const {
+    static const uint64_t null_value =
+        RouteTarget::null_rtarget.GetExtCommunityValue();
+    const RtGroupInterestedPeerSet *null_peers =
+        interest_index_.Find(null_value);
+    if (null_peers)
+        *peer_set = *null_peers;
+    BOOST_FOREACH(const ExtCommunity::ExtCommunityValue &comm,
+                  ext_community->communities()) {
+        if (!ExtCommunity::is_route_target(comm))
+            continue;
+        const RtGroupInterestedPeerSet *peers =
+            interest_index_.Find(get_value(comm.data(), 8));
+        if (peers)
+            *peer_set |= *peers;
+    }
+}
+
 void RTargetGroupMgr::GetRibOutInterestedPeers(RibOut *ribout,
              const ExtCommunity *ext_community,
              const RibPeerSet &peerset, RibPeerSet *new_peerset) {
     RtGroupInterestedPeerSet peer_set;
-    RtGroup *null_rtgroup = GetRtGroup(RouteTarget::null_rtarget);
-    if (null_rtgroup) peer_set = null_rtgroup->GetInterestedPeers();
-    BOOST_FOREACH(const ExtCommunity::ExtCommunityValue &comm,
-                  ext_community->communities()) {
-        if (ExtCommunity::is_route_target(comm)) {
-            RtGroup *rtgroup = GetRtGroup(comm);
-            if (!rtgroup) continue;
-            peer_set |= rtgroup->GetInterestedPeers();
-        }
-    }
+    GetInterestedPeers(ext_community, &peer_set);
     RibOut::PeerIterator iter(ribout, peerset);
     while (iter.HasNext()) {
         int current_index = iter.index();
@@ -202,6 +202,11 @@ private:
 // with the bgp::RTFilter task, it is guaranteed that a RouteTargetTriggerList
 // does not get modified while it's being processed.
 //
+// The RtGroupInterestIndex mirrors the interested peers of all RtGroups that
+// have any. It's updated whenever a RTargetRoute is processed and is used by
+// GetRibOutInterestedPeers so that export of a VPN route does not need to
+// take the mutex and look up the RtGroup for each of it's RouteTargets.
+//
 class RTargetGroupMgr {
 public:
     typedef boost::ptr_map<const RouteTarget, RtGroup> RtGroupMap;
@@ -228,6 +233,8 @@ public:
     virtual void GetRibOutInterestedPeers(RibOut *ribout,
              const ExtCommunity *ext_community,
              const RibPeerSet &peerset, RibPeerSet *new_peerset);
+    void GetInterestedPeers(const ExtCommunity *ext_community,
+             RtGroupInterestedPeerSet *peer_set) const;
     void Enqueue(RtGroupMgrReq *req);
     void Initialize();
     void ManagedDelete();
@@ -238,6 +245,7 @@ public:
 private:
     friend class BgpXmppRTargetTest;
     friend class ReplicationTest;
+    friend class RtGroupInterestTest;
 
     typedef std::map<BgpTable *,
             RtGroupMgrTableState *> RtGroupMgrTableStateList;
@@ -287,6 +295,7 @@ private:
     RTargetRouteTriggerList rtarget_route_list_;
     std::vector<RouteTargetTriggerList> rtarget_trigger_lists_;
     RtGroupRemoveList rtgroup_remove_list_;
+    RtGroupInterestIndex interest_index_;
     LifetimeRef<RTargetGroupMgr> master_instance_delete_ref_;
 
     DISALLOW_COPY_AND_ASSIGN(RTargetGroupMgr);
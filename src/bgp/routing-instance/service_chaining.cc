@@ -11,6 +11,7 @@
 
 #include "base/task_annotations.h"
 #include "base/task_trigger.h"
+#include "base/time_util.h"
 #include "bgp/bgp_config.h"
 #include "bgp/bgp_log.h"
 #include "bgp/bgp_membership.h"
@@ -279,6 +280,13 @@ ServiceChain<T>::ServiceChain(ServiceChainMgrT *manager,
       aggregate_(false),
       sc_head_(head),
       retain_as_path_(retain_as_path),
+      route_update_pending_(false),
+      queue_length_(0),
+      request_count_(0),
+      request_latency_usecs_(0),
+      request_latency_max_usecs_(0),
+      route_update_count_(0),
+      route_update_coalesced_count_(0),
       src_table_delete_ref_(this, src_table()->deleter()),
       dest_table_delete_ref_(this, dest_table()->deleter()),
       connected_table_delete_ref_(this, connected_table()->deleter()) {
@@ -1109,6 +1117,45 @@ bool ServiceChain<T>::DeleteMoreSpecific(PrefixT aggregate,
     return it->second.empty();
 }
 
+template <typename T>
+void ServiceChain<T>::RequestDequeued(uint64_t latency_usecs) {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    queue_length_--;
+    request_count_++;
+    request_latency_usecs_ += latency_usecs;
+    if (latency_usecs > request_latency_max_usecs_)
+        request_latency_max_usecs_ = latency_usecs;
+}
+
+//
+// Note that an update of all routes is pending. Routes may have paths for
+// the old path ids of any of the coalesced updates, so keep all of them.
+//
+template <typename T>
+void ServiceChain<T>::SetRouteUpdatePending(
+    const ConnectedPathIdList &old_path_ids) {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    if (route_update_pending_) {
+        route_update_coalesced_count_++;
+        pending_old_path_ids_.insert(old_path_ids.begin(), old_path_ids.end());
+    } else {
+        route_update_pending_ = true;
+        pending_old_path_ids_ = old_path_ids;
+    }
+}
+
+template <typename T>
+typename ServiceChain<T>::ConnectedPathIdList
+ServiceChain<T>::ClearRouteUpdatePending() {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    assert(route_update_pending_);
+    route_update_pending_ = false;
+    route_update_count_++;
+    ConnectedPathIdList old_path_ids;
+    old_path_ids.swap(pending_old_path_ids_);
+    return old_path_ids;
+}
+
 template <typename T>
 void ServiceChain<T>::FillServiceChainInfo(ShowServicechainInfo *info) const {
     if (deleted()) {
@@ -1180,6 +1227,13 @@ void ServiceChain<T>::FillServiceChainInfo(ShowServicechainInfo *info) const {
     }
     info->set_ext_connecting_rt_info_list(ext_connecting_rt_info_list);
     info->set_aggregate_enable(aggregate_enable());
+    info->set_queue_length(queue_length_);
+    info->set_requests(request_count_);
+    info->set_request_latency_avg_usecs(
+        request_count_ ? request_latency_usecs_ / request_count_ : 0);
+    info->set_request_latency_max_usecs(request_latency_max_usecs_);
+    info->set_route_updates(route_update_count_);
+    info->set_route_updates_coalesced(route_update_coalesced_count_);
 }
 
 ServiceChainGroup::ServiceChainGroup(IServiceChainMgr *manager,
@@ -1268,6 +1322,17 @@ bool ServiceChainMgr<T>::RequestHandler(ServiceChainRequestT *req) {
     // Table where the aggregate route needs to be added
     aggregate_match = req->aggregate_match_;
 
+    if (info)
+        info->RequestDequeued(ClockMonotonicUsec() - req->enqueue_time_);
+
+    // Apply any deferred update of all routes before handling a request that
+    // does not supersede it, so that requests are applied in order.
+    if (info && info->route_update_pending() &&
+        req->type_ != ServiceChainRequestT::CONNECTED_ROUTE_ADD_CHG &&
+        req->type_ != ServiceChainRequestT::UPDATE_ALL_ROUTES) {
+        FlushServiceChainRoutesUpdate(info);
+    }
+
     ServiceChainState *state = NULL;
     if (route) {
         state = static_cast<ServiceChainState *>
@@ -1321,7 +1386,7 @@ bool ServiceChainMgr<T>::RequestHandler(ServiceChainRequestT *req) {
             if (!info->group_oper_state_up())
                 break;
 
-            UpdateServiceChainRoutes(info, path_ids);
+            DeferServiceChainRoutesUpdate(info, path_ids);
             break;
         }
         case ServiceChainRequestT::CONNECTED_ROUTE_DELETE: {
@@ -1369,7 +1434,7 @@ bool ServiceChainMgr<T>::RequestHandler(ServiceChainRequestT *req) {
 
             typename ServiceChainT::ConnectedPathIdList path_ids =
                 info->GetConnectedPathIds();
-            UpdateServiceChainRoutes(info, path_ids);
+            DeferServiceChainRoutesUpdate(info, path_ids);
             break;
         }
         case ServiceChainRequestT::DELETE_ALL_ROUTES: {
@@ -1448,6 +1513,8 @@ ServiceChainMgr<T>::ServiceChainMgr(BgpServer *server)
     process_queue_.reset(
         new WorkQueue<ServiceChainRequestT *>(service_chain_task_id_, 0,
                      bind(&ServiceChainMgr::RequestHandler, this, _1)));
+    process_queue_->SetExitCallback(
+        bind(&ServiceChainMgr::ProcessQueueExit, this, _1));
 
     id_ = server->routing_instance_mgr()->RegisterInstanceOpCallback(
         bind(&ServiceChainMgr::RoutingInstanceCallback, this, _1, _2));
@@ -1466,6 +1533,7 @@ ServiceChainMgr<T>::~ServiceChainMgr() {
 template <typename T>
 void ServiceChainMgr<T>::Terminate() {
     process_queue_->Shutdown();
+    route_update_set_.clear();
     RoutingInstanceMgr *ri_mgr = server_->routing_instance_mgr();
     ri_mgr->UnregisterInstanceOpCallback(id_);
     BgpMembershipManager *membership_mgr = server_->membership_mgr();
@@ -1628,6 +1696,11 @@ SCAddress::Family ServiceChainMgr<ServiceChainEvpn6>::GetSCFamily() const {
 template <>
 template <typename T>
 void ServiceChainMgr<T>::Enqueue(ServiceChainRequestT *req) {
+    req->enqueue_time_ = ClockMonotonicUsec();
+    if (req->info_) {
+        ServiceChainT *chain = static_cast<ServiceChainT *>(req->info_.get());
+        chain->RequestEnqueued();
+    }
     process_queue_->Enqueue(req);
 }
 
@@ -1991,6 +2064,39 @@ void ServiceChainMgr<T>::DeleteServiceChainRoutes(ServiceChainT *chain) {
     }
 }
 
+template <typename T>
+void ServiceChainMgr<T>::DeferServiceChainRoutesUpdate(ServiceChainT *chain,
+    const typename ServiceChainT::ConnectedPathIdList &old_path_ids) {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    chain->SetRouteUpdatePending(old_path_ids);
+    route_update_set_.insert(ServiceChainPtr(chain));
+}
+
+template <typename T>
+void ServiceChainMgr<T>::FlushServiceChainRoutesUpdate(ServiceChainT *chain) {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    typename ServiceChainT::ConnectedPathIdList old_path_ids =
+        chain->ClearRouteUpdatePending();
+    UpdateServiceChainRoutes(chain, old_path_ids);
+    route_update_set_.erase(ServiceChainPtr(chain));
+}
+
+//
+// Apply deferred route updates for all service chains when the process_queue_
+// runner exits.
+//
+template <typename T>
+void ServiceChainMgr<T>::ProcessQueueExit(bool done) {
+    CHECK_CONCURRENCY("bgp::ServiceChain");
+    RouteUpdateSet route_update_set;
+    route_update_set.swap(route_update_set_);
+    BOOST_FOREACH(ServiceChainPtr info, route_update_set) {
+        ServiceChainT *chain = static_cast<ServiceChainT *>(info.get());
+        if (chain->route_update_pending())
+            UpdateServiceChainRoutes(chain, chain->ClearRouteUpdatePending());
+    }
+}
+
 template <typename T>
 void ServiceChainMgr<T>::PeerRegistrationCallback(IPeer *peer, BgpTable *table,
                                                bool unregister) {
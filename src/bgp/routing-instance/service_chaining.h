@@ -8,6 +8,7 @@
 #include <boost/ptr_container/ptr_map.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
@@ -98,14 +99,16 @@ public:
           rt_(route),
           aggregate_match_(aggregate_match),
           info_(info),
-          snh_resp_(NULL) {
+          snh_resp_(NULL),
+          enqueue_time_(0) {
     }
 
     ServiceChainRequest(RequestType type, SandeshResponse *resp)
         : type_(type),
           table_(NULL),
           rt_(NULL),
-          snh_resp_(resp) {
+          snh_resp_(resp),
+          enqueue_time_(0) {
     }
 
     RequestType type_;
@@ -114,6 +117,7 @@ public:
     PrefixT aggregate_match_;
     ServiceChainPtr info_;
     SandeshResponse *snh_resp_;
+    uint64_t enqueue_time_;
 
 private:
     DISALLOW_COPY_AND_ASSIGN(ServiceChainRequest);
@@ -225,6 +229,15 @@ public:
     bool group_oper_state_up() const { return group_oper_state_up_; }
     void set_group_oper_state_up(bool up) { group_oper_state_up_ = up; }
 
+    // Request statistics.
+    void RequestEnqueued() { queue_length_++; }
+    void RequestDequeued(uint64_t latency_usecs);
+
+    // Deferred update of all service chain routes.
+    bool route_update_pending() const { return route_update_pending_; }
+    void SetRouteUpdatePending(const ConnectedPathIdList &old_path_ids);
+    ConnectedPathIdList ClearRouteUpdatePending();
+
 private:
     ServiceChainMgrT *manager_;
     ServiceChainGroup *group_;
@@ -242,6 +255,14 @@ private:
     bool aggregate_;  // Whether the host route needs to be aggregated
     bool sc_head_; // Whether this SI is at the head of the chain
     bool retain_as_path_;
+    bool route_update_pending_;
+    ConnectedPathIdList pending_old_path_ids_;
+    std::atomic<uint32_t> queue_length_;
+    uint64_t request_count_;
+    uint64_t request_latency_usecs_;
+    uint64_t request_latency_max_usecs_;
+    uint64_t route_update_count_;
+    uint64_t route_update_coalesced_count_;
     LifetimeRef<ServiceChain> src_table_delete_ref_;
     LifetimeRef<ServiceChain> dest_table_delete_ref_;
     LifetimeRef<ServiceChain> connected_table_delete_ref_;
@@ -391,6 +412,14 @@ private:
     typedef boost::ptr_map<std::string, ServiceChainGroup> GroupMap;
     typedef std::set<ServiceChainGroup *> GroupSet;
 
+    // Service chains with a deferred update of all routes.
+    // Updating all routes of a service chain is needed when the connected
+    // route changes or an XMPP peer registers to the source table, and is
+    // expensive for chains with many routes. Back to back updates for a
+    // chain are coalesced and applied when the process_queue_ run ends, or
+    // before any other request for the chain is handled.
+    typedef std::set<ServiceChainPtr> RouteUpdateSet;
+
     ServiceChainGroup *FindServiceChainGroup(RoutingInstance *rtinstance);
     ServiceChainGroup *FindServiceChainGroup(const std::string &group_name);
     ServiceChainGroup *LocateServiceChainGroup(const std::string &group_name);
@@ -422,6 +451,10 @@ private:
     void UpdateServiceChainRoutes(ServiceChainT *chain,
         const typename ServiceChainT::ConnectedPathIdList &old_path_ids);
     void DeleteServiceChainRoutes(ServiceChainT *chain);
+    void DeferServiceChainRoutesUpdate(ServiceChainT *chain,
+        const typename ServiceChainT::ConnectedPathIdList &old_path_ids);
+    void FlushServiceChainRoutesUpdate(ServiceChainT *chain);
+    void ProcessQueueExit(bool done);
 
     void StartResolve();
     bool ResolvePendingServiceChain();
@@ -456,6 +489,7 @@ private:
     boost::scoped_ptr<TaskTrigger> group_trigger_;
     GroupMap group_map_;
     GroupSet group_set_;
+    RouteUpdateSet route_update_set_;
     bool aggregate_host_route_;
     int id_;
     int registration_id_;
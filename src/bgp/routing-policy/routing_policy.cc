@@ -263,7 +263,8 @@ RoutingPolicyMgr::RequestWalk(BgpTable *table) {
     if (it == routing_policy_sync_.end()) {
         DBTable::DBTableWalkRef walk_ref = table->AllocWalker(
             boost::bind(&RoutingPolicyMgr::EvaluateRoutingPolicy, this, _1, _2),
-            boost::bind(&RoutingPolicyMgr::WalkDone, this, _2));
+            boost::bind(&RoutingPolicyMgr::WalkDone, this, _2),
+            DBTable::WALK_PRIORITY_LOW);
         table->WalkTable(walk_ref);
         routing_policy_sync_.insert(std::make_pair(table, walk_ref));
     } else {
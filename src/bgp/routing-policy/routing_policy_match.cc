@@ -79,12 +79,7 @@ MatchCommunity::~MatchCommunity() {
 // Return true if all community strings (normal or regex) are matched by the
 // community values in the BgpAttr.
 //
-bool MatchCommunity::MatchAll(const BgpAttr *attr) const {
-    // Bail if there's no community values in the BgpAttr.
-    const Community *comm = attr->community();
-    if (!comm)
-        return false;
-
+bool MatchCommunity::MatchAll(const Community *comm) const {
     // Make sure that all non-regex communities in this MatchCommunity are
     // present in the BgpAttr.
     vector<uint32_t> list = comm->communities();
@@ -116,12 +111,7 @@ bool MatchCommunity::MatchAll(const BgpAttr *attr) const {
 // Return true if any community strings (normal or regex) is matched by the
 // community values in the BgpAttr.
 //
-bool MatchCommunity::MatchAny(const BgpAttr *attr) const {
-    // Bail if there's no community values in the BgpAttr.
-    const Community *comm = attr->community();
-    if (!comm)
-        return false;
-
+bool MatchCommunity::MatchAny(const Community *comm) const {
     // Check if any of the community values in the BgpAttr matches one of
     // the normal community strings.
     BOOST_FOREACH(uint32_t community, comm->communities()) {
@@ -147,7 +137,21 @@ bool MatchCommunity::MatchAny(const BgpAttr *attr) const {
 //
 bool MatchCommunity::Match(const BgpRoute *route, const BgpPath *path,
                            const BgpAttr *attr) const {
-    return (match_all_ ? MatchAll(attr) : MatchAny(attr));
+    // Bail if there's no community values in the BgpAttr.
+    const Community *comm = attr->community();
+    if (!comm)
+        return false;
+
+    bool result;
+    if (cache_.Lookup(comm, &result))
+        return result;
+    result = (match_all_ ? MatchAll(comm) : MatchAny(comm));
+    cache_.Insert(comm, result);
+    return result;
+}
+
+void MatchCommunity::GetCacheStats(uint64_t *hits, uint64_t *misses) const {
+    cache_.GetStats(hits, misses);
 }
 
 //
@@ -176,7 +180,7 @@ string MatchCommunity::ToString() const {
 // Return true if this MatchCommunity is equal to the one supplied.
 //
 bool MatchCommunity::IsEqual(const RoutingPolicyMatch &community) const {
-    const MatchCommunity in_community =
+    const MatchCommunity &in_community =
         static_cast<const MatchCommunity &>(community);
     if (match_all() != in_community.match_all())
         return false;
@@ -222,12 +226,7 @@ MatchExtCommunity::~MatchExtCommunity() {
 // Return true if all community strings (normal or regex) are matched by the
 // community values in the BgpAttr.
 //
-bool MatchExtCommunity::MatchAll(const BgpAttr *attr) const {
-    // Bail if there's no community values in the BgpAttr.
-    const ExtCommunity *comm = attr->ext_community();
-    if (!comm)
-        return false;
-
+bool MatchExtCommunity::MatchAll(const ExtCommunity *comm) const {
     // Make sure that all non-regex communities in this MatchExtCommunity are
     // present in the BgpAttr.
     ExtCommunity::ExtCommunityList list = comm->communities();
@@ -271,12 +270,7 @@ bool MatchExtCommunity::Find(const ExtCommunity::ExtCommunityValue &community)
 // Return true if any community strings (normal or regex) is matched by the
 // community values in the BgpAttr.
 //
-bool MatchExtCommunity::MatchAny(const BgpAttr *attr) const {
-    // Bail if there's no community values in the BgpAttr.
-    const ExtCommunity *comm = attr->ext_community();
-    if (!comm)
-        return false;
-
+bool MatchExtCommunity::MatchAny(const ExtCommunity *comm) const {
     // Check if any of the community values in the BgpAttr matches one of
     // the normal community strings.
     BOOST_FOREACH(ExtCommunity::ExtCommunityValue community,
@@ -309,7 +303,22 @@ bool MatchExtCommunity::MatchAny(const BgpAttr *attr) const {
 //
 bool MatchExtCommunity::Match(const BgpRoute *route, const BgpPath *path,
                               const BgpAttr *attr) const {
-    return (match_all_ ? MatchAll(attr) : MatchAny(attr));
+    // Bail if there's no community values in the BgpAttr.
+    const ExtCommunity *comm = attr->ext_community();
+    if (!comm)
+        return false;
+
+    bool result;
+    if (cache_.Lookup(comm, &result))
+        return result;
+    result = (match_all_ ? MatchAll(comm) : MatchAny(comm));
+    cache_.Insert(comm, result);
+    return result;
+}
+
+void MatchExtCommunity::GetCacheStats(uint64_t *hits,
+                                      uint64_t *misses) const {
+    cache_.GetStats(hits, misses);
 }
 
 //
@@ -338,7 +347,7 @@ string MatchExtCommunity::ToString() const {
 // Return true if this MatchExtCommunity is equal to the one supplied.
 //
 bool MatchExtCommunity::IsEqual(const RoutingPolicyMatch &community) const {
-    const MatchExtCommunity in_community =
+    const MatchExtCommunity &in_community =
         static_cast<const MatchExtCommunity &>(community);
     if (match_all() != in_community.match_all())
         return false;
@@ -378,12 +387,59 @@ MatchPrefix<T>::MatchPrefix(const PrefixMatchConfigList &match_config_list) {
     typename PrefixMatchList::iterator it =
         unique(match_list_.begin(), match_list_.end());
     match_list_.erase(it, match_list_.end());
+    Compile();
 }
 
 template <typename T>
 MatchPrefix<T>::~MatchPrefix() {
 }
 
+template <>
+Ip4Prefix MatchPrefix<PrefixMatchInet>::MaskPrefix(const Ip4Prefix &prefix,
+                                                   int prefixlen) {
+    uint32_t mask = 0;
+    if (prefixlen)
+        mask = ((uint32_t) ~0) << (Address::kMaxV4PrefixLen - prefixlen);
+    return Ip4Prefix(Ip4Address(prefix.ip4_addr().to_ulong() & mask),
+                     prefixlen);
+}
+
+template <>
+Inet6Prefix MatchPrefix<PrefixMatchInet6>::MaskPrefix(
+    const Inet6Prefix &prefix, int prefixlen) {
+    return prefix & Inet6Masks::PrefixlenToMask(prefixlen);
+}
+
+//
+// Build the compiled form of the match list.
+//
+// A longer match on a prefix that has host bits set is never equal to the
+// prefix of a route, so it behaves as orlonger.
+//
+template <typename T>
+void MatchPrefix<T>::Compile() {
+    std::set<int> prefixlens;
+    BOOST_FOREACH(const PrefixMatch &prefix_match, match_list_) {
+        const PrefixT &prefix = prefix_match.prefix;
+        if (prefix_match.match_type == EXACT) {
+            exact_.insert(prefix);
+            continue;
+        }
+        PrefixT masked_prefix = MaskPrefix(prefix, prefix.prefixlen());
+        if (prefix_match.match_type == LONGER && masked_prefix == prefix) {
+            longer_.insert(masked_prefix);
+        } else {
+            orlonger_.insert(masked_prefix);
+        }
+        prefixlens.insert(prefix.prefixlen());
+    }
+    prefixlens_.assign(prefixlens.begin(), prefixlens.end());
+}
+
+//
+// Look up the route prefix in the exact match set and then look up the route
+// prefix masked to each of the lengths in the longer and orlonger sets.
+//
 template <typename T>
 bool MatchPrefix<T>::Match(const BgpRoute *route, const BgpPath *path,
                            const BgpAttr *attr) const {
@@ -391,26 +447,24 @@ bool MatchPrefix<T>::Match(const BgpRoute *route, const BgpPath *path,
     if (in_route == NULL)
         return false;
     const PrefixT &prefix = in_route->GetPrefix();
-    BOOST_FOREACH(const PrefixMatch &prefix_match, match_list_) {
-        if (prefix_match.match_type == EXACT) {
-            if (prefix == prefix_match.prefix)
-                return true;
-        } else if (prefix_match.match_type == LONGER) {
-            if (prefix == prefix_match.prefix)
-                continue;
-            if (prefix.IsMoreSpecific(prefix_match.prefix))
-                return true;
-        } else if (prefix_match.match_type == ORLONGER) {
-            if (prefix.IsMoreSpecific(prefix_match.prefix))
-                return true;
-        }
+    if (exact_.find(prefix) != exact_.end())
+        return true;
+    BOOST_FOREACH(int prefixlen, prefixlens_) {
+        if (prefixlen > prefix.prefixlen())
+            break;
+        PrefixT masked_prefix = MaskPrefix(prefix, prefixlen);
+        if (orlonger_.find(masked_prefix) != orlonger_.end())
+            return true;
+        if (masked_prefix != prefix &&
+            longer_.find(masked_prefix) != longer_.end())
+            return true;
     }
     return false;
 }
 
 template <typename T>
 bool MatchPrefix<T>::IsEqual(const RoutingPolicyMatch &prefix) const {
-    const MatchPrefix in_prefix = static_cast<const MatchPrefix&>(prefix);
+    const MatchPrefix &in_prefix = static_cast<const MatchPrefix&>(prefix);
     return (in_prefix.match_list_ == match_list_);
 }
 
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <mutex>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -15,6 +16,7 @@
 
 #include "base/regex.h"
 #include "bgp/bgp_config.h"
+#include "bgp/community.h"
 #include "bgp/inet/inet_route.h"
 #include "bgp/inet6/inet6_route.h"
 
@@ -43,6 +45,99 @@ public:
         return !operator==(match);
     }
     virtual bool IsEqual(const RoutingPolicyMatch &match) const = 0;
+
+    // Hits and misses of the result cache, if the match condition has one.
+    virtual void GetCacheStats(uint64_t *hits, uint64_t *misses) const {
+    }
+};
+
+//
+// Cache of match results keyed by an interned path attribute i.e. Community
+// or ExtCommunity.
+//
+// Community and extended community matches depend only on the attribute,
+// and the same interned attribute is typically shared by a large number of
+// paths. Caching the result avoids repeating the set comparisons and regex
+// matches for every path that is evaluated.
+//
+// The cache is direct mapped and split into shards by the attribute pointer
+// so that policy evaluation in different db::DBTable partitions rarely
+// contends for a shard mutex. An entry keeps a reference to the attribute so
+// that the address can't be reused for a different attribute while the entry
+// is present.
+//
+// The cache is owned by the match condition, so it goes away along with the
+// PolicyTerm when the policy is updated.
+//
+template <typename Type, typename TypePtr>
+class RoutingPolicyMatchCache {
+public:
+    static const size_t kShardCount = 8;
+    static const size_t kShardSize = 32;
+
+    RoutingPolicyMatchCache() {
+    }
+
+    bool Lookup(const Type *key, bool *result) {
+        Shard *shard = GetShard(key);
+        std::scoped_lock lock(shard->mutex);
+        const Entry &entry = shard->entries[EntryIndex(key)];
+        if (entry.key.get() != key) {
+            shard->misses++;
+            return false;
+        }
+        shard->hits++;
+        *result = entry.result;
+        return true;
+    }
+
+    void Insert(const Type *key, bool result) {
+        TypePtr old_key;
+        Shard *shard = GetShard(key);
+        std::scoped_lock lock(shard->mutex);
+        Entry &entry = shard->entries[EntryIndex(key)];
+        old_key.swap(entry.key);
+        entry.key.reset(key);
+        entry.result = result;
+    }
+
+    void GetStats(uint64_t *hits, uint64_t *misses) const {
+        for (size_t idx = 0; idx < kShardCount; ++idx) {
+            std::scoped_lock lock(shards_[idx].mutex);
+            *hits += shards_[idx].hits;
+            *misses += shards_[idx].misses;
+        }
+    }
+
+private:
+    struct Entry {
+        Entry() : result(false) { }
+        TypePtr key;
+        bool result;
+    };
+
+    struct alignas(64) Shard {
+        Shard() : hits(0), misses(0) { }
+        mutable std::mutex mutex;
+        Entry entries[kShardSize];
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    // Attributes are allocated from the heap, so skip the low order bits.
+    static size_t KeyHash(const Type *key) {
+        return reinterpret_cast<uintptr_t>(key) >> 4;
+    }
+    Shard *GetShard(const Type *key) {
+        return &shards_[KeyHash(key) % kShardCount];
+    }
+    static size_t EntryIndex(const Type *key) {
+        return (KeyHash(key) / kShardCount) % kShardSize;
+    }
+
+    Shard shards_[kShardCount];
+
+    DISALLOW_COPY_AND_ASSIGN(RoutingPolicyMatchCache);
 };
 
 class MatchCommunity: public RoutingPolicyMatch {
@@ -63,15 +158,17 @@ public:
         return to_match_regex_strings_;
     }
     const CommunityRegexList &regexs() const { return to_match_regexs_; }
+    virtual void GetCacheStats(uint64_t *hits, uint64_t *misses) const;
 
 private:
-    bool MatchAll(const BgpAttr *attr) const;
-    bool MatchAny(const BgpAttr *attr) const;
+    bool MatchAll(const Community *comm) const;
+    bool MatchAny(const Community *comm) const;
 
     bool match_all_;
     CommunityList to_match_;
     CommunityRegexStringList to_match_regex_strings_;
     CommunityRegexList to_match_regexs_;
+    mutable RoutingPolicyMatchCache<Community, CommunityPtr> cache_;
 };
 
 class MatchExtCommunity: public RoutingPolicyMatch {
@@ -95,10 +192,11 @@ public:
     }
     const CommunityRegexList &regexs() const { return to_match_regexs_; }
     bool Find(const ExtCommunity::ExtCommunityValue &community) const;
+    virtual void GetCacheStats(uint64_t *hits, uint64_t *misses) const;
 
 private:
-    bool MatchAll(const BgpAttr *attr) const;
-    bool MatchAny(const BgpAttr *attr) const;
+    bool MatchAll(const ExtCommunity *comm) const;
+    bool MatchAny(const ExtCommunity *comm) const;
     const ExtCommunity::ExtCommunityList ExtCommunityFromString(
                         const std::string &comm);
 
@@ -106,6 +204,7 @@ private:
     ExtCommunity::ExtCommunityList to_match_;
     CommunityRegexStringList to_match_regex_strings_;
     CommunityRegexList to_match_regexs_;
+    mutable RoutingPolicyMatchCache<ExtCommunity, ExtCommunityPtr> cache_;
 };
 
 class MatchProtocol: public RoutingPolicyMatch {
@@ -188,8 +287,20 @@ public:
 private:
     template <typename U> friend class MatchPrefixTest;
     typedef std::vector<PrefixMatch> PrefixMatchList;
+    typedef std::set<PrefixT> PrefixSet;
+
+    void Compile();
+    static PrefixT MaskPrefix(const PrefixT &prefix, int prefixlen);
 
     PrefixMatchList match_list_;
+
+    // Compiled form of match_list_. Prefixes to be matched as longer or
+    // orlonger are masked to their length, so that a route only needs to
+    // be looked up once for each distinct length.
+    PrefixSet exact_;
+    PrefixSet longer_;
+    PrefixSet orlonger_;
+    std::vector<int> prefixlens_;
 };
 
 typedef MatchPrefix<PrefixMatchInet> MatchPrefixInet;
@@ -29,10 +29,14 @@ static void FillRoutingPolicyInfo(ShowRoutingPolicyInfo *srpi,
         PolicyTermInfo show_term;
         show_term.set_terminal(term->terminal());
         vector<string> match_list;
+        uint64_t hits = 0, misses = 0;
         BOOST_FOREACH(RoutingPolicyMatch *match, term->matches()) {
             match_list.push_back(match->ToString());
+            match->GetCacheStats(&hits, &misses);
         }
         show_term.set_matches(match_list);
+        show_term.set_match_cache_hits(hits);
+        show_term.set_match_cache_misses(misses);
         vector<string> action_list;
         BOOST_FOREACH(RoutingPolicyAction *action, term->actions()) {
             action_list.push_back(action->ToString());
@@ -3254,6 +3254,68 @@ TEST_F(BgpAttrTest, EdgeForwardingDBConcurrency) {
                     EdgeForwardingSpec>(edge_forwarding_db_);
 }
 
+// ----- Locate and delete attributes from many threads in one shard and in
+// the default shards. Each thread keeps a window of recently located
+// communities, so that the mix includes inserts, lookups of existing entries
+// and deletes.
+
+struct ShardedLocateArgs {
+    CommunityDB *db;
+    uint32_t base;
+};
+
+static const int kShardedLocateCount = 20000;
+static const int kShardedLocateWindow = 64;
+static const int kShardedLocateThreads = 8;
+
+static void *ShardedLocateThreadRun(void *objp) {
+    ShardedLocateArgs *args = reinterpret_cast<ShardedLocateArgs *>(objp);
+    vector<CommunityPtr> window(kShardedLocateWindow);
+    CommunitySpec spec;
+    spec.communities.push_back(0);
+    for (int idx = 0; idx < kShardedLocateCount; ++idx) {
+        spec.communities[0] = args->base + idx % 1024;
+        window[idx % kShardedLocateWindow] = args->db->Locate(spec);
+        EXPECT_EQ(spec.communities[0],
+            window[idx % kShardedLocateWindow]->communities().front());
+    }
+    return NULL;
+}
+
+static void ShardedLocate(CommunityDB *db) {
+    vector<ShardedLocateArgs> args(kShardedLocateThreads);
+    vector<pthread_t> thread_ids;
+    for (int idx = 0; idx < kShardedLocateThreads; ++idx) {
+        pthread_t tid;
+        args[idx].db = db;
+        args[idx].base = (idx % 2) * 1024;
+        if (!pthread_create(&tid, NULL, &ShardedLocateThreadRun, &args[idx]))
+            thread_ids.push_back(tid);
+    }
+    BOOST_FOREACH(pthread_t tid, thread_ids) { pthread_join(tid, NULL); }
+    EXPECT_EQ(0, db->Size());
+
+    CommunityDB::Stats stats;
+    db->GetStats(&stats);
+    EXPECT_EQ(static_cast<uint64_t>(thread_ids.size()) * kShardedLocateCount,
+              stats.locates);
+    EXPECT_EQ(stats.inserts, stats.deletes);
+    EXPECT_GE(stats.locates, stats.inserts);
+}
+
+TEST_F(BgpAttrTest, ShardedLocate) {
+    setenv("BGP_PATH_ATTRIBUTE_DB_HASH_SIZE", "1", true);
+    CommunityDB single_db(&server_);
+    unsetenv("BGP_PATH_ATTRIBUTE_DB_HASH_SIZE");
+    CommunityDB sharded_db(&server_);
+    EXPECT_EQ(1, single_db.hash_size());
+    EXPECT_EQ(static_cast<size_t>(CommunityDB::kDefaultHashSize),
+              sharded_db.hash_size());
+
+    ShardedLocate(&single_db);
+    ShardedLocate(&sharded_db);
+}
+
 static void SetUp() {
     bgp_log_test::init();
     ControlNode::SetDefaultSchedulingPolicy();
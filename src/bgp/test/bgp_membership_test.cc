@@ -13,6 +13,7 @@
 #include "bgp/bgp_config_ifmap.h"
 #include "bgp/bgp_factory.h"
 #include "bgp/bgp_membership.h"
+#include "bgp/bgp_peer_types.h"
 #include "bgp/bgp_session_manager.h"
 #include "bgp/test/bgp_server_test_util.h"
 #include "db/db_partition.h"
@@ -287,6 +288,21 @@ protected:
             boost::bind(&BgpMembershipManager::Walker::ResumeWalk, walker_),
             "bgp::Config");
     }
+    uint32_t GetPeerRibWalkCount(BgpTestPeer *peer, BgpTable *table) {
+        const BgpMembershipManager::PeerRibState *prs =
+            mgr_->FindPeerRibState(peer, table);
+        if (!prs)
+            return 0;
+        ShowMembershipPeerInfo smpi;
+        prs->FillMembershipInfo(&smpi);
+        return smpi.get_walks();
+    }
+    void WalkerSetMaxWalks(size_t max_walks) {
+        task_util::TaskFire(
+            boost::bind(&BgpMembershipManager::Walker::SetMaxWalks,
+                walker_, max_walks),
+            "bgp::Config");
+    }
 
     BgpMembershipManagerTest *mgr_;
     BgpMembershipManager::Walker *walker_;
@@ -1145,6 +1161,74 @@ TEST_F(BgpMembershipTest, MultiplePeersMultipleTable) {
     TASK_UTIL_EXPECT_EQ(red_walk_count + 2, red_tbl_->walk_complete_count());
 }
 
+//
+// Verify that walks for multiple tables are started without waiting for the
+// previous ones to finish, up to the maximum number of walks.
+//
+TEST_F(BgpMembershipTest, MultipleTablesConcurrentWalks) {
+    uint64_t blue_walk_count = blue_tbl_->walk_complete_count();
+    uint64_t red_walk_count = red_tbl_->walk_complete_count();
+    uint64_t gray_walk_count = gray_tbl_->walk_complete_count();
+
+    // Allow only 2 walks at a time.
+    WalkerSetMaxWalks(2);
+
+    // Disable walker.
+    SetWalkerDisable(true);
+
+    // Register all peers.
+    for (int idx = 0; idx < 3; ++idx) {
+        Register(peers_[idx], blue_tbl_);
+        Register(peers_[idx], red_tbl_);
+        Register(peers_[idx], gray_tbl_);
+    }
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_EQ(3, GetWalkerQueueSize());
+
+    // Postpone walk.
+    WalkerPostponeWalk();
+
+    // Enable walker.
+    SetWalkerDisable(false);
+    task_util::WaitForIdle();
+
+    // Walks have been started for 2 tables.
+    TASK_UTIL_EXPECT_EQ(1, GetWalkerQueueSize());
+    TASK_UTIL_EXPECT_EQ(6, GetWalkerPeerRibListSize());
+    TASK_UTIL_EXPECT_EQ(2, GetWalkerRibOutStateListSize());
+    TASK_UTIL_EXPECT_EQ(0, mgr_->GetMembershipCount());
+
+    // Resume walk.
+    WalkerResumeWalk();
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_TRUE(IsWalkerQueueEmpty());
+    TASK_UTIL_EXPECT_EQ(0, GetWalkerPeerRibListSize());
+    TASK_UTIL_EXPECT_EQ(9, mgr_->GetMembershipCount());
+    TASK_UTIL_EXPECT_EQ(blue_walk_count + 1, blue_tbl_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(red_walk_count + 1, red_tbl_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(gray_walk_count + 1, gray_tbl_->walk_complete_count());
+
+    // Walk times are recorded for each PeerRibState.
+    for (int idx = 0; idx < 3; ++idx) {
+        EXPECT_EQ(1, GetPeerRibWalkCount(peers_[idx], gray_tbl_));
+    }
+
+    // Unregister all peers.
+    for (int idx = 0; idx < 3; ++idx) {
+        Unregister(peers_[idx], blue_tbl_);
+        Unregister(peers_[idx], red_tbl_);
+        Unregister(peers_[idx], gray_tbl_);
+    }
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_TRUE(IsWalkerQueueEmpty());
+    TASK_UTIL_EXPECT_EQ(0, mgr_->GetMembershipCount());
+    TASK_UTIL_EXPECT_EQ(blue_walk_count + 2, blue_tbl_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(red_walk_count + 2, red_tbl_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(gray_walk_count + 2, gray_tbl_->walk_complete_count());
+}
+
 //
 // Duplicate register causes assertion.
 // Duplicate register happens after original is fully processed.
@@ -3,6 +3,7 @@
  */
 
 #include "base/task_annotations.h"
+#include "base/time_util.h"
 #include "base/test/task_test_util.h"
 
 #include "bgp/bgp_factory.h"
@@ -57,6 +58,7 @@ protected:
     }
     void TestAttemptGRHelperMode(bool notification, int code, int subcode)
         const;
+    BgpAttrPtr BuildAttr();
 
     EventManager evm_;
     BgpServer server_;
@@ -326,6 +328,132 @@ TEST_F(BgpMsgBuilderTest, BuildAs4) {
     delete result;
 }
 
+BgpAttrPtr BgpMsgBuilderTest::BuildAttr() {
+    BgpAttrSpec attr_spec;
+    attr_spec.push_back(new BgpAttrNextHop(0xabcdef01));
+    attr_spec.push_back(new BgpAttrOrigin(BgpAttrOrigin::INCOMPLETE));
+    attr_spec.push_back(new BgpAttrMultiExitDisc(1));
+    attr_spec.push_back(new BgpAttrLocalPref(2));
+
+    AsPathSpec *path_spec = new AsPathSpec;
+    AsPathSpec::PathSegment *ps = new AsPathSpec::PathSegment;
+    ps->path_segment_type = AsPathSpec::PathSegment::AS_SEQUENCE;
+    for (int idx = 0; idx < 8; ++idx) {
+        ps->path_segment.push_back(64512 + idx);
+    }
+    path_spec->path_segments.push_back(ps);
+    attr_spec.push_back(path_spec);
+
+    CommunitySpec *community = new CommunitySpec;
+    ExtCommunitySpec *ext_community = new ExtCommunitySpec;
+    for (int idx = 0; idx < 8; ++idx) {
+        community->communities.push_back(0x87654321 + idx);
+        ext_community->communities.push_back(0x1020304050607080 + idx);
+    }
+    attr_spec.push_back(community);
+    attr_spec.push_back(ext_community);
+
+    BgpAttrPtr attr = server_.attr_db()->Locate(attr_spec);
+    STLDeleteValues(&attr_spec);
+    return attr;
+}
+
+//
+// Verify that the message built with the cached attribute encoding is the
+// same as the one built without the cache, for all encoding variants.
+//
+TEST_F(BgpMsgBuilderTest, EncodingCache) {
+    RibOutAttr rib_out_attr;
+    rib_out_attr.set_attr(NULL, BuildAttr());
+
+    InetVpnPrefix p1 = InetVpnPrefix::FromString("12345:2:1.1.1.1/24");
+    InetVpnRoute route(p1);
+    BgpPath *path =
+        new BgpPath(peer_, BgpPath::BGP_XMPP, rib_out_attr.attr(), 0, 0);
+    route.InsertPath(path);
+    InetVpnPrefix p2 = InetVpnPrefix::FromString("12345:2:2.2.2.2/24");
+    InetVpnRoute route2(p2);
+    BgpPath *path2 =
+        new BgpPath(peer_, BgpPath::BGP_XMPP, rib_out_attr.attr(), 0, 0);
+    route2.InsertPath(path2);
+
+    DB db;
+    InetVpnTable table(&db, "bgp.l3vpn.0");
+    for (int as4 = 0; as4 < 2; ++as4) {
+        RibExportPolicy policy(BgpProto::IBGP, RibExportPolicy::BGP, 100, 0);
+        RibOut ribout(static_cast<BgpTable *>(&table), NULL, policy);
+        ribout.set_as4_supported(as4 != 0);
+
+        string messages[2];
+        for (int cache = 0; cache < 2; ++cache) {
+            BgpMessage::SetEncodingCacheEnabled(cache != 0);
+            BgpMessage message;
+            EXPECT_TRUE(message.Start(&ribout, false, &rib_out_attr, &route));
+            EXPECT_TRUE(message.AddRoute(&route2, &rib_out_attr));
+
+            size_t length;
+            const string *msg_str;
+            string temp;
+            const uint8_t *data =
+                message.GetData(NULL, &length, &msg_str, &temp);
+            messages[cache].assign(reinterpret_cast<const char *>(data),
+                                   length);
+
+            std::unique_ptr<const BgpProto::Update> result(
+                static_cast<const BgpProto::Update *>(
+                    BgpProto::Decode(data, length, NULL, as4 != 0)));
+            ASSERT_TRUE(result.get() != NULL);
+            BgpMpNlri *nlri = static_cast<BgpMpNlri *>(
+                *(result->path_attributes.end() - 1));
+            EXPECT_EQ(2, nlri->nlri.size());
+        }
+        EXPECT_EQ(messages[0], messages[1]);
+    }
+    BgpMessage::SetEncodingCacheEnabled(true);
+
+    route.RemovePath(peer_);
+    route2.RemovePath(peer_);
+}
+
+//
+// Compare the rate at which update messages are built with and without the
+// cached attribute encoding.
+//
+TEST_F(BgpMsgBuilderTest, EncodeScale) {
+    static const int kMessageCount = 200 * 1000;
+    RibOutAttr rib_out_attr;
+    rib_out_attr.set_attr(NULL, BuildAttr());
+
+    InetVpnPrefix p1 = InetVpnPrefix::FromString("12345:2:1.1.1.1/24");
+    InetVpnRoute route(p1);
+    BgpPath *path =
+        new BgpPath(peer_, BgpPath::BGP_XMPP, rib_out_attr.attr(), 0, 0);
+    route.InsertPath(path);
+
+    DB db;
+    InetVpnTable table(&db, "bgp.l3vpn.0");
+    RibOut ribout(static_cast<BgpTable *>(&table), NULL, RibExportPolicy());
+    BgpMessage message;
+
+    uint64_t usecs[2];
+    for (int cache = 0; cache < 2; ++cache) {
+        BgpMessage::SetEncodingCacheEnabled(cache != 0);
+        uint64_t start = ClockMonotonicUsec();
+        for (int idx = 0; idx < kMessageCount; ++idx) {
+            message.Start(&ribout, false, &rib_out_attr, &route);
+        }
+        usecs[cache] = ClockMonotonicUsec() - start;
+    }
+    BgpMessage::SetEncodingCacheEnabled(true);
+
+    cout << "Without encoding cache: " << kMessageCount << " messages in "
+         << usecs[0] << " usec" << endl;
+    cout << "With encoding cache   : " << kMessageCount << " messages in "
+         << usecs[1] << " usec" << endl;
+
+    route.RemovePath(peer_);
+}
+
 void BgpMsgBuilderTest::TestAttemptGRHelperMode(bool notification, int code,
                                                 int subcode) const {
     if (!code) {
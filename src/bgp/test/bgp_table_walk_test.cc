@@ -163,6 +163,14 @@ public:
         return true;
     }
 
+    // Walk Callback that takes longer than the walk time budget
+    bool WalkTableSlowCallback(DBTablePartBase *root, DBEntryBase *entry) {
+        CHECK_CONCURRENCY("db::DBTable");
+        usleep(10);
+        walk_count_++;
+        return true;
+    }
+
     bool WalkTableCallback_1(DBTablePartBase *root, DBEntryBase *entry) {
         walk_count_1_++;
         return true;
@@ -489,6 +497,48 @@ TEST_F(BgpTableWalkTest, SerialWalk) {
     DeleteInetRoute(purple_, "33.3.3.0/24");
 }
 
+//
+// Trigger a low priority walk followed by a high priority walk.
+// Verify that the high priority walk is started first
+//
+TEST_F(BgpTableWalkTest, WalkPriority) {
+    AddInetRoute(red_, "11.1.1.0/24");
+    AddInetRoute(blue_, "22.2.2.0/24");
+
+    DBTable::DBTableWalkRef walk_ref_1 = red_->AllocWalker(
+              boost::bind(&BgpTableWalkTest::WalkTableCallback, this, _1, _2),
+              boost::bind(&BgpTableWalkTest::WalkDone_1, this, _1, _2),
+              DBTable::WALK_PRIORITY_LOW);
+    DBTable::DBTableWalkRef walk_ref_2 = blue_->AllocWalker(
+    boost::bind(&BgpTableWalkTest::WalkTableCallback, this, _1, _2),
+    boost::bind(&BgpTableWalkTest::WalkDoneToStopWalkProcessing, this, _1, _2),
+    DBTable::WALK_PRIORITY_HIGH);
+
+    // Disable the walk processing till we start both walks
+    DisableWalkProcessing();
+    WalkTable(red_, walk_ref_1);
+    WalkTable(blue_, walk_ref_2);
+    EnableWalkProcessing();
+
+    TASK_UTIL_EXPECT_TRUE(walk_done_);
+
+    TASK_UTIL_EXPECT_EQ(1, blue_->walk_count());
+    TASK_UTIL_EXPECT_EQ(1, blue_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(1, blue_->walk_entry_count());
+    // Ensure that walk did not start on RED table
+    TASK_UTIL_EXPECT_EQ(0, red_->walk_count());
+    TASK_UTIL_EXPECT_FALSE(walk_done_1_);
+
+    EnableWalkProcessing();
+    TASK_UTIL_EXPECT_TRUE(walk_done_1_);
+    TASK_UTIL_EXPECT_EQ(2, walk_count_);
+    TASK_UTIL_EXPECT_EQ(1, red_->walk_count());
+    TASK_UTIL_EXPECT_EQ(1, red_->walk_complete_count());
+
+    DeleteInetRoute(red_, "11.1.1.0/24");
+    DeleteInetRoute(blue_, "22.2.2.0/24");
+}
+
 //
 // Trigger walk on multiple tables at same time.
 // verify that walk is performed in serial manner
@@ -839,6 +889,43 @@ TEST_F(BgpTableWalkTest, WalkAgain_1) {
     DeleteInetRoute(red_, "1.1.1.0/24");
 }
 
+//
+// Walk a table whose partitions take longer to walk than the time budget.
+// Verify that the walk yields and resumes from the last visited entry, so
+// that every entry is walked exactly once.
+//
+TEST_F(BgpTableWalkTest, WalkYieldTimeBudget) {
+    red_->SetWalkYieldTimeBudget(1);
+
+    for (int idx = 0; idx < 2048; idx++) {
+        string prefix = string("10.1.") + integerToString(idx / 256) + "." +
+            integerToString(idx % 256) + "/32";
+        AddInetRoute(red_, prefix, false);
+    }
+
+    DBTable::DBTableWalkRef walk_ref = red_->AllocWalker(
+     boost::bind(&BgpTableWalkTest::WalkTableSlowCallback, this, _1, _2),
+     boost::bind(&BgpTableWalkTest::WalkDone, this, _1, _2));
+
+    WalkTable(red_, walk_ref);
+
+    TASK_UTIL_EXPECT_TRUE(walk_done_);
+
+    TASK_UTIL_EXPECT_EQ(2048, walk_count_);
+    TASK_UTIL_EXPECT_EQ(1, walk_done_count_);
+    TASK_UTIL_EXPECT_EQ(1, red_->walk_count());
+    TASK_UTIL_EXPECT_EQ(1, red_->walk_complete_count());
+    TASK_UTIL_EXPECT_EQ(2048, red_->walk_entry_count());
+    TASK_UTIL_EXPECT_TRUE(red_->walk_yield_count() > 0);
+
+    red_->SetWalkYieldTimeBudget(0);
+    for (int idx = 0; idx < 2048; idx++) {
+        string prefix = string("10.1.") + integerToString(idx / 256) + "." +
+            integerToString(idx % 256) + "/32";
+        DeleteInetRoute(red_, prefix, false);
+    }
+}
+
 //
 // Verify that walker is not notified for all entries of the table if the walk
 // callback funtion return "False".
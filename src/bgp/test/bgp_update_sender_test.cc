@@ -9,6 +9,7 @@
 #include "base/test/task_test_util.h"
 #include "bgp/bgp_factory.h"
 #include "bgp/bgp_log.h"
+#include "bgp/bgp_peer_internal_types.h"
 #include "bgp/bgp_ribout.h"
 #include "bgp/bgp_ribout_updates.h"
 #include "bgp/bgp_server.h"
@@ -317,6 +318,42 @@ TEST_F(BgpUpdateSenderTest, TailDequeueBasic1b) {
     }
 }
 
+//
+// Worker yields after the configured number of WorkBase entries and gets
+// rescheduled to process the remaining ones.
+//
+TEST_F(BgpUpdateSenderTest, TailDequeueWorkerYield) {
+    const int kTailCount = 5;
+    RibPeerSet peerset;
+    BuildPeerSet(peerset, 0, 0, kPeerCount-1);
+
+    // Expect kTailCount calls to TailDequeue.
+    EXPECT_CALL(*updates_[0],
+        TailDequeue(RibOutUpdates::QUPDATE, peerset,
+                    Property(&RibPeerSet::empty, true),
+                    Property(&RibPeerSet::empty, true)))
+        .Times(kTailCount)
+        .WillRepeatedly(Return(true));
+
+    BgpUpdateSender::SetWorkerMaxIterations(2);
+    sender_->DisableProcessing();
+    for (int idx = 0; idx < kTailCount; idx++) {
+        RibOutActive(ribouts_[0], RibOutUpdates::QUPDATE);
+    }
+    sender_->EnableProcessing();
+    task_util::WaitForIdle();
+    BgpUpdateSender::SetWorkerMaxIterations(0);
+
+    vector<ShowBgpSenderPartition> sparts;
+    sender_->FillStatisticsInfo(&sparts);
+    const ShowBgpSenderPartition &spart = sparts[spartition_->index()];
+    EXPECT_EQ(kTailCount, spart.get_ribout_work());
+    EXPECT_EQ(kTailCount, spart.get_max_work_queue_len());
+    EXPECT_EQ(3, spart.get_runs());
+    EXPECT_EQ(2, spart.get_yields());
+    EXPECT_EQ(0, spart.get_work_queue_len());
+}
+
 //
 // Calling RibOutActive for each qid causes TailDequeue for that qid.
 //
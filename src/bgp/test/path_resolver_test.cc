@@ -2352,6 +2352,72 @@ TYPED_TEST(PathResolverTest, MultiplePrefixChangeXmppPath1) {
     }
 }
 
+//
+// BGP has multiple prefixes, each with the same nexthop.
+// Change XMPP path multiple times when path update list processing is disabled.
+// Each dependent path is evaluated only once when processing is enabled.
+//
+TYPED_TEST(PathResolverTest, MultiplePrefixChangeXmppPathStats) {
+    PeerMock *bgp_peer1 = this->bgp_peer1_;
+    PeerMock *xmpp_peer1 = this->xmpp_peer1_;
+
+    for (int idx = 1; idx <= DB::PartitionCount() * 2; ++idx) {
+        this->AddBgpPath(bgp_peer1, "blue", this->BuildPrefix(idx),
+            this->BuildHostAddress(bgp_peer1->ToString()));
+    }
+
+    this->AddXmppPath(xmpp_peer1, "blue",
+        this->BuildPrefix(bgp_peer1->ToString(), 32),
+        this->BuildNextHopAddress("172.16.1.1"), 10000);
+    for (int idx = 1; idx <= DB::PartitionCount() * 2; ++idx) {
+        this->VerifyPathAttributes("blue", this->BuildPrefix(idx), bgp_peer1,
+            this->BuildNextHopAddress("172.16.1.1"), 10000);
+    }
+
+    TASK_UTIL_EXPECT_EQ(0, this->ResolverPathUpdateListSize("blue"));
+    PathResolver *resolver = this->GetTable("blue")->path_resolver();
+    ShowPathResolver spr1;
+    resolver->FillShowInfo(&spr1, true);
+    this->DisableResolverPathUpdateProcessing("blue");
+
+    this->AddXmppPath(xmpp_peer1, "blue",
+        this->BuildPrefix(bgp_peer1->ToString(), 32),
+        this->BuildNextHopAddress("172.16.1.1"), 10001);
+    this->AddXmppPath(xmpp_peer1, "blue",
+        this->BuildPrefix(bgp_peer1->ToString(), 32),
+        this->BuildNextHopAddress("172.16.1.1"), 10002);
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_EQ((size_t)DB::PartitionCount() * 2,
+        this->ResolverPathUpdateListSize("blue"));
+
+    this->EnableResolverPathUpdateProcessing("blue");
+    TASK_UTIL_EXPECT_EQ(0, this->ResolverPathUpdateListSize("blue"));
+    for (int idx = 1; idx <= DB::PartitionCount() * 2; ++idx) {
+        this->VerifyPathAttributes("blue", this->BuildPrefix(idx), bgp_peer1,
+            this->BuildNextHopAddress("172.16.1.1"), 10002);
+    }
+
+    ShowPathResolver spr2;
+    resolver->FillShowInfo(&spr2, true);
+    EXPECT_LE(spr1.get_nexthop_updates() + 2, spr2.get_nexthop_updates());
+    EXPECT_EQ(spr1.get_path_updates() + (uint64_t) DB::PartitionCount() * 2,
+        spr2.get_path_updates());
+    EXPECT_LT(spr1.get_nexthop_resolutions(), spr2.get_nexthop_resolutions());
+    EXPECT_GE(spr2.get_resolution_latency_max_usecs(),
+        spr2.get_resolution_latency_avg_usecs());
+
+    this->DeleteXmppPath(xmpp_peer1, "blue",
+        this->BuildPrefix(bgp_peer1->ToString(), 32));
+    for (int idx = 1; idx <= DB::PartitionCount() * 2; ++idx) {
+        this->VerifyPathNoExists("blue", this->BuildPrefix(idx), bgp_peer1,
+            this->BuildNextHopAddress("172.16.1.1"));
+    }
+
+    for (int idx = 1; idx <= DB::PartitionCount() * 2; ++idx) {
+        this->DeleteBgpPath(bgp_peer1, "blue", this->BuildPrefix(idx));
+    }
+}
+
 //
 // BGP has multiple prefixes, each with the same nexthop.
 // Change XMPP path and delete it path update list processing is disabled.
@@ -136,6 +136,15 @@ public:
 
     int restart_time() const { return restart_time_; }
     bool restart_timer_started() const { return restart_timer_started_; }
+    bool walk_rib_in_called() const { return walk_rib_in_called_; }
+    uint64_t sweep_walks() const { return stats().sweep_walks; }
+    uint64_t sweep_walks_skipped() const {
+        return stats().sweep_walks_skipped;
+    }
+    bool IsNone() const { return state() == NONE; }
+    static int GetSweepState() { return SWEEP; }
+    static int GetMembershipRequestEvent() { return MEMBERSHIP_REQUEST; }
+    static int GetMembershipNoneState() { return MEMBERSHIP_NONE; }
     void Run();
     static int GetBeginState() { return BEGIN_STATE; }
     static int GetEndState() { return END_STATE; }
@@ -696,6 +705,9 @@ public:
         peer_close_->set_ll_graceful(std::get<4>(GetParam()));
         peer_close_->set_close_graceful(std::get<5>(GetParam()));
 
+        // Account a stale path so that the RibIn is walked in SWEEP state.
+        close_manager_->UpdateRouteStats(Address::INET, NULL, BgpPath::Stale);
+
         thread_.Start();
     }
 
@@ -736,6 +748,71 @@ INSTANTIATE_TEST_CASE_P(PeerCloseTestWithParams, PeerCloseTest,
                               PeerCloseManagerTest::GetEndMembershipState()+1),
         ::testing::Bool()));
 
+class PeerCloseSweepTest : public ::testing::Test {
+public:
+    PeerCloseSweepTest() : thread_(&evm_) { }
+
+    virtual void SetUp() {
+        peer_close_.reset(new IPeerCloseTest());
+        close_manager_.reset(new PeerCloseManagerTest(peer_close_.get(),
+                                     *(evm_.io_service())));
+        peer_close_->SetManager(close_manager_.get());
+        close_manager_->SetUp(PeerCloseManagerTest::GetSweepState(),
+                              PeerCloseManagerTest::GetMembershipRequestEvent(),
+                              0, true,
+                              PeerCloseManagerTest::GetMembershipNoneState(),
+                              true, false, false, false, false,
+                              peer_close_.get());
+        peer_close_->set_is_ready(true);
+        peer_close_->set_graceful(true);
+        peer_close_->set_close_graceful(true);
+        thread_.Start();
+    }
+
+    virtual void TearDown() {
+        task_util::WaitForIdle();
+        close_manager_->stale_timer()->Cancel();
+        task_util::WaitForIdle();
+        close_manager_.reset();
+        task_util::WaitForIdle();
+        evm_.Shutdown();
+        thread_.Join();
+        task_util::WaitForIdle();
+    }
+
+protected:
+    boost::scoped_ptr<PeerCloseManagerTest> close_manager_;
+    boost::scoped_ptr<IPeerCloseTest> peer_close_;
+    EventManager evm_;
+    ServerThread thread_;
+};
+
+// All paths were refreshed, so the sweep completes without walking the RibIn.
+TEST_F(PeerCloseSweepTest, NoStalePaths) {
+    close_manager_->GotoState();
+    close_manager_->MembershipRequest();
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_TRUE(close_manager_->IsNone());
+    TASK_UTIL_EXPECT_TRUE(peer_close_->swept());
+    TASK_UTIL_EXPECT_TRUE(peer_close_->membership_request_complete_result());
+    EXPECT_FALSE(close_manager_->walk_rib_in_called());
+    EXPECT_EQ(0, close_manager_->sweep_walks());
+    EXPECT_EQ(1, close_manager_->sweep_walks_skipped());
+}
+
+// A stale path is left, so the RibIn is walked.
+TEST_F(PeerCloseSweepTest, StalePaths) {
+    close_manager_->UpdateRouteStats(Address::INET, NULL, BgpPath::Stale);
+    close_manager_->GotoState();
+    close_manager_->MembershipRequest();
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_TRUE(close_manager_->walk_rib_in_called());
+    EXPECT_EQ(1, close_manager_->sweep_walks());
+    EXPECT_EQ(0, close_manager_->sweep_walks_skipped());
+}
+
 static void SetUp() {
     bgp_log_test::init();
     ControlNode::SetDefaultSchedulingPolicy();
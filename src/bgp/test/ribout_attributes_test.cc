@@ -334,6 +334,63 @@ TEST_F(RibOutAttributesTest, SequenceNumber2) {
     route.RemovePath(&peer2);
 }
 
+// RibOutAttrs with the same nexthops share an interned NextHopList.
+TEST_F(RibOutAttributesTest, SharedNextHopList) {
+    RibOutNextHopListDB *nexthop_list_db = RibOutAttr::nexthop_list_db();
+    size_t size = nexthop_list_db->Size();
+    uint64_t bytes = nexthop_list_db->bytes();
+    uint64_t ainfo_count = AdvertiseInfo::count();
+
+    BgpAttrLocalPref local_pref(100);
+    BgpAttrNextHop nexthop1(0x01010101);
+    BgpAttrSpec spec1;
+    spec1.push_back(&local_pref);
+    spec1.push_back(&nexthop1);
+    BgpAttrPtr attr1 = server_.attr_db()->Locate(spec1);
+
+    BgpAttrNextHop nexthop2(0x01010102);
+    BgpAttrSpec spec2;
+    spec2.push_back(&local_pref);
+    spec2.push_back(&nexthop2);
+    BgpAttrPtr attr2 = server_.attr_db()->Locate(spec2);
+
+    {
+    RibOutAttr roattr1(NULL, attr1.get(), 100, 0, true);
+    RibOutAttr roattr2(NULL, attr1.get(), 100, 0, true);
+    RibOutAttr roattr3(NULL, attr1.get(), 200, 0, true);
+    RibOutAttr roattr4(NULL, attr2.get(), 100, 0, true);
+    EXPECT_EQ(size + 3, nexthop_list_db->Size());
+    EXPECT_LT(bytes, nexthop_list_db->bytes());
+
+    EXPECT_TRUE(roattr1 == roattr2);
+    EXPECT_EQ(&roattr1.nexthop_list(), &roattr2.nexthop_list());
+    EXPECT_TRUE(roattr1 != roattr3);
+    EXPECT_NE(&roattr1.nexthop_list(), &roattr3.nexthop_list());
+    EXPECT_EQ(200, roattr3.label());
+    EXPECT_TRUE(roattr1 != roattr4);
+    EXPECT_EQ(attr2->nexthop(), roattr4.nexthop_list().at(0).address());
+
+    // History shares the NextHopList and does not copy the representation.
+    roattr1.set_repr("<item/>");
+    AdvertiseInfo *ainfo = new AdvertiseInfo(&roattr1);
+    EXPECT_EQ(ainfo_count + 1, AdvertiseInfo::count());
+    EXPECT_EQ(&roattr1.nexthop_list(), &ainfo->roattr.nexthop_list());
+    EXPECT_TRUE(ainfo->roattr.repr().empty());
+    EXPECT_EQ("<item/>", roattr1.repr());
+    delete ainfo;
+    EXPECT_EQ(ainfo_count, AdvertiseInfo::count());
+
+    // Non-xmpp attributes don't have nexthops.
+    RibOutAttr roattr5(NULL, attr1.get(), 100);
+    EXPECT_TRUE(roattr5.nexthop_list().empty());
+    EXPECT_EQ(100, roattr5.label());
+    EXPECT_EQ(size + 3, nexthop_list_db->Size());
+    }
+
+    EXPECT_EQ(size, nexthop_list_db->Size());
+    EXPECT_EQ(bytes, nexthop_list_db->bytes());
+}
+
 }  // namespace
 
 static void SetUp() {
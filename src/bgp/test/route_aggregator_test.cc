@@ -259,6 +259,46 @@ protected:
         table->Enqueue(&request);
     }
 
+    // Enqueue add or delete of /32 routes starting at first_addr without
+    // waiting for them to be processed.
+    void EnqueueInetRoutes(IPeer *peer, const string &table_name,
+                           const Ip4Address &first_addr, int count, bool add) {
+        BgpTable *table = static_cast<BgpTable *>
+            (bgp_server_->database()->FindTable(table_name));
+        ASSERT_TRUE(table != NULL);
+
+        BgpAttrPtr attr;
+        if (add) {
+            BgpAttrSpec attr_spec;
+            BgpAttrLocalPref local_pref(100);
+            attr_spec.push_back(&local_pref);
+            boost::system::error_code ec;
+            BgpAttrNextHop nh_spec(Ip4Address::from_string("99.99.99.99", ec));
+            attr_spec.push_back(&nh_spec);
+            attr = bgp_server_->attr_db()->Locate(attr_spec);
+        }
+
+        for (int idx = 0; idx < count; ++idx) {
+            Ip4Prefix nlri(Ip4Address(first_addr.to_ulong() + idx), 32);
+            DBRequest request;
+            request.key.reset(new InetTable::RequestKey(nlri, peer));
+            if (add) {
+                request.oper = DBRequest::DB_ENTRY_ADD_CHANGE;
+                request.data.reset(new BgpTable::RequestData(attr, 0, 88));
+            } else {
+                request.oper = DBRequest::DB_ENTRY_DELETE;
+            }
+            table->Enqueue(&request);
+        }
+    }
+
+    uint64_t GetContributingRouteCount(const string &instance,
+                                       Address::Family fmly) {
+        RoutingInstance *rti =
+            bgp_server_->routing_instance_mgr()->GetRoutingInstance(instance);
+        return rti->route_aggregator(fmly)->GetContributingRouteCount();
+    }
+
     int RouteCount(const string &table_name) const {
         BgpTable *table = static_cast<BgpTable *>(
             bgp_server_->database()->FindTable(table_name));
@@ -2212,6 +2252,59 @@ TEST_F(RouteAggregatorTest, ConfigDelete_DelayedRouteProcessing_2) {
     VerifyRouteAggregateSandesh("test", true);
 }
 
+//
+// Add and delete many more specific routes of a single aggregate prefix.
+// Verify that the contributing route count follows the routes and that the
+// aggregate route is removed only when the last one is deleted.
+//
+TEST_F(RouteAggregatorTest, ContributingRouteCount) {
+    const int kRouteCount = 1000;
+    string content =
+        FileRead("controller/src/bgp/testdata/route_aggregate_0i.xml");
+    EXPECT_TRUE(parser_.Parse(content));
+    task_util::WaitForIdle();
+
+    boost::system::error_code ec;
+    peers_.push_back(
+        new BgpPeerMock(Ip4Address::from_string("192.168.0.1", ec)));
+    AddRoute<InetDefinition>(peers_[0], "test.inet.0", "1.1.1.1/32", 100);
+    task_util::WaitForIdle();
+
+    Ip4Address first_addr = Ip4Address::from_string("10.0.0.0", ec);
+    EnqueueInetRoutes(peers_[0], "test.inet.0", first_addr, kRouteCount, true);
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_EQ(kRouteCount + 2, RouteCount("test.inet.0"));
+    TASK_UTIL_EXPECT_EQ(kRouteCount,
+        GetContributingRouteCount("test", Address::INET));
+    BgpRoute *rt = RouteLookup<InetDefinition>("test.inet.0", "0.0.0.0/0");
+    ASSERT_TRUE(rt != NULL);
+    TASK_UTIL_EXPECT_TRUE(rt->BestPath() != NULL);
+    TASK_UTIL_EXPECT_TRUE(rt->BestPath()->IsFeasible());
+    TASK_UTIL_EXPECT_TRUE(IsContributingRoute<InetDefinition>("test",
+                                            "test.inet.0", "10.0.0.0/32"));
+    TASK_UTIL_EXPECT_EQ(0, GetUpdateAggregateListSize("test", Address::INET));
+
+    // Deleting all but one route does not remove the aggregate route.
+    EnqueueInetRoutes(peers_[0], "test.inet.0", first_addr, kRouteCount - 1,
+                      false);
+    task_util::WaitForIdle();
+
+    TASK_UTIL_EXPECT_EQ(1, GetContributingRouteCount("test", Address::INET));
+    TASK_UTIL_EXPECT_TRUE(IsAggregateRoute<InetDefinition>("test",
+                                           "test.inet.0", "0.0.0.0/0"));
+
+    EnqueueInetRoutes(peers_[0], "test.inet.0",
+        Ip4Address(first_addr.to_ulong() + kRouteCount - 1), 1, false);
+    task_util::WaitForIdle();
+    TASK_UTIL_EXPECT_EQ(0, GetContributingRouteCount("test", Address::INET));
+    TASK_UTIL_EXPECT_TRUE(
+        RouteLookup<InetDefinition>("test.inet.0", "0.0.0.0/0") == NULL);
+
+    DeleteRoute<InetDefinition>(peers_[0], "test.inet.0", "1.1.1.1/32");
+    task_util::WaitForIdle();
+}
+
 //
 // Validate the route aggregation functionality with inet6 default route
 // Add nexthop route and more specific route for aggregate prefix
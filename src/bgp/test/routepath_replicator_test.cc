@@ -380,6 +380,14 @@ protected:
         return replicator->GetReplicationState(table, rt);
     }
 
+    uint64_t GetReplicatedPathCount(const string &table_name) {
+        BgpTable *table = static_cast<BgpTable *>(
+            bgp_server_->database()->FindTable(table_name));
+        RoutePathReplicator *replicator =
+            bgp_server_->replicator(Address::INETVPN);
+        return replicator->GetReplicatedPathCount(table);
+    }
+
     const BgpRoute *GetVPNSecondary(const RtReplicated *rts) {
         BOOST_FOREACH(const RtReplicated::SecondaryRouteInfo rinfo,
                       rts->GetList()) {
@@ -626,6 +634,43 @@ TEST_F(ReplicationTest, PathImport) {
 
 }
 
+//
+// Verify that the count of replicated paths tracks secondary path changes.
+//
+TEST_F(ReplicationTest, ReplicatedPathCount) {
+    vector<string> instance_names = list_of("blue")("red")("green");
+    multimap<string, string> connections = map_list_of("blue", "red");
+    NetworkConfig(instance_names, connections);
+    task_util::WaitForIdle();
+
+    boost::system::error_code ec;
+    peers_.push_back(
+        new BgpPeerMock(Ip4Address::from_string("192.168.0.1", ec)));
+
+    // Imported in both blue and red.
+    AddVPNRoute(peers_[0], "192.168.0.1:1:10.0.1.1/32", 100, list_of("blue"));
+    AddVPNRoute(peers_[0], "192.168.0.1:1:10.0.1.2/32", 100, list_of("blue"));
+    task_util::WaitForIdle();
+    VERIFY_EQ(2, RouteCount("blue"));
+    VERIFY_EQ(2, RouteCount("red"));
+    TASK_UTIL_EXPECT_EQ(4, GetReplicatedPathCount("bgp.l3vpn.0"));
+
+    // Imported only in green.
+    AddVPNRoute(peers_[0], "192.168.0.1:1:10.0.1.1/32", 100,
+                list_of("green"));
+    task_util::WaitForIdle();
+    VERIFY_EQ(1, RouteCount("green"));
+    TASK_UTIL_EXPECT_EQ(3, GetReplicatedPathCount("bgp.l3vpn.0"));
+
+    DeleteVPNRoute(peers_[0], "192.168.0.1:1:10.0.1.1/32");
+    DeleteVPNRoute(peers_[0], "192.168.0.1:1:10.0.1.2/32");
+    task_util::WaitForIdle();
+    VERIFY_EQ(0, RouteCount("blue"));
+    VERIFY_EQ(0, RouteCount("red"));
+    VERIFY_EQ(0, RouteCount("green"));
+    TASK_UTIL_EXPECT_EQ(0, GetReplicatedPathCount("bgp.l3vpn.0"));
+}
+
 TEST_F(ReplicationTest, NoExtCommunities) {
     vector<string> instance_names = list_of("blue")("red")("green");
     multimap<string, string> connections = map_list_of("blue", "red");
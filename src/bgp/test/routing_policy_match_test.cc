@@ -818,6 +818,38 @@ TEST_F(MatchCommunityTest, MatchAny3) {
     EXPECT_FALSE(match.Match(NULL, NULL, attr.get()));
 }
 
+// Verify that results are cached per interned community.
+TEST_F(MatchCommunityTest, Cache) {
+    vector<string> communities = list_of("33:.*")("53:11");
+    MatchCommunity match(communities, false);
+
+    CommunitySpec comm_spec;
+    comm_spec.communities.push_back(
+        CommunityType::CommunityFromString("33:22"));
+    BgpAttrSpec spec;
+    spec.push_back(&comm_spec);
+    BgpAttrPtr attr1 = attr_db_->Locate(spec);
+    comm_spec.communities[0] = CommunityType::CommunityFromString("43:22");
+    BgpAttrPtr attr2 = attr_db_->Locate(spec);
+
+    for (int idx = 0; idx < 3; ++idx) {
+        EXPECT_TRUE(match.Match(NULL, NULL, attr1.get()));
+        EXPECT_FALSE(match.Match(NULL, NULL, attr2.get()));
+    }
+    uint64_t hits = 0, misses = 0;
+    match.GetCacheStats(&hits, &misses);
+    EXPECT_EQ(4, hits);
+    EXPECT_EQ(2, misses);
+
+    // A copy of the attribute shares the interned community.
+    BgpAttr attr3(*attr1);
+    EXPECT_TRUE(match.Match(NULL, NULL, &attr3));
+    hits = misses = 0;
+    match.GetCacheStats(&hits, &misses);
+    EXPECT_EQ(5, hits);
+    EXPECT_EQ(2, misses);
+}
+
 // Parameterize match-all vs. match-any in MatchCommunity.
 class MatchCommunityParamTest:
     public MatchCommunityTest,
@@ -2071,6 +2103,64 @@ TYPED_TEST(MatchPrefixTest, Match) {
     EXPECT_FALSE(match.Match(&route8, NULL, NULL));
 }
 
+// Verify the compiled prefix match against a linear evaluation of the match
+// list for a large number of random prefixes.
+TYPED_TEST(MatchPrefixTest, CompiledMatch) {
+    const char *match_types[] = { "exact", "longer", "orlonger" };
+    PrefixMatchConfigList cfg_list;
+    srand(1);
+    for (int idx = 0; idx < 1000; ++idx) {
+        int plen = 16 + rand() % 9;
+        int octet = rand() % 256 & (0xFF << (24 - plen)) & 0xFF;
+        string address = "10." + integerToString(rand() % 4) + "." +
+            integerToString(octet) + ".0";
+        cfg_list.push_back(PrefixMatchConfig(
+            this->BuildPrefix(address, plen), match_types[rand() % 3]));
+    }
+    typename TestFixture::MatchPrefixT match(cfg_list);
+
+    vector<typename TestFixture::PrefixT> match_prefixes;
+    vector<string> match_type_strs;
+    for (size_t idx = 0; idx < cfg_list.size(); ++idx) {
+        match_prefixes.push_back(
+            TestFixture::PrefixT::FromString(cfg_list[idx].prefix_to_match));
+        match_type_strs.push_back(cfg_list[idx].prefix_match_type);
+    }
+
+    int matched = 0;
+    for (int idx = 0; idx < 10000; ++idx) {
+        string address = "10." + integerToString(rand() % 4) + "." +
+            integerToString(rand() % 256) + "." +
+            integerToString(rand() % 256);
+        typename TestFixture::PrefixT prefix =
+            TestFixture::PrefixT::FromString(
+                this->BuildPrefix(address, 16 + rand() % 17));
+        typename TestFixture::RouteT route(prefix);
+
+        bool result = match.Match(&route, NULL, NULL);
+        bool expected = false;
+        for (size_t pidx = 0; pidx < match_prefixes.size(); ++pidx) {
+            const typename TestFixture::PrefixT &match_prefix =
+                match_prefixes[pidx];
+            if (match_type_strs[pidx] == "exact") {
+                expected = (prefix == match_prefix);
+            } else if (match_type_strs[pidx] == "longer") {
+                expected = (prefix != match_prefix &&
+                            prefix.IsMoreSpecific(match_prefix));
+            } else {
+                expected = prefix.IsMoreSpecific(match_prefix);
+            }
+            if (expected)
+                break;
+        }
+
+        EXPECT_EQ(expected, result) << prefix.ToString();
+        if (result)
+            matched++;
+    }
+    EXPECT_LT(0, matched);
+}
+
 static void SetUp() {
     bgp_log_test::init();
     ControlNode::SetDefaultSchedulingPolicy();
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <map>
+#include <vector>
+
+#include "base/parse_object.h"
+#include "base/test/task_test_util.h"
+#include "bgp/bgp_log.h"
+#include "bgp/community.h"
+#include "bgp/routing-instance/rtarget_group_mgr.h"
+#include "bgp/security_group/security_group.h"
+#include "control-node/control_node.h"
+#include "testing/gunit.h"
+
+using std::map;
+using std::vector;
+
+class RtGroupInterestTest : public ::testing::Test {
+protected:
+    RtGroupInterestTest() : mgr_(NULL) {
+    }
+
+    virtual void TearDown() {
+        task_util::WaitForIdle();
+    }
+
+    RtGroupInterestIndex *index() { return &mgr_.interest_index_; }
+
+    void GetInterestedPeers(const ExtCommunity *ext_community,
+        RtGroupInterestedPeerSet *peer_set) {
+        mgr_.GetInterestedPeers(ext_community, peer_set);
+    }
+
+    static RouteTarget BuildRouteTarget(int idx) {
+        return RouteTarget(Ip4Address(0x0a000000 + idx / 4096), idx % 4096);
+    }
+
+    static RtGroupInterestedPeerSet BuildPeerSet(int idx, int peer_count) {
+        RtGroupInterestedPeerSet peer_set;
+        peer_set.set(idx % peer_count);
+        peer_set.set((idx * 7) % peer_count);
+        return peer_set;
+    }
+
+    RTargetGroupMgr mgr_;
+};
+
+//
+// Verify the index against a map with random updates and lookups of present
+// and absent RouteTargets.
+//
+TEST_F(RtGroupInterestTest, Index) {
+    const int kCount = 4 * RtGroupInterestIndex::kFilterSize;
+    map<uint64_t, RtGroupInterestedPeerSet> expected;
+    for (int idx = 0; idx < kCount; ++idx) {
+        RouteTarget rtarget = BuildRouteTarget(idx);
+        RtGroupInterestedPeerSet peer_set = BuildPeerSet(idx, 64);
+        index()->Update(rtarget, peer_set);
+        expected[rtarget.GetExtCommunityValue()] = peer_set;
+    }
+    EXPECT_EQ(expected.size(), index()->size());
+
+    // Change peers for every third RouteTarget and remove every other one.
+    for (int idx = 0; idx < kCount; idx += 3) {
+        RouteTarget rtarget = BuildRouteTarget(idx);
+        RtGroupInterestedPeerSet peer_set = BuildPeerSet(idx + 1, 64);
+        index()->Update(rtarget, peer_set);
+        expected[rtarget.GetExtCommunityValue()] = peer_set;
+    }
+    for (int idx = 0; idx < kCount; idx += 2) {
+        RouteTarget rtarget = BuildRouteTarget(idx);
+        index()->Update(rtarget, RtGroupInterestedPeerSet());
+        expected.erase(rtarget.GetExtCommunityValue());
+    }
+    EXPECT_EQ(expected.size(), index()->size());
+
+    // Lookups include RouteTargets that were never added.
+    for (int idx = 0; idx < 2 * kCount; ++idx) {
+        uint64_t value = BuildRouteTarget(idx).GetExtCommunityValue();
+        const RtGroupInterestedPeerSet *peer_set = index()->Find(value);
+        map<uint64_t, RtGroupInterestedPeerSet>::const_iterator loc =
+            expected.find(value);
+        if (loc == expected.end()) {
+            EXPECT_TRUE(peer_set == NULL);
+        } else {
+            ASSERT_TRUE(peer_set != NULL);
+            EXPECT_TRUE(*peer_set == loc->second);
+        }
+    }
+
+    for (int idx = 1; idx < kCount; idx += 2) {
+        index()->Update(BuildRouteTarget(idx), RtGroupInterestedPeerSet());
+    }
+    EXPECT_EQ(0, index()->size());
+}
+
+//
+// Verify that interested peers for the null RouteTarget and all RouteTargets
+// of the route are included and other extended communities are ignored.
+//
+TEST_F(RtGroupInterestTest, InterestedPeers) {
+    RtGroupInterestedPeerSet null_peers;
+    null_peers.set(1);
+    index()->Update(RouteTarget::null_rtarget, null_peers);
+    for (int idx = 0; idx < 4; ++idx) {
+        RtGroupInterestedPeerSet peer_set;
+        peer_set.set(10 + idx);
+        index()->Update(BuildRouteTarget(idx), peer_set);
+    }
+
+    ExtCommunitySpec spec;
+    spec.communities.push_back(
+        get_value(BuildRouteTarget(1).GetExtCommunity().begin(), 8));
+    spec.communities.push_back(
+        get_value(BuildRouteTarget(3).GetExtCommunity().begin(), 8));
+    spec.communities.push_back(
+        get_value(BuildRouteTarget(100).GetExtCommunity().begin(), 8));
+    SecurityGroup sg(64512, 11);
+    spec.communities.push_back(get_value(sg.GetExtCommunity().begin(), 8));
+    ExtCommunity ext_community(NULL, spec);
+
+    RtGroupInterestedPeerSet peer_set;
+    GetInterestedPeers(&ext_community, &peer_set);
+    RtGroupInterestedPeerSet expected;
+    expected.set(1);
+    expected.set(11);
+    expected.set(13);
+    EXPECT_TRUE(expected == peer_set);
+
+    index()->Update(RouteTarget::null_rtarget, RtGroupInterestedPeerSet());
+    for (int idx = 0; idx < 4; ++idx) {
+        index()->Update(BuildRouteTarget(idx), RtGroupInterestedPeerSet());
+    }
+    peer_set = RtGroupInterestedPeerSet();
+    GetInterestedPeers(&ext_community, &peer_set);
+    EXPECT_TRUE(peer_set.empty());
+}
+
+//
+// Verify interested peers for routes with 5-20 RouteTargets each against
+// looking up a map of RouteTargets, which is what looking up a RtGroup for
+// every RouteTarget of the route does.
+//
+TEST_F(RtGroupInterestTest, InterestedPeersMap) {
+    const int kRouteTargetCount = 2000;
+    const int kRouteCount = 1000;
+    const int kPeerCount = 128;
+
+    // Half the RouteTargets have interested peers.
+    map<RouteTarget, RtGroupInterestedPeerSet> rtgroup_map;
+    for (int idx = 0; idx < kRouteTargetCount; idx += 2) {
+        RouteTarget rtarget = BuildRouteTarget(idx);
+        RtGroupInterestedPeerSet peer_set = BuildPeerSet(idx, kPeerCount);
+        index()->Update(rtarget, peer_set);
+        rtgroup_map[rtarget] = peer_set;
+    }
+
+    vector<ExtCommunity *> ext_communities;
+    for (int idx = 0; idx < kRouteCount; ++idx) {
+        ExtCommunitySpec spec;
+        int rtarget_count = 5 + idx % 16;
+        for (int rt_idx = 0; rt_idx < rtarget_count; ++rt_idx) {
+            int rtarget_idx = (idx * 31 + rt_idx * 997) % kRouteTargetCount;
+            spec.communities.push_back(get_value(
+                BuildRouteTarget(rtarget_idx).GetExtCommunity().begin(), 8));
+        }
+        ext_communities.push_back(new ExtCommunity(NULL, spec));
+    }
+
+    for (size_t idx = 0; idx < ext_communities.size(); ++idx) {
+        const ExtCommunity *ext_community = ext_communities[idx];
+        RtGroupInterestedPeerSet map_peer_set;
+        for (ExtCommunity::ExtCommunityList::const_iterator it =
+             ext_community->communities().begin();
+             it != ext_community->communities().end(); ++it) {
+            if (!ExtCommunity::is_route_target(*it))
+                continue;
+            map<RouteTarget, RtGroupInterestedPeerSet>::const_iterator loc =
+                rtgroup_map.find(RouteTarget(*it));
+            if (loc != rtgroup_map.end())
+                map_peer_set |= loc->second;
+        }
+
+        RtGroupInterestedPeerSet index_peer_set;
+        GetInterestedPeers(ext_community, &index_peer_set);
+        EXPECT_TRUE(map_peer_set == index_peer_set);
+    }
+
+    for (int idx = 0; idx < kRouteTargetCount; idx += 2) {
+        index()->Update(BuildRouteTarget(idx), RtGroupInterestedPeerSet());
+    }
+    EXPECT_EQ(0, index()->size());
+    STLDeleteValues(&ext_communities);
+}
+
+static void SetUp() {
+    bgp_log_test::init();
+    ControlNode::SetDefaultSchedulingPolicy();
+}
+
+static void TearDown() {
+    task_util::WaitForIdle();
+    TaskScheduler *scheduler = TaskScheduler::GetInstance();
+    scheduler->Terminate();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    SetUp();
+    int result = RUN_ALL_TESTS();
+    TearDown();
+    return result;
+}
@@ -4292,6 +4292,92 @@ TYPED_TEST(ServiceChainTest, ExtConnectedEcmpPaths) {
 }
 
 
+//
+// Connected route changes that are queued back to back result in a single
+// update of the service chain routes.
+//
+TYPED_TEST(ServiceChainTest, ExtConnectedEcmpPathsCoalesced) {
+    vector<string> instance_names = list_of("blue")("blue-i1")("red-i2")("red");
+    multimap<string, string> connections =
+        map_list_of("blue", "blue-i1") ("red-i2", "red");
+    this->NetworkConfig(instance_names, connections);
+    this->VerifyNetworkConfig(instance_names);
+
+    this->SetServiceChainInformation("blue-i1",
+        "controller/src/bgp/testdata/service_chain_1.xml");
+
+    // Add MX leaked route
+    this->AddRoute(NULL, "red", this->BuildPrefix("10.10.1.0", 24), 100);
+
+    // Add Connected
+    this->AddConnectedRoute(this->peers_[0], this->BuildConnPrefix("1.1.2.3", 32),
+                            100, this->BuildNextHopAddress("2.3.0.5"));
+    this->VerifyRouteAttributes("blue", this->BuildPrefix("10.10.1.0", 24),
+                                this->BuildNextHopAddress("2.3.0.5"), "red");
+
+    RoutingInstance *rtinstance =
+        this->bgp_server_->routing_instance_mgr()->GetRoutingInstance(
+            "blue-i1");
+    ShowServicechainInfo info;
+    EXPECT_TRUE(this->service_chain_mgr_->FillServiceChainInfo(rtinstance,
+                                                               &info));
+    uint64_t route_updates = info.get_route_updates();
+    uint64_t route_updates_coalesced = info.get_route_updates_coalesced();
+
+    // Add ECMP paths to the connected route with the queue disabled.
+    this->DisableServiceChainQ();
+    this->AddConnectedRoute(this->peers_[1], this->BuildConnPrefix("1.1.2.3", 32),
+                            100, this->BuildNextHopAddress("2.3.1.5"));
+    this->AddConnectedRoute(this->peers_[2], this->BuildConnPrefix("1.1.2.3", 32),
+                            100, this->BuildNextHopAddress("2.3.2.5"));
+    EXPECT_FALSE(this->IsServiceChainQEmpty());
+    this->EnableServiceChainQ();
+    TASK_UTIL_EXPECT_TRUE(this->IsServiceChainQEmpty());
+    task_util::WaitForIdle();
+
+    vector<string> path_ids = list_of(
+        this->BuildNextHopAddress("2.3.0.5"))
+        (this->BuildNextHopAddress("2.3.1.5"))
+        (this->BuildNextHopAddress("2.3.2.5"));
+    this->VerifyRouteAttributes("blue", this->BuildPrefix("10.10.1.0", 24),
+                                path_ids, "red");
+    this->VerifyRouteAttributes("blue",
+                                this->BuildReplicationPrefix("10.10.1.0", 24),
+                                path_ids, "red", true);
+
+    info = ShowServicechainInfo();
+    EXPECT_TRUE(this->service_chain_mgr_->FillServiceChainInfo(rtinstance,
+                                                               &info));
+    EXPECT_EQ(route_updates + 1, info.get_route_updates());
+    EXPECT_LE(route_updates_coalesced + 1, info.get_route_updates_coalesced());
+    EXPECT_EQ(0, info.get_queue_length());
+    EXPECT_LE(info.get_request_latency_avg_usecs(),
+              info.get_request_latency_max_usecs());
+
+    // Remove the ECMP paths with the queue disabled.
+    this->DisableServiceChainQ();
+    this->DeleteConnectedRoute(this->peers_[1],
+                               this->BuildConnPrefix("1.1.2.3", 32));
+    this->DeleteConnectedRoute(this->peers_[2],
+                               this->BuildConnPrefix("1.1.2.3", 32));
+    this->EnableServiceChainQ();
+    TASK_UTIL_EXPECT_TRUE(this->IsServiceChainQEmpty());
+    task_util::WaitForIdle();
+    this->VerifyRouteAttributes("blue", this->BuildPrefix("10.10.1.0", 24),
+                                this->BuildNextHopAddress("2.3.0.5"), "red");
+    this->VerifyRouteAttributes("blue",
+                                this->BuildReplicationPrefix("10.10.1.0", 24),
+                                this->BuildNextHopAddress("2.3.0.5"), "red", 0,
+                                true);
+
+    // Delete MX route
+    this->DeleteRoute(NULL, "red", this->BuildPrefix("10.10.1.0", 24));
+
+    // Delete connected route
+    this->DeleteConnectedRoute(this->peers_[0],
+                               this->BuildConnPrefix("1.1.2.3", 32));
+}
+
 TYPED_TEST(ServiceChainTest, ExtConnectedMoreSpecificEcmpPaths) {
     vector<string> instance_names = list_of("blue")("blue-i1")("red-i2")("red");
     multimap<string, string> connections =
@@ -4,10 +4,13 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <algorithm>
+
 #include "bgp/bgp_factory.h"
 #include "bgp/bgp_ribout.h"
 #include "bgp/bgp_ribout_updates.h"
 #include "bgp/xmpp_message_builder.h"
+#include "bgp/evpn/evpn_route.h"
 #include "bgp/inet/inet_route.h"
 #include "bgp/mvpn/mvpn_route.h"
 #include "bgp/security_group/security_group.h"
@@ -133,6 +136,7 @@ protected:
     }
 
     virtual void TearDown() {
+        BgpXmppMessage::SetItemTemplateEnabled(true);
         STLDeleteValues(&roattrs_);
         STLDeleteValues(&routes_);
         table_->RibOutDelete(
@@ -143,6 +147,32 @@ protected:
         task_util::WaitForIdle();
     }
 
+    // Build a message with the routes and return its size.
+    template <typename RouteT>
+    static size_t BuildMessage(Message *message, RibOut *ribout,
+                               const vector<RouteT *> &routes,
+                               const vector<RibOutAttr *> &roattrs,
+                               string *msg_str) {
+        message->Start(ribout, false, roattrs[0], routes[0]);
+        for (size_t ridx = 1; ridx < routes.size(); ++ridx) {
+            message->AddRoute(routes[ridx], roattrs[ridx]);
+        }
+        message->Finish();
+
+        XmppTestPeer peer("agent.juniper.net");
+        size_t msgsize;
+        const string *str = NULL;
+        string temp;
+        const uint8_t *msg = message->GetData(&peer, &msgsize, &str, &temp);
+        if (msg_str)
+            msg_str->assign(reinterpret_cast<const char *>(msg), msgsize);
+        return msgsize;
+    }
+
+    size_t BuildMessage(string *msg_str) {
+        return BuildMessage(message_, ribout_, routes_, roattrs_, msg_str);
+    }
+
     EventManager evm_;
     ServerThread thread_;
     BgpServerTestPtr bs_x_;
@@ -266,6 +296,64 @@ TEST_P(XmppMessageBuilderParamTest, Basic) {
     }
 }
 
+// Items built from templates should be the same as the ones encoded through
+// the xml document.
+TEST_F(XmppMessageBuilderTest, ItemTemplate) {
+    string dom_msg, template_msg;
+    BgpXmppMessage::SetItemTemplateEnabled(false);
+    BuildMessage(&dom_msg);
+    BgpXmppMessage::SetItemTemplateEnabled(true);
+    BuildMessage(&template_msg);
+    EXPECT_EQ(dom_msg, template_msg);
+    EXPECT_TRUE(VerifySG(reinterpret_cast<const uint8_t *>(
+        template_msg.c_str()), template_msg.size(), 0x123));
+
+    // Once more, now that the template is cached in the attribute.
+    BuildMessage(&template_msg);
+    EXPECT_EQ(dom_msg, template_msg);
+}
+
+// Evpn routes with and without an ethernet tag use different templates, so
+// each item gets its own tag irrespective of the order of the routes.
+TEST_F(XmppMessageBuilderTest, EnetItemTemplate) {
+    BgpTable *table = static_cast<BgpTable *>(
+        bs_x_->database()->FindTable("blue.evpn.0"));
+    ASSERT_TRUE(table != NULL);
+    RibExportPolicy policy(BgpProto::XMPP, RibExportPolicy::XMPP, -1, 0);
+    RibOut *ribout = table->RibOutLocate(bs_x_->update_sender(), policy);
+    Message *message = ribout->updates(0)->GetMessage();
+
+    RouteDistinguisher rd(RouteDistinguisher::FromString("192.168.0.1:1"));
+    MacAddress mac(MacAddress::FromString("00:01:02:03:04:05"));
+    IpAddress ip(IpAddress::from_string("10.1.1.1"));
+    vector<EvpnRoute *> routes;
+    routes.push_back(new EvpnRoute(EvpnPrefix(rd, 0, mac, ip)));
+    routes.push_back(new EvpnRoute(EvpnPrefix(rd, 100, mac, ip)));
+    vector<RibOutAttr *> roattrs;
+    roattrs.push_back(new RibOutAttr(table, attr_.get(), 200, 0, true));
+    roattrs.push_back(new RibOutAttr(table, attr_.get(), 200, 0, true));
+
+    for (int idx = 0; idx < 2; ++idx) {
+        string dom_msg, template_msg;
+        BgpXmppMessage::SetItemTemplateEnabled(false);
+        BuildMessage(message, ribout, routes, roattrs, &dom_msg);
+        BgpXmppMessage::SetItemTemplateEnabled(true);
+        BuildMessage(message, ribout, routes, roattrs, &template_msg);
+        EXPECT_EQ(dom_msg, template_msg);
+        EXPECT_NE(string::npos,
+            template_msg.find("<ethernet-tag>0</ethernet-tag>"));
+        EXPECT_NE(string::npos,
+            template_msg.find("<ethernet-tag>100</ethernet-tag>"));
+
+        // Once more with the routes in the reverse order.
+        std::reverse(routes.begin(), routes.end());
+    }
+
+    STLDeleteValues(&roattrs);
+    STLDeleteValues(&routes);
+    table->RibOutDelete(policy);
+}
+
 class XmppMvpnMessageBuilderParamTest:
     public XmppMvpnMessageBuilderTest,
     public ::testing::WithParamInterface<TestParams> {
@@ -6,9 +6,13 @@
 
 #include <boost/foreach.hpp>
 
+#include <stdio.h>
+#include <string.h>
+
 #include <algorithm>
 
 #include "bgp/ipeer.h"
+#include "bgp/bgp_config.h"
 #include "bgp/bgp_server.h"
 #include "bgp/bgp_table.h"
 #include "bgp/extended-community/etree.h"
@@ -31,10 +35,68 @@ using pugi::xml_node;
 using std::ostringstream;
 using std::copy;
 using std::fill;
+using std::make_pair;
+using std::pair;
+using std::sort;
 using std::string;
 using std::stringstream;
 using std::vector;
 
+//
+// An item template is the xml for an item in which each route specific field
+// is replaced with a marker byte followed by the ItemField. The marker can't
+// otherwise show up in the output as pugixml escapes control characters.
+//
+// The template starts with a header containing the server state that went
+// into the encoding of the attribute, i.e. the AS number that qualifies the
+// security groups and whether all tags are global. A template that doesn't
+// match the current state is not used.
+//
+// The template is built by encoding the item with sentinel values for the
+// route specific fields and looking for the sentinels in the output. The
+// string sentinels can't collide with real values as they aren't valid in
+// any of the fields that make up the item. The numeric sentinels are larger
+// than any label or ethernet tag, but must still show up exactly once.
+//
+static const uint8_t kItemTemplateMarker = 0x01;
+static const size_t kItemTemplateHeaderSize = 5;
+static const uint32_t kItemNumericSentinel = 0x7FFF0000;
+
+bool BgpXmppMessage::item_template_enabled_ = true;
+
+static inline bool NeedsXmlEscape(const string &value) {
+    for (string::const_iterator it = value.begin(); it != value.end(); ++it) {
+        unsigned char c = *it;
+        if (c < 0x20 || c == '&' || c == '<' || c == '>' || c == '"' ||
+            c == '\'') {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool IsDigit(const string &str, size_t pos) {
+    return pos < str.size() && str[pos] >= '0' && str[pos] <= '9';
+}
+
+static void GetItemTemplateHeader(const BgpTable *table, uint8_t *header) {
+    const BgpServer *server = table->server();
+    as_t as_number = server->autonomous_system();
+    header[0] = (as_number >> 24) & 0xFF;
+    header[1] = (as_number >> 16) & 0xFF;
+    header[2] = (as_number >> 8) & 0xFF;
+    header[3] = as_number & 0xFF;
+    header[4] = server->global_config()->all_tags_are_global();
+}
+
+static bool MatchItemTemplateHeader(const BgpTable *table,
+    const BgpAttr::Encoding &encoding) {
+    uint8_t header[kItemTemplateHeaderSize];
+    GetItemTemplateHeader(table, header);
+    return encoding.size() > kItemTemplateHeaderSize &&
+        memcmp(header, encoding.data(), kItemTemplateHeaderSize) == 0;
+}
+
 static inline const char *AfiName(uint16_t afi) {
     switch (afi) {
     case BgpAf::IPv4:
@@ -169,8 +231,9 @@ bool BgpXmppMessage::AddRoute(const BgpRoute *route, const RibOutAttr *roattr) {
     }
 }
 
-void BgpXmppMessage::EncodeNextHop(const BgpRoute *route,
-                                   const RibOutAttr::NextHop &nexthop,
+void BgpXmppMessage::EncodeNextHop(const RibOutAttr::NextHop &nexthop,
+                                   uint32_t label,
+                                   const string &virtual_network,
                                    autogen::ItemType *item) {
     autogen::NextHopType item_nexthop;
 
@@ -182,8 +245,8 @@ void BgpXmppMessage::EncodeNextHop(const BgpRoute *route,
         item_nexthop.af = BgpAf::IPv6;
         item_nexthop.address = address.to_v6().to_string();
     }
-    item_nexthop.label = nexthop.label();
-    item_nexthop.virtual_network = GetVirtualNetwork(nexthop);
+    item_nexthop.label = label;
+    item_nexthop.virtual_network = virtual_network;
     item_nexthop.tag_list.tag = nexthop.tag_list();
     item_nexthop.is_new_tags_list = true;
 
@@ -202,20 +265,35 @@ void BgpXmppMessage::EncodeNextHop(const BgpRoute *route,
     item->entry.next_hops.next_hop.push_back(item_nexthop);
 }
 
-void BgpXmppMessage::AddIpReach(const BgpRoute *route,
-                                const RibOutAttr *roattr) {
-    if (!roattr->repr().empty()) {
-        repr_ += roattr->repr();
-        return;
-    }
+void BgpXmppMessage::FillIpItemValues(const BgpRoute *route,
+    const RibOutAttr *roattr, ItemValues *values) const {
+    assert(!roattr->nexthop_list().empty());
+    values->id = route->ToXmppIdString();
+    values->address = route->ToString();
+    values->virtual_network = GetVirtualNetwork(route, roattr);
+    values->mac.clear();
+    values->source.clear();
+    values->group.clear();
+    values->ethernet_tag = 0;
+    values->label = roattr->nexthop_list().front().label();
+    values->l3_label = 0;
+}
+
+//
+// Encode the item through the xml document and print it to the writer. The
+// route specific fields are taken from values so that this can be used to
+// build an item template as well.
+//
+void BgpXmppMessage::EncodeIpItem(const RibOutAttr *roattr,
+    const ItemValues &values, XmlWriter *writer) {
     Address::Family family = table_->family();
 
     autogen::ItemType item;
     item.entry.nlri.af = BgpAf::FamilyToAfi(family);
     item.entry.nlri.safi = BgpAf::FamilyToXmppSafi(family);
-    item.entry.nlri.address = route->ToString();
+    item.entry.nlri.address = values.address;
     item.entry.version = 1;
-    item.entry.virtual_network = GetVirtualNetwork(route, roattr);
+    item.entry.virtual_network = values.virtual_network;
     item.entry.local_preference = roattr->attr()->local_pref();
     item.entry.med = roattr->attr()->med();
     item.entry.sequence_number = mobility_.sequence_number;
@@ -224,9 +302,16 @@ void BgpXmppMessage::AddIpReach(const BgpRoute *route,
 
     assert(!roattr->nexthop_list().empty());
 
-    // Encode all next-hops in the list.
+    // Encode all next-hops in the list. The virtual network of the first
+    // next-hop is the same as that of the entry.
     BOOST_FOREACH(const RibOutAttr::NextHop &nexthop, roattr->nexthop_list()) {
-        EncodeNextHop(route, nexthop, &item);
+        if (&nexthop == &roattr->nexthop_list().front()) {
+            EncodeNextHop(nexthop, values.label, values.virtual_network,
+                &item);
+        } else {
+            EncodeNextHop(nexthop, nexthop.label(),
+                GetVirtualNetwork(nexthop), &item);
+        }
     }
 
     for (vector<int>::const_iterator it = security_group_list_.begin();
@@ -243,16 +328,34 @@ void BgpXmppMessage::AddIpReach(const BgpRoute *route,
     if (!load_balance_attribute_.IsDefault())
         load_balance_attribute_.Encode(&item.entry.load_balance);
 
-    xml_node node = doc_.append_child("item");
-    node.append_attribute("id") = route->ToXmppIdString().c_str();
-
-    // Remember the previous size.
     // Using remove_child instead of reset allows memory pages allocated for
     // the xml_document to be reused during the lifetime of the xml_document.
-    size_t pos = repr_.size();
+    xml_node node = doc_.append_child("item");
+    node.append_attribute("id") = values.id.c_str();
     item.Encode(&node);
-    doc_.print(writer_, "\t", pugi::format_default, pugi::encoding_auto, 3);
+    doc_.print(*writer, "\t", pugi::format_default, pugi::encoding_auto, 3);
     doc_.remove_child(node);
+}
+
+void BgpXmppMessage::AddIpReach(const BgpRoute *route,
+                                const RibOutAttr *roattr) {
+    if (!roattr->repr().empty()) {
+        repr_ += roattr->repr();
+        return;
+    }
+
+    FillIpItemValues(route, roattr, &item_values_);
+    int flags = 0;
+    if (table_->family() == Address::INET6)
+        flags |= kIpItemInet6;
+    if (!item_values_.label)
+        flags |= kIpItemNoLabel;
+    int variant = kIpItemVariant + flags;
+
+    // Remember the previous size.
+    size_t pos = repr_.size();
+    if (!AddItemFromTemplate(route, roattr, variant, item_values_))
+        EncodeIpItem(roattr, item_values_, &writer_);
 
     // Cache the substring starting at the previous size.
     if (cache_routes_)
@@ -287,15 +390,15 @@ bool BgpXmppMessage::AddInet6Route(const BgpRoute *route,
     return true;
 }
 
-void BgpXmppMessage::EncodeEnetNextHop(const BgpRoute *route,
-                                       const RibOutAttr::NextHop &nexthop,
+void BgpXmppMessage::EncodeEnetNextHop(const RibOutAttr::NextHop &nexthop,
+                                       uint32_t label, uint32_t l3_label,
                                        autogen::EnetItemType *item) {
     autogen::EnetNextHopType item_nexthop;
 
     item_nexthop.af = BgpAf::IPv4;
     item_nexthop.address = nexthop.address().to_v4().to_string();
-    item_nexthop.label = nexthop.label();
-    item_nexthop.l3_label = nexthop.l3_label();
+    item_nexthop.label = label;
+    item_nexthop.l3_label = l3_label;
     if (!nexthop.mac().IsZero())
         item_nexthop.mac = nexthop.mac().ToString();
 
@@ -312,29 +415,47 @@ void BgpXmppMessage::EncodeEnetNextHop(const BgpRoute *route,
     item->entry.next_hops.next_hop.push_back(item_nexthop);
 }
 
-void BgpXmppMessage::AddEnetReach(const BgpRoute *route,
-                                  const RibOutAttr *roattr) {
-    if (!roattr->repr().empty()) {
-        repr_ += roattr->repr();
-        return;
+void BgpXmppMessage::FillEnetItemValues(const BgpRoute *route,
+    const RibOutAttr *roattr, ItemValues *values) const {
+    EvpnRoute *evpn_route =
+        static_cast<EvpnRoute *>(const_cast<BgpRoute *>(route));
+    const EvpnPrefix &evpn_prefix = evpn_route->GetPrefix();
+    values->id = route->ToXmppIdString();
+    values->address = evpn_prefix.ip_address().to_string() + "/" +
+        integerToString(evpn_prefix.ip_address_length());
+    values->virtual_network = GetVirtualNetwork(route, roattr);
+    values->mac = evpn_prefix.mac_addr().ToString();
+    values->source = evpn_prefix.source().to_string();
+    values->group = evpn_prefix.group().to_string();
+    values->ethernet_tag = evpn_prefix.tag();
+    if (roattr->nexthop_list().empty()) {
+        values->label = 0;
+        values->l3_label = 0;
+    } else {
+        values->label = roattr->nexthop_list().front().label();
+        values->l3_label = roattr->nexthop_list().front().l3_label();
     }
+}
+
+//
+// Encode the item through the xml document and print it to the writer. The
+// route specific fields are taken from values so that this can be used to
+// build an item template as well.
+//
+void BgpXmppMessage::EncodeEnetItem(const BgpRoute *route,
+    const RibOutAttr *roattr, const ItemValues &values, XmlWriter *writer) {
     Address::Family family = table_->family();
 
     autogen::EnetItemType item;
     item.entry.nlri.af = BgpAf::FamilyToAfi(family);
     item.entry.nlri.safi = BgpAf::FamilyToXmppSafi(family);
+    item.entry.nlri.ethernet_tag = values.ethernet_tag;
+    item.entry.nlri.mac = values.mac;
+    item.entry.nlri.address = values.address;
+    item.entry.nlri.source = values.source;
+    item.entry.nlri.group = values.group;
 
-    EvpnRoute *evpn_route =
-        static_cast<EvpnRoute *>(const_cast<BgpRoute *>(route));
-    const EvpnPrefix &evpn_prefix = evpn_route->GetPrefix();
-    item.entry.nlri.ethernet_tag = evpn_prefix.tag();
-    item.entry.nlri.mac = evpn_prefix.mac_addr().ToString();
-    item.entry.nlri.address = evpn_prefix.ip_address().to_string() + "/" +
-        integerToString(evpn_prefix.ip_address_length());
-    item.entry.nlri.source = evpn_prefix.source().to_string();
-    item.entry.nlri.group = evpn_prefix.group().to_string();
-
-    item.entry.virtual_network = GetVirtualNetwork(route, roattr);
+    item.entry.virtual_network = values.virtual_network;
     item.entry.local_preference = roattr->attr()->local_pref();
     item.entry.med = roattr->attr()->med();
     item.entry.sequence_number = mobility_.sequence_number;
@@ -378,23 +499,52 @@ void BgpXmppMessage::AddEnetReach(const BgpRoute *route,
     }
 
     BOOST_FOREACH(const RibOutAttr::NextHop &nexthop, roattr->nexthop_list()) {
-        EncodeEnetNextHop(route, nexthop, &item);
+        if (&nexthop == &roattr->nexthop_list().front()) {
+            EncodeEnetNextHop(nexthop, values.label, values.l3_label, &item);
+        } else {
+            EncodeEnetNextHop(nexthop, nexthop.label(), nexthop.l3_label(),
+                &item);
+        }
     }
 
     for (const auto &peer_name : route->peer_sources()) {
         item.entry.peers.peer.push_back(peer_name);
     }
 
-    xml_node node = doc_.append_child("item");
-    node.append_attribute("id") = route->ToXmppIdString().c_str();
-
-    // Remember the previous size.
     // Using remove_child instead of reset allows memory pages allocated for
     // the xml_document to be reused during the lifetime of the xml_document.
-    size_t pos = repr_.size();
+    xml_node node = doc_.append_child("item");
+    node.append_attribute("id") = values.id.c_str();
     item.Encode(&node);
-    doc_.print(writer_, "\t", pugi::format_default, pugi::encoding_auto, 3);
+    doc_.print(*writer, "\t", pugi::format_default, pugi::encoding_auto, 3);
     doc_.remove_child(node);
+}
+
+void BgpXmppMessage::AddEnetReach(const BgpRoute *route,
+                                  const RibOutAttr *roattr) {
+    if (!roattr->repr().empty()) {
+        repr_ += roattr->repr();
+        return;
+    }
+
+    FillEnetItemValues(route, roattr, &item_values_);
+    int flags = 0;
+    if (!item_values_.label)
+        flags |= kEnetItemNoLabel;
+    if (!item_values_.l3_label)
+        flags |= kEnetItemNoL3Label;
+    if (!item_values_.ethernet_tag)
+        flags |= kEnetItemNoEthernetTag;
+    int variant = kEnetItemVariant + flags;
+
+    // Remember the previous size.
+    // The list of peers is specific to the route, so the template is not
+    // used when there are any.
+    size_t pos = repr_.size();
+    if (!route->peer_sources().empty() ||
+        !AddItemFromTemplate(route, roattr, variant, item_values_)) {
+        EncodeEnetItem(route, roattr, item_values_, &writer_);
+    }
 
     // Cache the substring starting at the previous size.
     if (cache_routes_)
@@ -527,6 +677,183 @@ bool BgpXmppMessage::AddMvpnRoute(const BgpRoute *route,
     return true;
 }
 
+//
+// Add the item for the route by filling in the route specific fields in the
+// template for the attribute. The template is built when the attribute is
+// first used for the variant and is kept in the BgpAttr.
+//
+// Return false if the item needs to be encoded through the xml document.
+// This is the case for routes with more than one nexthop, since only the
+// first one is built from the BgpAttr, and for values that would have to
+// be escaped.
+//
+bool BgpXmppMessage::AddItemFromTemplate(const BgpRoute *route,
+    const RibOutAttr *roattr, int variant, const ItemValues &values) {
+    if (!item_template_enabled_ || roattr->nexthop_list().size() > 1)
+        return false;
+    if (NeedsXmlEscape(values.id) || NeedsXmlEscape(values.address) ||
+        NeedsXmlEscape(values.virtual_network) || NeedsXmlEscape(values.mac) ||
+        NeedsXmlEscape(values.source) || NeedsXmlEscape(values.group)) {
+        return false;
+    }
+
+    assert(variant >= 0 && variant < kItemVariantCount);
+    assert(BgpAttr::kXmppEncodingVariantBase + kItemVariantCount <=
+           BgpAttr::kEncodingVariantCount);
+    const BgpAttr *attr = roattr->attr();
+    int index = BgpAttr::kXmppEncodingVariantBase + variant;
+    const BgpAttr::Encoding *encoding = attr->GetEncoding(index);
+    if (!encoding) {
+        encoding = attr->SetEncoding(index,
+            BuildItemTemplate(route, roattr, variant, values));
+    }
+    if (!MatchItemTemplateHeader(table_, *encoding))
+        return false;
+
+    const uint8_t *data = encoding->data() + kItemTemplateHeaderSize;
+    const uint8_t *end = encoding->data() + encoding->size();
+    while (data < end) {
+        const uint8_t *marker = static_cast<const uint8_t *>(
+            memchr(data, kItemTemplateMarker, end - data));
+        if (!marker) {
+            repr_.append(reinterpret_cast<const char *>(data), end - data);
+            break;
+        }
+        repr_.append(reinterpret_cast<const char *>(data), marker - data);
+        AppendItemField(static_cast<ItemField>(marker[1]), values);
+        data = marker + 2;
+    }
+    return true;
+}
+
+//
+// Build the template for the item with the given values. Return a template
+// with just the header, which never matches, if any of the sentinels can't
+// be found in the encoded item. This prevents repeated attempts to build a
+// template for the same attribute.
+//
+BgpAttr::Encoding *BgpXmppMessage::BuildItemTemplate(const BgpRoute *route,
+    const RibOutAttr *roattr, int variant, const ItemValues &values) {
+    ItemValues sentinels;
+    string *strings[] = {
+        &sentinels.id, &sentinels.address, &sentinels.virtual_network,
+        &sentinels.mac, &sentinels.source, &sentinels.group
+    };
+    const string *value_strings[] = {
+        &values.id, &values.address, &values.virtual_network,
+        &values.mac, &values.source, &values.group
+    };
+    for (int field = ITEM_ID; field <= ITEM_GROUP; ++field) {
+        if (!value_strings[field]->empty())
+            *strings[field] = "@@" + integerToString(field) + "@@";
+    }
+    if (values.ethernet_tag)
+        sentinels.ethernet_tag = kItemNumericSentinel + ITEM_ETHERNET_TAG;
+    if (values.label)
+        sentinels.label = kItemNumericSentinel + ITEM_LABEL;
+    if (values.l3_label)
+        sentinels.l3_label = kItemNumericSentinel + ITEM_L3_LABEL;
+
+    string repr;
+    XmlWriter writer(&repr);
+    if (variant >= kEnetItemVariant) {
+        EncodeEnetItem(route, roattr, sentinels, &writer);
+    } else {
+        EncodeIpItem(roattr, sentinels, &writer);
+    }
+
+    // Find all the sentinels, remembering the position and the length.
+    uint8_t header[kItemTemplateHeaderSize];
+    GetItemTemplateHeader(table_, header);
+    BgpAttr::Encoding *encoding =
+        new BgpAttr::Encoding(header, header + kItemTemplateHeaderSize);
+    vector<pair<size_t, pair<size_t, int> > > holes;
+    for (int field = ITEM_ID; field < ITEM_FIELD_COUNT; ++field) {
+        string sentinel;
+        bool numeric = field > ITEM_GROUP;
+        if (numeric) {
+            uint32_t value = (field == ITEM_ETHERNET_TAG) ?
+                sentinels.ethernet_tag : (field == ITEM_LABEL) ?
+                sentinels.label : sentinels.l3_label;
+            if (!value)
+                continue;
+            sentinel = integerToString(value);
+        } else {
+            sentinel = *strings[field];
+            if (sentinel.empty())
+                continue;
+        }
+
+        size_t count = 0;
+        for (size_t pos = repr.find(sentinel); pos != string::npos;
+             pos = repr.find(sentinel, pos + sentinel.size())) {
+            if (numeric && ((pos > 0 && IsDigit(repr, pos - 1)) ||
+                IsDigit(repr, pos + sentinel.size()))) {
+                continue;
+            }
+            holes.push_back(
+                make_pair(pos, make_pair(sentinel.size(), field)));
+            count++;
+        }
+        if (count == 0 || (numeric && count > 1))
+            return encoding;
+    }
+
+    // Copy the xml between the sentinels and a marker for each sentinel.
+    sort(holes.begin(), holes.end());
+    size_t start = 0;
+    for (size_t idx = 0; idx < holes.size(); ++idx) {
+        encoding->insert(encoding->end(), repr.begin() + start,
+            repr.begin() + holes[idx].first);
+        encoding->push_back(kItemTemplateMarker);
+        encoding->push_back(holes[idx].second.second);
+        start = holes[idx].first + holes[idx].second.first;
+    }
+    encoding->insert(encoding->end(), repr.begin() + start, repr.end());
+    return encoding;
+}
+
+void BgpXmppMessage::AppendItemField(ItemField field,
+    const ItemValues &values) {
+    uint32_t value = 0;
+    switch (field) {
+    case ITEM_ID:
+        repr_ += values.id;
+        return;
+    case ITEM_ADDRESS:
+        repr_ += values.address;
+        return;
+    case ITEM_VIRTUAL_NETWORK:
+        repr_ += values.virtual_network;
+        return;
+    case ITEM_MAC:
+        repr_ += values.mac;
+        return;
+    case ITEM_SOURCE:
+        repr_ += values.source;
+        return;
+    case ITEM_GROUP:
+        repr_ += values.group;
+        return;
+    case ITEM_ETHERNET_TAG:
+        value = values.ethernet_tag;
+        break;
+    case ITEM_LABEL:
+        value = values.label;
+        break;
+    case ITEM_L3_LABEL:
+        value = values.l3_label;
+        break;
+    case ITEM_FIELD_COUNT:
+        assert(false);
+        break;
+    }
+
+    char buffer[16];
+    int len = snprintf(buffer, sizeof(buffer), "%u", value);
+    repr_.append(buffer, len);
+}
+
 const uint8_t *BgpXmppMessage::GetData(IPeerUpdate *peer, size_t *lenp,
     const string **msg_str, string *temp) {
     // Build begin line that contains message opening tag with from and to
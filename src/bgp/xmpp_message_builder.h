@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "bgp/message_builder.h"
+#include "bgp/bgp_attr.h"
 #include "bgp/bgp_ribout.h"
 #include "bgp/extended-community/load_balance.h"
 
@@ -43,11 +44,60 @@ public:
                                    const std::string **msg_str,
                                    std::string *temp);
 
+    // Enable or disable encoding of items from templates cached in BgpAttr.
+    static void SetItemTemplateEnabled(bool enabled) {
+        item_template_enabled_ = enabled;
+    }
+    static bool item_template_enabled() { return item_template_enabled_; }
+
 private:
     static const size_t kMaxFromToLength = 192;
     static const uint32_t kMaxReachCount = 32;
     static const uint32_t kMaxUnreachCount = 256;
 
+    // Item template variants, relative to BgpAttr::kXmppEncodingVariantBase.
+    // The variant captures everything outside the attribute that changes
+    // the layout of the item. Inet and inet6 items use the 4 variants from
+    // kIpItemVariant and evpn items the 8 variants from kEnetItemVariant, in
+    // both cases offset by the flags for the item.
+    static const int kIpItemVariant = 0;
+    static const int kIpItemInet6 = 1 << 0;
+    static const int kIpItemNoLabel = 1 << 1;
+    static const int kEnetItemVariant = kIpItemVariant + 4;
+    static const int kEnetItemNoLabel = 1 << 0;
+    static const int kEnetItemNoL3Label = 1 << 1;
+    static const int kEnetItemNoEthernetTag = 1 << 2;
+    static const int kItemVariantCount = kEnetItemVariant + 8;
+
+    // Route specific fields of an inet, inet6 or evpn item. Everything else
+    // in the item is derived from the BgpAttr and the first nexthop, which
+    // is also built from the BgpAttr.
+    enum ItemField {
+        ITEM_ID,
+        ITEM_ADDRESS,
+        ITEM_VIRTUAL_NETWORK,
+        ITEM_MAC,
+        ITEM_SOURCE,
+        ITEM_GROUP,
+        ITEM_ETHERNET_TAG,
+        ITEM_LABEL,
+        ITEM_L3_LABEL,
+        ITEM_FIELD_COUNT
+    };
+
+    struct ItemValues {
+        ItemValues() : ethernet_tag(0), label(0), l3_label(0) { }
+        std::string id;
+        std::string address;
+        std::string virtual_network;
+        std::string mac;
+        std::string source;
+        std::string group;
+        uint32_t ethernet_tag;
+        uint32_t label;
+        uint32_t l3_label;
+    };
+
     class XmlWriter : public pugi::xml_writer {
     public:
         explicit XmlWriter(std::string *repr) : repr_(repr) { }
@@ -69,18 +119,26 @@ private:
     };
 
     virtual void Reset();
-    void EncodeNextHop(const BgpRoute *route,
-                       const RibOutAttr::NextHop &nexthop,
+    void EncodeNextHop(const RibOutAttr::NextHop &nexthop, uint32_t label,
+                       const std::string &virtual_network,
                        autogen::ItemType *item);
+    void FillIpItemValues(const BgpRoute *route, const RibOutAttr *roattr,
+                          ItemValues *values) const;
+    void EncodeIpItem(const RibOutAttr *roattr, const ItemValues &values,
+                      XmlWriter *writer);
     void AddIpReach(const BgpRoute *route, const RibOutAttr *roattr);
     void AddIpUnreach(const BgpRoute *route);
     bool AddInetRoute(const BgpRoute *route, const RibOutAttr *roattr);
 
     bool AddInet6Route(const BgpRoute *route, const RibOutAttr *roattr);
 
-    void EncodeEnetNextHop(const BgpRoute *route,
-                           const RibOutAttr::NextHop &nexthop,
+    void EncodeEnetNextHop(const RibOutAttr::NextHop &nexthop,
+                           uint32_t label, uint32_t l3_label,
                            autogen::EnetItemType *item);
+    void FillEnetItemValues(const BgpRoute *route, const RibOutAttr *roattr,
+                            ItemValues *values) const;
+    void EncodeEnetItem(const BgpRoute *route, const RibOutAttr *roattr,
+                        const ItemValues &values, XmlWriter *writer);
     void AddEnetReach(const BgpRoute *route, const RibOutAttr *roattr);
     void AddEnetUnreach(const BgpRoute *route);
     bool AddEnetRoute(const BgpRoute *route, const RibOutAttr *roattr);
@@ -93,6 +151,14 @@ private:
     void AddMvpnUnreach(const BgpRoute *route);
     bool AddMvpnRoute(const BgpRoute *route, const RibOutAttr *roattr);
 
+    bool AddItemFromTemplate(const BgpRoute *route, const RibOutAttr *roattr,
+                             int variant, const ItemValues &values);
+    BgpAttr::Encoding *BuildItemTemplate(const BgpRoute *route,
+                                         const RibOutAttr *roattr,
+                                         int variant,
+                                         const ItemValues &values);
+    void AppendItemField(ItemField field, const ItemValues &values);
+
     void ProcessCommunity(const Community *community);
     void ProcessExtCommunity(const ExtCommunity *ext_community);
     std::string GetVirtualNetwork(const RibOutAttr::NextHop &nexthop) const;
@@ -113,6 +179,9 @@ private:
     std::vector<int> security_group_list_;
     std::vector<std::string> community_list_;
     LoadBalance::LoadBalanceAttribute load_balance_attribute_;
+    ItemValues item_values_;
+
+    static bool item_template_enabled_;
 
     DISALLOW_COPY_AND_ASSIGN(BgpXmppMessage);
 };
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include "db/db_arena.h"
+
+#include <stdlib.h>
+#include <new>
+#include <vector>
+
+#include "base/task.h"
+#include "db/db_types.h"
+
+using std::vector;
+
+DBArena::Shard::Shard() {
+    for (size_t idx = 0; idx < kSizeClassCount; ++idx) {
+        slab_list[idx] = NULL;
+    }
+}
+
+DBArena::DBArena() : enabled_(true) {
+    // XXX To be used for debugging purposes only.
+    char *disable_str = getenv("DB_ARENA_DISABLE");
+    if (disable_str && strtol(disable_str, NULL, 0) != 0) {
+        enabled_ = false;
+    }
+}
+
+//
+// Objects may still be referenced during process exit, so the slabs are
+// deliberately not released here.
+//
+DBArena::~DBArena() {
+}
+
+DBArena *DBArena::GetInstance() {
+    static DBArena *arena = new DBArena();
+    return arena;
+}
+
+//
+// Shard 0 is used when not running in a task or when running in a task
+// that is not instance specific.
+//
+int DBArena::GetShardIndex() const {
+    Task *current = Task::Running();
+    if (!current || current->task_data_id() < 0)
+        return 0;
+    return 1 + current->task_data_id() % (kShardCount - 1);
+}
+
+void DBArena::LinkSlab(Shard *shard, Slab *slab) {
+    Slab *head = shard->slab_list[slab->index];
+    slab->prev = NULL;
+    slab->next = head;
+    if (head)
+        head->prev = slab;
+    shard->slab_list[slab->index] = slab;
+}
+
+void DBArena::UnlinkSlab(Shard *shard, Slab *slab) {
+    if (slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        shard->slab_list[slab->index] = slab->next;
+    }
+    if (slab->next)
+        slab->next->prev = slab->prev;
+    slab->prev = NULL;
+    slab->next = NULL;
+}
+
+//
+// Allocate a new slab for the shard and carve it into objects of the given
+// size class. Slabs are aligned to their size so that the slab of an object
+// can be found from its address.
+//
+DBArena::Slab *DBArena::AllocSlab(size_t index, int shard_index) {
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, kSlabSize, kSlabSize) != 0)
+        throw std::bad_alloc();
+    stats_[index].slabs++;
+
+    Slab *slab = static_cast<Slab *>(ptr);
+    slab->prev = NULL;
+    slab->next = NULL;
+    slab->free_list = NULL;
+    slab->index = index;
+    slab->shard = shard_index;
+    slab->objects_in_use = 0;
+
+    char *base = static_cast<char *>(ptr) + SlabHeaderSize();
+    size_t object_size = SizeClassObjectSize(index);
+    for (size_t idx = SlabObjectCount(index); idx > 0; --idx) {
+        FreeObject *object =
+            reinterpret_cast<FreeObject *>(base + (idx - 1) * object_size);
+        object->next = slab->free_list;
+        slab->free_list = object;
+    }
+    return slab;
+}
+
+void DBArena::FreeSlab(Slab *slab) {
+    stats_[slab->index].slabs--;
+    free(slab);
+}
+
+void *DBArena::Alloc(size_t size) {
+    if (!enabled_ || size > kMaxObjectSize)
+        return ::operator new(size);
+    if (size == 0)
+        size = 1;
+
+    size_t index = SizeClassIndex(size);
+    int shard_index = GetShardIndex();
+    Shard *shard = &shards_[shard_index];
+    tbb::spin_mutex::scoped_lock lock(shard->mutex);
+    Slab *slab = shard->slab_list[index];
+    if (!slab) {
+        slab = AllocSlab(index, shard_index);
+        LinkSlab(shard, slab);
+    }
+
+    FreeObject *object = slab->free_list;
+    slab->free_list = object->next;
+    slab->objects_in_use++;
+    if (!slab->free_list)
+        UnlinkSlab(shard, slab);
+    stats_[index].objects_in_use++;
+    return object;
+}
+
+//
+// The object goes back to the slab it was carved out of, in the shard that
+// owns the slab. The slab is released once it is empty, unless it is the
+// only slab of the shard with free objects for the size class.
+//
+void DBArena::Free(void *ptr, size_t size) {
+    if (!ptr)
+        return;
+    if (!enabled_ || size > kMaxObjectSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    Slab *slab = ObjectSlab(ptr);
+    size_t index = slab->index;
+    Shard *shard = &shards_[slab->shard];
+    FreeObject *object = static_cast<FreeObject *>(ptr);
+    bool release = false;
+    {
+        tbb::spin_mutex::scoped_lock lock(shard->mutex);
+        if (!slab->free_list)
+            LinkSlab(shard, slab);
+        object->next = slab->free_list;
+        slab->free_list = object;
+        slab->objects_in_use--;
+        if (slab->objects_in_use == 0 && (slab->prev || slab->next)) {
+            UnlinkSlab(shard, slab);
+            release = true;
+        }
+    }
+    stats_[index].objects_in_use--;
+    if (release)
+        FreeSlab(slab);
+}
+
+uint64_t DBArena::slab_count() const {
+    uint64_t total = 0;
+    for (size_t idx = 0; idx < kSizeClassCount; ++idx) {
+        total += stats_[idx].slabs;
+    }
+    return total;
+}
+
+uint64_t DBArena::slab_bytes() const {
+    uint64_t total = 0;
+    for (size_t idx = 0; idx < kSizeClassCount; ++idx) {
+        total += stats_[idx].slabs * kSlabSize;
+    }
+    return total;
+}
+
+uint64_t DBArena::bytes_in_use() const {
+    uint64_t total = 0;
+    for (size_t idx = 0; idx < kSizeClassCount; ++idx) {
+        total += stats_[idx].objects_in_use * SizeClassObjectSize(idx);
+    }
+    return total;
+}
+
+void DBArena::FillStats(ShowDBArena *stats) const {
+    stats->set_enabled(enabled_);
+    stats->set_slab_bytes(slab_bytes());
+    stats->set_bytes_in_use(bytes_in_use());
+
+    vector<ShowDBArenaSizeClass> size_classes;
+    for (size_t idx = 0; idx < kSizeClassCount; ++idx) {
+        if (!stats_[idx].slabs)
+            continue;
+        size_t object_size = SizeClassObjectSize(idx);
+        uint64_t objects = stats_[idx].slabs * SlabObjectCount(idx);
+        ShowDBArenaSizeClass size_class;
+        size_class.set_object_size(object_size);
+        size_class.set_slabs(stats_[idx].slabs);
+        size_class.set_objects_in_use(stats_[idx].objects_in_use);
+        size_class.set_objects_free(objects - stats_[idx].objects_in_use);
+        size_classes.push_back(size_class);
+    }
+    stats->set_size_classes(size_classes);
+}
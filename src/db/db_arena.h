@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef ctrlplane_db_arena_h
+#define ctrlplane_db_arena_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <tbb/spin_mutex.h>
+
+#include "base/util.h"
+
+class ShowDBArena;
+
+//
+// Slab allocator for the small objects that make up DB tables e.g. routes
+// and paths. Objects are grouped in size classes that are a multiple of
+// kAlignment bytes. Memory for a size class is carved out of kSlabSize slabs
+// aligned to kSlabSize, so there is no per object malloc header and objects
+// of the same type are packed together.
+//
+// Slabs are owned by a shard picked from the instance of the running task,
+// which is the partition index for db::DBTable tasks, so that partitions do
+// not contend with each other when allocating. Each slab keeps its own free
+// list and an object is always freed back to the slab, and hence the shard,
+// it was allocated from, whichever task frees it. A slab whose objects have
+// all been freed is returned to the system unless it is the last slab with
+// free objects for the size class in its shard.
+//
+// Types opt in by defining class specific operator new and operator delete
+// that call Alloc and Free. Objects larger than kMaxObjectSize and all
+// objects when the arena is disabled are allocated from the heap.
+//
+class DBArena {
+public:
+    static const size_t kAlignment = 16;
+    static const size_t kMaxObjectSize = 512;
+    static const size_t kSizeClassCount = kMaxObjectSize / kAlignment;
+    static const size_t kSlabSize = 64 * 1024;
+    static const int kShardCount = 64;
+
+    static DBArena *GetInstance();
+
+    void *Alloc(size_t size);
+    void Free(void *ptr, size_t size);
+
+    bool enabled() const { return enabled_; }
+    uint64_t slab_count() const;
+    uint64_t slab_bytes() const;
+    uint64_t bytes_in_use() const;
+    void FillStats(ShowDBArena *stats) const;
+
+private:
+    struct FreeObject {
+        FreeObject *next;
+    };
+
+    // Header at the start of every slab. Slabs with free objects are linked
+    // in the list of their shard for the size class.
+    struct Slab {
+        Slab *prev;
+        Slab *next;
+        FreeObject *free_list;
+        uint32_t index;
+        uint32_t shard;
+        uint32_t objects_in_use;
+    };
+
+    struct Shard {
+        Shard();
+        tbb::spin_mutex mutex;
+        Slab *slab_list[kSizeClassCount];
+    };
+
+    struct SizeClassStats {
+        SizeClassStats() : slabs(0), objects_in_use(0) { }
+        std::atomic<uint64_t> slabs;
+        std::atomic<uint64_t> objects_in_use;
+    };
+
+    DBArena();
+    ~DBArena();
+
+    static size_t SizeClassIndex(size_t size) {
+        return (size + kAlignment - 1) / kAlignment - 1;
+    }
+    static size_t SizeClassObjectSize(size_t index) {
+        return (index + 1) * kAlignment;
+    }
+    static size_t SlabHeaderSize() {
+        return (sizeof(Slab) + kAlignment - 1) / kAlignment * kAlignment;
+    }
+    static size_t SlabObjectCount(size_t index) {
+        return (kSlabSize - SlabHeaderSize()) / SizeClassObjectSize(index);
+    }
+    static Slab *ObjectSlab(void *ptr) {
+        return reinterpret_cast<Slab *>(
+            reinterpret_cast<uintptr_t>(ptr) & ~(kSlabSize - 1));
+    }
+
+    int GetShardIndex() const;
+    Slab *AllocSlab(size_t index, int shard_index);
+    void FreeSlab(Slab *slab);
+    static void LinkSlab(Shard *shard, Slab *slab);
+    static void UnlinkSlab(Shard *shard, Slab *slab);
+
+    bool enabled_;
+    Shard shards_[kShardCount];
+    SizeClassStats stats_[kSizeClassCount];
+
+    DISALLOW_COPY_AND_ASSIGN(DBArena);
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include "db/db_flat_index.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "db/db_entry.h"
+
+using std::vector;
+
+namespace {
+
+struct EntryLess {
+    bool operator()(const DBEntry *lhs, const DBEntry *rhs) const {
+        return lhs->IsLess(*rhs);
+    }
+};
+
+// Chunks are ordered by their last entry.
+struct ChunkLess {
+    bool operator()(const vector<DBEntry *> *chunk,
+                    const DBEntry *key) const {
+        return chunk->back()->IsLess(*key);
+    }
+    bool operator()(const DBEntry *key,
+                    const vector<DBEntry *> *chunk) const {
+        return key->IsLess(*chunk->back());
+    }
+};
+
+}  // namespace
+
+DBFlatIndex::DBFlatIndex() : size_(0) {
+}
+
+DBFlatIndex::~DBFlatIndex() {
+    STLDeleteValues(&chunks_);
+}
+
+//
+// Returns the first chunk whose last entry is not less than the key i.e.
+// the only chunk that can contain the key.
+//
+DBFlatIndex::ChunkList::const_iterator DBFlatIndex::LowerBoundChunk(
+    const DBEntry *key) const {
+    return std::lower_bound(chunks_.begin(), chunks_.end(), key, ChunkLess());
+}
+
+//
+// Returns the first chunk whose last entry is greater than the key.
+//
+DBFlatIndex::ChunkList::const_iterator DBFlatIndex::UpperBoundChunk(
+    const DBEntry *key) const {
+    return std::upper_bound(chunks_.begin(), chunks_.end(), key, ChunkLess());
+}
+
+bool DBFlatIndex::insert(DBEntry *entry) {
+    if (chunks_.empty()) {
+        Chunk *chunk = new Chunk;
+        chunk->push_back(entry);
+        chunks_.push_back(chunk);
+        size_++;
+        return true;
+    }
+
+    // An entry greater than all others goes to the end of the last chunk.
+    size_t chunk_idx = LowerBoundChunk(entry) - chunks_.begin();
+    if (chunk_idx == chunks_.size())
+        chunk_idx--;
+    Chunk *chunk = chunks_[chunk_idx];
+    Chunk::iterator it =
+        std::lower_bound(chunk->begin(), chunk->end(), entry, EntryLess());
+    if (it != chunk->end() && !entry->IsLess(**it))
+        return false;
+    chunk->insert(it, entry);
+    size_++;
+
+    if (chunk->size() >= kMaxChunkSize) {
+        Chunk *split = new Chunk(chunk->begin() + chunk->size() / 2,
+                                 chunk->end());
+        chunk->resize(chunk->size() / 2);
+        chunks_.insert(chunks_.begin() + chunk_idx + 1, split);
+    }
+    return true;
+}
+
+bool DBFlatIndex::erase(const DBEntry *entry) {
+    size_t chunk_idx = LowerBoundChunk(entry) - chunks_.begin();
+    if (chunk_idx == chunks_.size())
+        return false;
+    Chunk *chunk = chunks_[chunk_idx];
+    Chunk::iterator it =
+        std::lower_bound(chunk->begin(), chunk->end(), entry, EntryLess());
+    assert(it != chunk->end());
+    if (entry->IsLess(**it))
+        return false;
+    chunk->erase(it);
+    size_--;
+
+    if (chunk->empty()) {
+        delete chunk;
+        chunks_.erase(chunks_.begin() + chunk_idx);
+        return true;
+    }
+    if (chunk_idx + 1 < chunks_.size()) {
+        Chunk *next = chunks_[chunk_idx + 1];
+        if (chunk->size() + next->size() <= kMaxChunkSize / 2) {
+            chunk->insert(chunk->end(), next->begin(), next->end());
+            delete next;
+            chunks_.erase(chunks_.begin() + chunk_idx + 1);
+        }
+    }
+    return true;
+}
+
+DBEntry *DBFlatIndex::find(const DBEntry *key) const {
+    DBEntry *entry = lower_bound(key);
+    if (entry && !key->IsLess(*entry))
+        return entry;
+    return NULL;
+}
+
+// Returns the matching entry or next in lex order
+DBEntry *DBFlatIndex::lower_bound(const DBEntry *key) const {
+    ChunkList::const_iterator chunk_it = LowerBoundChunk(key);
+    if (chunk_it == chunks_.end())
+        return NULL;
+    const Chunk *chunk = *chunk_it;
+    return *std::lower_bound(chunk->begin(), chunk->end(), key, EntryLess());
+}
+
+// Returns the next entry in lex order
+DBEntry *DBFlatIndex::upper_bound(const DBEntry *key) const {
+    ChunkList::const_iterator chunk_it = UpperBoundChunk(key);
+    if (chunk_it == chunks_.end())
+        return NULL;
+    const Chunk *chunk = *chunk_it;
+    return *std::upper_bound(chunk->begin(), chunk->end(), key, EntryLess());
+}
+
+DBEntry *DBFlatIndex::first() const {
+    if (chunks_.empty())
+        return NULL;
+    return chunks_.front()->front();
+}
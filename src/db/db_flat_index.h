@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef ctrlplane_db_flat_index_h
+#define ctrlplane_db_flat_index_h
+
+#include <cstddef>
+#include <vector>
+
+#include "base/util.h"
+
+class DBEntry;
+
+//
+// Sorted index of DBEntries that is an alternative to the intrusive tree in
+// DBTablePartition.
+//
+// Entries are kept in order (as per DBEntry::IsLess) in a list of chunks,
+// each of which is a sorted array of at most kMaxChunkSize entry pointers.
+// A lookup is a binary search over the last entry of every chunk followed
+// by a binary search within a chunk, and walking to the next entry is most
+// often a step to the adjacent slot in the same chunk. This keeps the index
+// itself in a few contiguous arrays instead of one tree node per entry.
+//
+// Inserts and erases move at most kMaxChunkSize pointers. A chunk is split
+// when it becomes full and is merged with its successor when both together
+// fit in half a chunk.
+//
+// Not thread safe; the owner provides synchronization.
+//
+class DBFlatIndex {
+public:
+    static const size_t kMaxChunkSize = 128;
+
+    DBFlatIndex();
+    ~DBFlatIndex();
+
+    // Returns false if an entry with the same key is already present.
+    bool insert(DBEntry *entry);
+
+    // Returns false if no entry with the same key is present.
+    bool erase(const DBEntry *entry);
+
+    DBEntry *find(const DBEntry *key) const;
+    DBEntry *lower_bound(const DBEntry *key) const;
+    DBEntry *upper_bound(const DBEntry *key) const;
+    DBEntry *first() const;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t chunk_count() const { return chunks_.size(); }
+
+private:
+    typedef std::vector<DBEntry *> Chunk;
+    typedef std::vector<Chunk *> ChunkList;
+
+    ChunkList::const_iterator LowerBoundChunk(const DBEntry *key) const;
+    ChunkList::const_iterator UpperBoundChunk(const DBEntry *key) const;
+
+    ChunkList chunks_;
+    size_t size_;
+
+    DISALLOW_COPY_AND_ASSIGN(DBFlatIndex);
+};
+
+#endif
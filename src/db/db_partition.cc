@@ -7,6 +7,7 @@
 #include <list>
 #include <mutex>
 #include <atomic>
+#include <vector>
 
 #include <tbb/concurrent_queue.h>
 
@@ -14,6 +15,7 @@
 #include "db/db.h"
 #include "db/db_client.h"
 #include "db/db_entry.h"
+#include "db/db_types.h"
 
 using tbb::concurrent_queue;
 
@@ -51,6 +53,8 @@ public:
         request_count_ = 0;
         max_request_queue_len_ = 0;
         total_request_count_ = 0;
+        run_count_ = 0;
+        yield_count_ = 0;
     }
     ~WorkQueue() {
         for (RequestQueue::iterator iter = request_queue_.unsafe_begin();
@@ -73,6 +77,22 @@ public:
 
     }
 
+    bool EnqueueRequestBatch(const std::vector<RequestQueueEntry *> &batch) {
+        if (batch.empty())
+            return true;
+        for (std::vector<RequestQueueEntry *>::const_iterator it =
+             batch.begin(); it != batch.end(); ++it) {
+            request_queue_.push(*it);
+        }
+        MaybeStartRunner();
+        uint32_t max =
+            request_count_.fetch_add(batch.size()) + batch.size() - 1;
+        if (max > max_request_queue_len_)
+            max_request_queue_len_ = max;
+        total_request_count_ += batch.size();
+        return max < (kThreshold - 1);
+    }
+
     bool DequeueRequest(RequestQueueEntry **req_entry) {
         bool success = request_queue_.try_pop(*req_entry);
         if (success) {
@@ -113,7 +133,7 @@ public:
         return tpart;
     }
 
-    int db_partition_id() {
+    int db_partition_id() const {
         return db_partition_id_;
     }
 
@@ -138,6 +158,11 @@ public:
         return max_request_queue_len_;
     }
 
+    uint64_t run_count() const { return run_count_; }
+    void incr_run_count() { run_count_++; }
+    uint64_t yield_count() const { return yield_count_; }
+    void incr_yield_count() { yield_count_++; }
+
 private:
     DBPartition *db_partition_;
     RequestQueue request_queue_;
@@ -145,6 +170,8 @@ private:
     std::atomic<long> request_count_;
     uint64_t total_request_count_;
     uint64_t max_request_queue_len_;
+    uint64_t run_count_;
+    uint64_t yield_count_;
     RemoveQueue remove_queue_;
     std::mutex mutex_;
     int db_partition_id_;
@@ -182,6 +209,8 @@ public:
         if (queue_->disable())
             return queue_->RunnerDone();
 
+        queue_->incr_run_count();
+
         RemoveQueueEntry *rm_entry = NULL;
         while (queue_->DequeueRemove(&rm_entry)) {
             DBEntryBase *db_entry = rm_entry->db_entry;
@@ -199,6 +228,7 @@ public:
             }
             delete rm_entry;
             if (++count == kMaxIterations) {
+                queue_->incr_yield_count();
                 return false;
             }
         }
@@ -208,6 +238,7 @@ public:
             req_entry->tpart->Process(req_entry->client, &req_entry->request);
             delete req_entry;
             if (++count == kMaxIterations) {
+                queue_->incr_yield_count();
                 return false;
             }
         }
@@ -219,6 +250,7 @@ public:
             }
             bool done = tpart->RunNotify();
             if (!done) {
+                queue_->incr_yield_count();
                 return false;
             }
         }
@@ -277,6 +309,17 @@ bool DBPartition::EnqueueRequest(DBTablePartBase *tpart, DBClient *client,
     return work_queue_->EnqueueRequest(entry);
 }
 
+bool DBPartition::EnqueueRequestBatch(DBTablePartBase *tpart,
+    DBClient *client, const DBTableBase::RequestList &req_list) {
+    std::vector<RequestQueueEntry *> batch;
+    batch.reserve(req_list.size());
+    for (DBTableBase::RequestList::const_iterator it = req_list.begin();
+         it != req_list.end(); ++it) {
+        batch.push_back(new RequestQueueEntry(tpart, client, *it));
+    }
+    return work_queue_->EnqueueRequestBatch(batch);
+}
+
 void DBPartition::EnqueueRemove(DBTablePartBase *tpart, DBEntryBase *db_entry) {
     RemoveQueueEntry *entry = new RemoveQueueEntry(tpart, db_entry);
     db_entry->SetOnRemoveQ();
@@ -300,6 +343,27 @@ uint64_t DBPartition::max_request_queue_len() const {
     return work_queue_->max_request_queue_len();
 }
 
+uint64_t DBPartition::run_count() const {
+    return work_queue_->run_count();
+}
+
+uint64_t DBPartition::yield_count() const {
+    return work_queue_->yield_count();
+}
+
 int DBPartition::task_id() const {
     return db_->task_id();
 }
+
+int DBPartition::index() const {
+    return work_queue_->db_partition_id();
+}
+
+void DBPartition::FillStats(ShowDBPartition *stats) const {
+    stats->set_index(index());
+    stats->set_request_queue_len(request_queue_len());
+    stats->set_max_request_queue_len(max_request_queue_len());
+    stats->set_total_request_count(total_request_count());
+    stats->set_runs(run_count());
+    stats->set_yields(yield_count());
+}
@@ -14,6 +14,7 @@
 class DB;
 class DBClient;
 class DBTablePartBase;
+class ShowDBPartition;
 
 // Database shard interface.
 // Each shard handles the full pipeline of DB update processing.
@@ -29,6 +30,12 @@ public:
     bool EnqueueRequest(DBTablePartBase *tpart, DBClient *client,
                         DBRequest *req);
 
+    // Enqueue a batch of requests for the same table partition, waking up
+    // the queue runner once for the whole batch.
+    // Returns false if the client should stop enqueuing updates.
+    bool EnqueueRequestBatch(DBTablePartBase *tpart, DBClient *client,
+                             const DBTableBase::RequestList &req_list);
+
     void EnqueueRemove(DBTablePartBase *tpart, DBEntryBase *db_entry);
 
     // Enqueue table on change list.
@@ -39,7 +46,11 @@ public:
     long request_queue_len() const;
     uint64_t total_request_count() const;
     uint64_t max_request_queue_len() const;
+    uint64_t run_count() const;
+    uint64_t yield_count() const;
     int task_id() const;
+    int index() const;
+    void FillStats(ShowDBPartition *stats) const;
 
 private:
     class WorkQueue;
@@ -224,6 +224,28 @@ bool DBTableBase::Enqueue(DBRequest *req) {
     return partition->EnqueueRequest(tpart, NULL, req);
 }
 
+bool DBTableBase::EnqueueBatch(const RequestList &req_list) {
+    vector<RequestList> partition_req_lists(DB::PartitionCount());
+    for (RequestList::const_iterator it = req_list.begin();
+         it != req_list.end(); ++it) {
+        DBTablePartBase *tpart = GetTablePartition((*it)->key.get());
+        partition_req_lists[tpart->index()].push_back(*it);
+    }
+
+    bool more = true;
+    for (size_t idx = 0; idx < partition_req_lists.size(); ++idx) {
+        const RequestList &partition_req_list = partition_req_lists[idx];
+        if (partition_req_list.empty())
+            continue;
+        DBTablePartBase *tpart = GetTablePartition(idx);
+        DBPartition *partition = db_->GetPartition(idx);
+        enqueue_count_ += partition_req_list.size();
+        if (!partition->EnqueueRequestBatch(tpart, NULL, partition_req_list))
+            more = false;
+    }
+    return more;
+}
+
 void DBTableBase::EnqueueRemove(DBEntryBase *db_entry) {
     DBTablePartBase *tpart = GetTablePartition(db_entry);
     DBPartition *partition = db_->GetPartition(tpart->index());
@@ -317,6 +339,8 @@ bool DBTable::WalkWorker::Run() {
     DBRequestKey *key_resume = walk_ctx_.get();
     DBTable *table = walker_->table();
     int max_walk_entry_count = table->GetWalkIterationToYield();
+    uint64_t time_budget = table->GetWalkYieldTimeBudget();
+    uint64_t start_time = time_budget ? ClockMonotonicUsec() : 0;
     DBEntry *entry;
 
     if (key_resume != NULL) {
@@ -333,9 +357,17 @@ bool DBTable::WalkWorker::Run() {
 
     for (DBEntry *next = NULL; entry; entry = next) {
         next = tbl_partition_->GetNext(entry);
-        if (count == max_walk_entry_count) {
+        bool yield;
+        if (time_budget) {
+            yield = count && (count % kIterationToCheckTime) == 0 &&
+                (ClockMonotonicUsec() - start_time >= time_budget);
+        } else {
+            yield = (count == max_walk_entry_count);
+        }
+        if (yield) {
             // store the context
             walk_ctx_ = entry->GetDBRequestKey();
+            table->incr_walk_yield_count();
             return false;
         }
 
@@ -385,13 +417,19 @@ void DBTable::TableWalker::StartWalk() {
 ///////////////////////////////////////////////////////////
 // Implementation of DBTable methods
 ///////////////////////////////////////////////////////////
+bool DBTable::flat_index_;
+
 DBTable::DBTable(DB *db, const string &name)
     : DBTableBase(db, name),
       walker_(new TableWalker(this)),
-      walker_task_id_(db->task_id()) {
+      walker_task_id_(db->task_id()),
+      last_walk_wait_usecs_(0),
+      last_walk_usecs_(0),
+      max_walk_usecs_(0) {
 
     static bool init_ = false;
     static int iter_to_yield_env_ = 0;
+    static uint64_t yield_usecs_env_ = 0;
 
     if (!init_) {
         // XXX To be used for testing purposes only.
@@ -401,9 +439,20 @@ DBTable::DBTable(DB *db, const string &name)
         } else {
             iter_to_yield_env_ = kIterationToYield;
         }
+        char *usecs_str = getenv("DB_WALK_YIELD_USECS");
+        if (usecs_str) {
+            yield_usecs_env_ = strtoull(usecs_str, NULL, 0);
+        }
+        char *flat_index_str = getenv("DB_FLAT_INDEX");
+        if (flat_index_str) {
+            flat_index_ = (strtol(flat_index_str, NULL, 0) != 0);
+        }
         init_ = true;
     }
     max_walk_iteration_to_yield_ = iter_to_yield_env_;
+    walk_yield_time_budget_ = yield_usecs_env_;
+    walk_entry_count_ = 0;
+    walk_yield_count_ = 0;
 }
 
 DBTable::~DBTable() {
@@ -629,7 +678,8 @@ void DBTable::NotifyAllEntries() {
     if (walk_ref_ == NULL) {
         walk_ref_ =
             AllocWalker(boost::bind(&DBTable::WalkCallback, this, _1, _2),
-                    boost::bind(&DBTable::WalkCompleteCallback, this, _2));
+                    boost::bind(&DBTable::WalkCompleteCallback, this, _2),
+                    WALK_PRIORITY_LOW);
         WalkTable(walk_ref_);
     } else {
         WalkAgain(walk_ref_);
@@ -637,9 +687,10 @@ void DBTable::NotifyAllEntries() {
 }
 
 DBTable::DBTableWalkRef DBTable::AllocWalker(WalkFn walk_fn,
-                                             WalkCompleteFn walk_complete) {
+                                             WalkCompleteFn walk_complete,
+                                             WalkPriority priority) {
     DBTableWalkMgr *walk_mgr = database()->GetWalkMgr();
-    return walk_mgr->AllocWalker(this, walk_fn, walk_complete);
+    return walk_mgr->AllocWalker(this, walk_fn, walk_complete, priority);
 }
 
 void DBTable::ReleaseWalker(DBTable::DBTableWalkRef &walk) {
@@ -662,6 +713,7 @@ void DBTable::WalkAgain(DBTable::DBTableWalkRef walk) {
 
 bool DBTable::InvokeWalkCb(DBTablePartBase *part, DBEntryBase *entry) {
     DBTableWalkMgr *walk_mgr = database()->GetWalkMgr();
+    incr_walk_entry_count();
     return walk_mgr->InvokeWalkCb(part, entry);
 }
 
@@ -671,3 +723,31 @@ void DBTable::WalkDone() {
     DBTableWalkMgr *walk_mgr = database()->GetWalkMgr();
     return walk_mgr->WalkDone();
 }
+
+//
+// Concurrency: called from db::Walker task.
+//
+// Update the time spent in the walk request queue and the time taken to
+// walk all partitions for the last walk.
+//
+void DBTable::UpdateWalkTime(uint64_t wait_usecs, uint64_t walk_usecs) {
+    CHECK_CONCURRENCY("db::Walker");
+    last_walk_wait_usecs_ = wait_usecs;
+    last_walk_usecs_ = walk_usecs;
+    if (walk_usecs > max_walk_usecs_)
+        max_walk_usecs_ = walk_usecs;
+}
+
+string DBTable::WalkPriorityToString(WalkPriority priority) {
+    switch (priority) {
+    case WALK_PRIORITY_HIGH:
+        return "high";
+    case WALK_PRIORITY_NORMAL:
+        return "normal";
+    case WALK_PRIORITY_LOW:
+        return "low";
+    default:
+        break;
+    }
+    return "unknown";
+}
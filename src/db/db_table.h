@@ -66,8 +66,14 @@ public:
     DBTableBase(DB *db, const std::string &name);
     virtual ~DBTableBase();
 
+    typedef std::vector<DBRequest *> RequestList;
+
     // Enqueue a request to the table. Takes ownership of the data.
     bool Enqueue(DBRequest *req);
+    // Enqueue a list of requests to the table. Takes ownership of the data
+    // in each request. Requests are split per partition and each partition
+    // gets a single batch, preserving the relative order of the requests.
+    bool EnqueueBatch(const RequestList &req_list);
     void EnqueueRemove(DBEntryBase *db_entry);
 
     // Determine the table partition depending on the record key.
@@ -178,7 +184,25 @@ public:
     // Called when all partitions are done iterating.
     typedef boost::function<void(DBTableWalkRef, DBTableBase *)> WalkCompleteFn;
 
+    // Priority of a walk request. Pending walks of higher priority tables
+    // are started before those of lower priority ones. A table is walked
+    // with the highest priority of all the walkers that requested the walk.
+    enum WalkPriority {
+        WALK_PRIORITY_HIGH = 0,
+        WALK_PRIORITY_NORMAL = 1,
+        WALK_PRIORITY_LOW = 2,
+        WALK_PRIORITY_COUNT = 3,
+    };
+
+    // Index used by a DBTablePartition to keep its entries.
+    enum PartitionIndexType {
+        PARTITION_INDEX_TREE,
+        PARTITION_INDEX_FLAT,
+    };
+
     static const int kIterationToYield = 256;
+    // Number of entries walked between checks of the walk time budget.
+    static const int kIterationToCheckTime = 16;
 
     DBTable(DB *db, const std::string &name);
     virtual ~DBTable();
@@ -202,6 +226,14 @@ public:
     // Override if *really* necessary
     virtual DBTablePartition *AllocPartition(int index);
 
+    // Index used by the partitions to keep entries in order. The flat index
+    // trades slower inserts and removes in large tables for faster lookups
+    // and walks. Override to opt in to the flat index for a table; it is only
+    // used when enabled with SetFlatIndex or DB_FLAT_INDEX.
+    virtual PartitionIndexType GetPartitionIndexType() const {
+        return PARTITION_INDEX_TREE;
+    }
+
     // Input processing implemented by derived class. Default
     // implementation takes care of Add/Delete/Change.
     // Override if *really* necessary
@@ -268,7 +300,8 @@ public:
     // Walk APIs
     // Create a DBTable Walker
     // Concurrency : can be invoked from any task
-    DBTableWalkRef AllocWalker(WalkFn walk_fn, WalkCompleteFn walk_complete);
+    DBTableWalkRef AllocWalker(WalkFn walk_fn, WalkCompleteFn walk_complete,
+                               WalkPriority priority = WALK_PRIORITY_NORMAL);
 
     // Release the Walker
     // Concurrency : can be invoked from any task
@@ -292,6 +325,16 @@ public:
         return max_walk_iteration_to_yield_;
     }
 
+    // Time budget in usecs after which a walk of a table partition yields.
+    // If 0, the walk yields after the walk iteration count instead.
+    void SetWalkYieldTimeBudget(uint64_t usecs) {
+        walk_yield_time_budget_ = usecs;
+    }
+
+    uint64_t GetWalkYieldTimeBudget() const {
+        return walk_yield_time_budget_;
+    }
+
     void SetWalkTaskId(int task_id) {
         walker_task_id_ = task_id;
     }
@@ -299,6 +342,22 @@ public:
     int GetWalkerTaskId() {
         return walker_task_id_;
     }
+
+    // Walk statistics.
+    uint64_t walk_entry_count() const { return walk_entry_count_; }
+    uint64_t walk_yield_count() const { return walk_yield_count_; }
+    uint64_t last_walk_wait_usecs() const { return last_walk_wait_usecs_; }
+    uint64_t last_walk_usecs() const { return last_walk_usecs_; }
+    uint64_t max_walk_usecs() const { return max_walk_usecs_; }
+
+    static std::string WalkPriorityToString(WalkPriority priority);
+
+    // Use the flat index for the partitions of tables that opt in to it.
+    // Disabled by default, in which case all tables use the tree. Applies to
+    // tables created afterwards.
+    static void SetFlatIndex(bool enable) { flat_index_ = enable; }
+    static bool flat_index() { return flat_index_; }
+
 private:
     friend class DBTableWalkMgr;
     class TableWalker;
@@ -347,11 +406,22 @@ private:
     bool WalkCallback(DBTablePartBase *tpart, DBEntryBase *entry);
     void WalkCompleteCallback(DBTableBase *tbl_base);
 
+    void incr_walk_entry_count() { walk_entry_count_++; }
+    void incr_walk_yield_count() { walk_yield_count_++; }
+    void UpdateWalkTime(uint64_t wait_usecs, uint64_t walk_usecs);
+
     std::unique_ptr<TableWalker> walker_;
     std::vector<DBTablePartition *> partitions_;
     DBTable::DBTableWalkRef walk_ref_;
     int walker_task_id_;
     int max_walk_iteration_to_yield_;
+    uint64_t walk_yield_time_budget_;
+    std::atomic<uint64_t> walk_entry_count_;
+    std::atomic<uint64_t> walk_yield_count_;
+    uint64_t last_walk_wait_usecs_;
+    uint64_t last_walk_usecs_;
+    uint64_t max_walk_usecs_;
+    static bool flat_index_;
 
     DISALLOW_COPY_AND_ASSIGN(DBTable);
 };
@@ -367,8 +437,10 @@ public:
     };
 
     DBTableWalk(DBTable *table, DBTable::WalkFn walk_fn,
-                DBTable::WalkCompleteFn walk_complete)
-        : table_(table), walk_fn_(walk_fn), walk_complete_(walk_complete) {
+                DBTable::WalkCompleteFn walk_complete,
+                DBTable::WalkPriority priority = DBTable::WALK_PRIORITY_NORMAL)
+        : table_(table), walk_fn_(walk_fn), walk_complete_(walk_complete),
+          priority_(priority) {
         walk_state_ = INIT;
         walk_again_ = false;
         refcount_ = 0;
@@ -377,6 +449,7 @@ public:
     DBTable *table() const { return table_;}
     DBTable::WalkFn walk_fn() const { return walk_fn_;}
     DBTable::WalkCompleteFn walk_complete() const { return walk_complete_;}
+    DBTable::WalkPriority priority() const { return priority_;}
 
     bool requested() const { return (walk_state_ == WALK_REQUESTED);}
     bool in_progress() const { return (walk_state_ == WALK_IN_PROGRESS);}
@@ -407,6 +480,7 @@ private:
     DBTable *table_;
     DBTable::WalkFn walk_fn_;
     DBTable::WalkCompleteFn walk_complete_;
+    DBTable::WalkPriority priority_;
     std::atomic<WalkState> walk_state_;
     std::atomic<bool> walk_again_;
     std::atomic<int> refcount_;
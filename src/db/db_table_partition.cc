@@ -82,7 +82,21 @@ void DBTablePartBase::Delete(DBEntryBase *entry) {
 }
 
 DBTablePartition::DBTablePartition(DBTable *table, int index)
-    : DBTablePartBase(table, index) {
+    : DBTablePartBase(table, index),
+      use_flat_index_(DBTable::flat_index() &&
+          table->GetPartitionIndexType() == DBTable::PARTITION_INDEX_FLAT) {
+}
+
+bool DBTablePartition::Insert(DBEntry *entry) {
+    if (use_flat_index_)
+        return flat_index_.insert(entry);
+    return tree_.insert(*entry).second;
+}
+
+bool DBTablePartition::Erase(DBEntry *entry) {
+    if (use_flat_index_)
+        return flat_index_.erase(entry);
+    return tree_.erase(*entry);
 }
 
 void DBTablePartition::Process(DBClient *client, DBRequest *req) {
@@ -93,8 +107,8 @@ void DBTablePartition::Process(DBClient *client, DBRequest *req) {
 
 void DBTablePartition::Add(DBEntry *entry) {
     std::scoped_lock lock(mutex_);
-    std::pair<Tree::iterator, bool> ret = tree_.insert(*entry);
-    assert(ret.second);
+    bool success = Insert(entry);
+    assert(success);
     entry->set_table_partition(static_cast<DBTablePartBase *>(this));
     Notify(entry);
     parent()->AddRemoveCallback(entry, true);
@@ -110,7 +124,7 @@ void DBTablePartition::Remove(DBEntryBase *db_entry) {
     DBEntry *entry = static_cast<DBEntry *>(db_entry);
     parent()->AddRemoveCallback(entry, false);
 
-    bool success = tree_.erase(*entry);
+    bool success = Erase(entry);
     if (!success) {
         LOG(FATAL, "ABORT: DB node erase failed for table " + parent()->name());
         LOG(FATAL, "Invalid node " + db_entry->ToString());
@@ -120,13 +134,13 @@ void DBTablePartition::Remove(DBEntryBase *db_entry) {
 
     // If a table is marked for deletion, then we may trigger the deletion
     // process when the last prefix is deleted
-    if (tree_.empty())
+    if (size() == 0)
         table()->RetryDelete();
 }
 
 void DBTablePartition::AddWithoutAlloc(DBEntry *entry) {
     std::scoped_lock lock(mutex_);
-    tree_.insert(*entry);
+    Insert(entry);
     entry->set_table_partition(static_cast<DBTablePartBase *>(this));
     Notify(entry);
     parent()->AddRemoveCallback(entry, true);
@@ -134,7 +148,7 @@ void DBTablePartition::AddWithoutAlloc(DBEntry *entry) {
 
 void DBTablePartition::RemoveWithoutDelete(DBEntry *entry) {
     std::scoped_lock lock(mutex_);
-    bool success = tree_.erase(*entry);
+    bool success = Erase(entry);
     if (!success) {
         LOG(FATAL, "ABORT: DB node erase failed for table " + parent()->name());
         abort();
@@ -142,6 +156,8 @@ void DBTablePartition::RemoveWithoutDelete(DBEntry *entry) {
 }
 
 DBEntry *DBTablePartition::FindInternal(const DBEntry *entry) {
+    if (use_flat_index_)
+        return flat_index_.find(entry);
     Tree::iterator loc = tree_.find(*entry);
     if (loc != tree_.end()) {
         return loc.operator->();
@@ -150,6 +166,8 @@ DBEntry *DBTablePartition::FindInternal(const DBEntry *entry) {
 }
 
 const DBEntry *DBTablePartition::FindInternal(const DBEntry *entry) const {
+    if (use_flat_index_)
+        return flat_index_.find(entry);
     Tree::const_iterator loc = tree_.find(*entry);
     if (loc != tree_.end()) {
         return loc.operator->();
@@ -193,6 +211,8 @@ DBEntry *DBTablePartition::FindNext(const DBRequestKey *key) {
     DBTable *table = static_cast<DBTable *>(parent());
     std::unique_ptr<DBEntry> entry_ptr = table->AllocEntry(key);
 
+    if (use_flat_index_)
+        return flat_index_.upper_bound(entry_ptr.get());
     Tree::iterator loc = tree_.upper_bound(*(entry_ptr.get()));
     if (loc != tree_.end()) {
         return loc.operator->();
@@ -205,6 +225,8 @@ DBEntry *DBTablePartition::lower_bound(const DBEntryBase *key) {
     const DBEntry *entry = static_cast<const DBEntry *>(key);
     std::scoped_lock lock(mutex_);
 
+    if (use_flat_index_)
+        return flat_index_.lower_bound(entry);
     Tree::iterator it = tree_.lower_bound(*entry);
     if (it != tree_.end()) {
         return (it.operator->());
@@ -214,6 +236,8 @@ DBEntry *DBTablePartition::lower_bound(const DBEntryBase *key) {
 
 DBEntry *DBTablePartition::GetFirst() {
     std::scoped_lock lock(mutex_);
+    if (use_flat_index_)
+        return flat_index_.first();
     Tree::iterator it = tree_.begin();
     if (it == tree_.end()) {
         return NULL;
@@ -226,6 +250,8 @@ DBEntry *DBTablePartition::GetNext(const DBEntryBase *key) {
     const DBEntry *entry = static_cast<const DBEntry *>(key);
     std::scoped_lock lock(mutex_);
 
+    if (use_flat_index_)
+        return flat_index_.upper_bound(entry);
     Tree::const_iterator it = tree_.iterator_to(*entry);
     it++;
     if (it != tree_.end()) {
@@ -11,6 +11,7 @@
 #include <tbb/spin_rw_mutex.h>
 
 #include "db/db_entry.h"
+#include "db/db_flat_index.h"
 
 class DBTableBase;
 class DBTable;
@@ -71,6 +72,8 @@ public:
         &DBEntry::node_> SetMember;
     typedef boost::intrusive::set<DBEntry, SetMember> Tree;
 
+    // Entries are kept in the intrusive tree unless the table asks for the
+    // flat index and it is enabled (see DBTable::GetPartitionIndexType).
     DBTablePartition(DBTable *parent, int index);
 
     ///////////////////////////////////////////////////////////////
@@ -112,7 +115,10 @@ public:
     DBEntry *FindNext(const DBRequestKey *key);
 
     DBTable *table();
-    size_t size() const { return tree_.size(); }
+    size_t size() const {
+        return use_flat_index_ ? flat_index_.size() : tree_.size();
+    }
+    bool use_flat_index() const { return use_flat_index_; }
 
     // Add an entry to DB without allocating
     void AddWithoutAlloc(DBEntry *entry);
@@ -124,8 +130,13 @@ private:
     DBEntry *FindInternal(const DBEntry *entry);
     const DBEntry *FindInternal(const DBEntry *entry) const;
 
+    bool Insert(DBEntry *entry);
+    bool Erase(DBEntry *entry);
+
     mutable std::mutex mutex_;
+    bool use_flat_index_;
     Tree tree_;
+    DBFlatIndex flat_index_;
     DISALLOW_COPY_AND_ASSIGN(DBTablePartition);
 };
 
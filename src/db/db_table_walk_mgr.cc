@@ -10,10 +10,12 @@
 #include "base/logging.h"
 #include "base/task.h"
 #include "base/task_annotations.h"
+#include "base/time_util.h"
 #include "db/db.h"
 #include "db/db_partition.h"
 #include "db/db_table.h"
 #include "db/db_table_partition.h"
+#include "db/db_types.h"
 
 using namespace boost::placeholders;
 
@@ -23,7 +25,9 @@ DBTableWalkMgr::DBTableWalkMgr()
         TaskScheduler::GetInstance()->GetTaskId("db::Walker"), 0)),
       walk_done_trigger_(new TaskTrigger(
         boost::bind(&DBTableWalkMgr::ProcessWalkDone, this),
-        TaskScheduler::GetInstance()->GetTaskId("db::Walker"), 0)) {
+        TaskScheduler::GetInstance()->GetTaskId("db::Walker"), 0)),
+      current_walk_started_at_(0) {
+    current_walk_entry_count_ = 0;
 }
 
 bool DBTableWalkMgr::ProcessWalkRequestList() {
@@ -31,10 +35,18 @@ bool DBTableWalkMgr::ProcessWalkRequestList() {
     std::scoped_lock lock(mutex_);
     if (!current_table_walk_.empty()) return true;
     while (true) {
-        if (walk_request_list_.empty()) break;
-        WalkRequestInfoPtr info = walk_request_list_.front();
+        // Take up the oldest request of the highest priority.
+        WalkRequestInfoList *request_list = NULL;
+        for (int idx = 0; idx < DBTable::WALK_PRIORITY_COUNT; ++idx) {
+            if (!walk_request_list_[idx].empty()) {
+                request_list = &walk_request_list_[idx];
+                break;
+            }
+        }
+        if (!request_list) break;
+        WalkRequestInfoPtr info = request_list->front();
         walk_request_set_.erase(info.get());
-        walk_request_list_.pop_front();
+        request_list->pop_front();
         current_table_walk_.swap(info->pending_requests);
         DBTable *table = info->table;
         bool walk_table = false;
@@ -46,6 +58,9 @@ bool DBTableWalkMgr::ProcessWalkRequestList() {
         }
         if (walk_table) {
             // start the walk
+            current_walk_info_ = info;
+            current_walk_started_at_ = ClockMonotonicUsec();
+            current_walk_entry_count_ = 0;
             table->StartWalk();
             break;
         } else {
@@ -58,6 +73,10 @@ bool DBTableWalkMgr::ProcessWalkRequestList() {
 bool DBTableWalkMgr::ProcessWalkDone() {
     CHECK_CONCURRENCY("db::Walker");
     assert(!current_table_walk_.empty());
+    uint64_t now = ClockMonotonicUsec();
+    current_walk_info_->table->UpdateWalkTime(
+        current_walk_started_at_ - current_walk_info_->requested_at,
+        now - current_walk_started_at_);
     for (auto walker : current_table_walk_) {
         if (walker->walk_again())
             walker->set_walk_requested();
@@ -66,15 +85,21 @@ bool DBTableWalkMgr::ProcessWalkDone() {
         if (walker->stopped() || walker->walk_again()) continue;
         walker->walk_complete()(walker, walker->table());
     }
-    current_table_walk_.clear();
+    {
+        std::scoped_lock lock(mutex_);
+        current_table_walk_.clear();
+        current_walk_info_.reset();
+    }
     walk_request_trigger_->Set();
     return true;
 }
 
 DBTable::DBTableWalkRef DBTableWalkMgr::AllocWalker(DBTable *table,
-               DBTable::WalkFn walk_fn, DBTable::WalkCompleteFn walk_complete) {
+               DBTable::WalkFn walk_fn, DBTable::WalkCompleteFn walk_complete,
+               DBTable::WalkPriority priority) {
     table->incr_walker_count();
-    DBTableWalk *walker = new DBTableWalk(table, walk_fn, walk_complete);
+    DBTableWalk *walker =
+        new DBTableWalk(table, walk_fn, walk_complete, priority);
     return DBTable::DBTableWalkRef(walker);
 }
 
@@ -102,13 +127,30 @@ void DBTableWalkMgr::WalkTable(DBTable::DBTableWalkRef walk) {
     WalkRequestInfo tmp_info = WalkRequestInfo(table);
     WalkRequestInfoSet::iterator it = walk_request_set_.find(&tmp_info);
     if (it != walk_request_set_.end()) {
-        (*it)->AppendWalkReq(walk);
+        WalkRequestInfo *info = *it;
+        DBTable::WalkPriority priority = info->priority;
+        info->AppendWalkReq(walk);
+
+        // Move the request to the list for the new priority.
+        if (info->priority != priority) {
+            WalkRequestInfoList *request_list = &walk_request_list_[priority];
+            for (WalkRequestInfoList::iterator list_it = request_list->begin();
+                 list_it != request_list->end(); ++list_it) {
+                if (list_it->get() != info)
+                    continue;
+                walk_request_list_[info->priority].push_back(*list_it);
+                request_list->erase(list_it);
+                break;
+            }
+        }
         return;
     }
 
     WalkRequestInfo *new_info = new WalkRequestInfo(table);
     new_info->AppendWalkReq(walk);
-    walk_request_list_.push_back(WalkRequestInfoPtr(new_info));
+    new_info->requested_at = ClockMonotonicUsec();
+    walk_request_list_[new_info->priority].push_back(
+        WalkRequestInfoPtr(new_info));
     walk_request_set_.insert(new_info);
     walk_request_trigger_->Set();
 }
@@ -119,6 +161,7 @@ void DBTableWalkMgr::WalkDone() {
 
 bool DBTableWalkMgr::InvokeWalkCb(DBTablePartBase *part, DBEntryBase *entry) {
     uint32_t skip_walk_count = 0;
+    current_walk_entry_count_++;
     for (auto walker : current_table_walk_) {
         if (walker->done() || walker->stopped() || walker->walk_again()) {
             skip_walk_count++;
@@ -132,3 +175,42 @@ bool DBTableWalkMgr::InvokeWalkCb(DBTablePartBase *part, DBEntryBase *entry) {
     }
     return (skip_walk_count < current_table_walk_.size());
 }
+
+void DBTableWalkMgr::FillWalkRequest(const WalkRequestInfo *info,
+    bool in_progress, uint64_t now,
+    std::vector<ShowDBTableWalkRequest> *requests) {
+    ShowDBTableWalkRequest request;
+    request.set_table(info->table->name());
+    request.set_priority(DBTable::WalkPriorityToString(info->priority));
+    request.set_in_progress(in_progress);
+    if (in_progress) {
+        request.set_walkers(current_table_walk_.size());
+        request.set_wait_usecs(current_walk_started_at_ - info->requested_at);
+        request.set_run_usecs(now - current_walk_started_at_);
+        request.set_entries(current_walk_entry_count_);
+    } else {
+        request.set_walkers(info->pending_requests.size());
+        request.set_wait_usecs(now - info->requested_at);
+        request.set_run_usecs(0);
+        request.set_entries(0);
+    }
+    requests->push_back(request);
+}
+
+//
+// Concurrency: can be invoked from any task.
+//
+void DBTableWalkMgr::FillWalkRequests(
+    std::vector<ShowDBTableWalkRequest> *requests) {
+    std::scoped_lock lock(mutex_);
+    uint64_t now = ClockMonotonicUsec();
+    if (current_walk_info_)
+        FillWalkRequest(current_walk_info_.get(), true, now, requests);
+    for (int idx = 0; idx < DBTable::WALK_PRIORITY_COUNT; ++idx) {
+        for (WalkRequestInfoList::const_iterator it =
+             walk_request_list_[idx].begin();
+             it != walk_request_list_[idx].end(); ++it) {
+            FillWalkRequest(it->get(), false, now, requests);
+        }
+    }
+}
@@ -8,6 +8,7 @@
 #include <list>
 #include <set>
 #include <mutex>
+#include <vector>
 
 #include <boost/assign.hpp>
 #include <boost/function.hpp>
@@ -21,6 +22,8 @@
 
 #include "db/db_table.h"
 
+class ShowDBTableWalkRequest;
+
 //
 // DBTableWalkMgr:
 // ==============
@@ -83,12 +86,25 @@
 //
 // WalkRequestInfoList
 // ===================
-// walk_request_list_ holds list of WalkRequestInfo. This list is keyed by
-// DBTable. Additional walk_request_set_ is maintained for easy search of
-// WalkRequestInfo for a given DBTable.
+// walk_request_list_ holds list of WalkRequestInfo per walk priority. These
+// lists are keyed by DBTable. Additional walk_request_set_ is maintained for
+// easy search of WalkRequestInfo for a given DBTable.
 // Current table on which walk is going on will not be present in the
 // walk_request_list_. If caller requests for WalkAgain(), it is added back to
 // the walk_request_list_ (in the end of the list).
+// The priority of a WalkRequestInfo is the highest priority of its pending
+// requests. If a higher priority walker is added to a pending request, the
+// WalkRequestInfo is moved to the end of the list for the higher priority.
+// Pending requests are taken up in priority order, so a low priority walk
+// e.g. a config triggered NotifyAllEntries doesn't delay walks needed for
+// peer membership changes.
+//
+// Walk yield:
+// ==========
+// A walk on a DBTablePartition yields after DBTable::GetWalkIterationToYield
+// entries or, if DBTable::SetWalkYieldTimeBudget is set, after running for
+// the time budget. The time budget bounds the time a walk holds the
+// partition irrespective of the cost of the walk callbacks.
 //
 // Task Triggers:
 // walk_request_trigger_ : Task trigger which evaluate walk_request_list_.
@@ -120,16 +136,23 @@ public:
         walk_done_trigger_->set_enable();
     }
 
+    // Fill in the current and pending walk requests for introspect.
+    void FillWalkRequests(std::vector<ShowDBTableWalkRequest> *requests);
+
 private:
     friend class DBTable;
     typedef std::set<DBTable::DBTableWalkRef> WalkReqList;
 
     struct WalkRequestInfo {
-        WalkRequestInfo(DBTable *table) : table(table) {
+        WalkRequestInfo(DBTable *table)
+            : table(table), priority(DBTable::WALK_PRIORITY_LOW),
+              requested_at(0) {
         }
 
         void AppendWalkReq(DBTable::DBTableWalkRef ref) {
             pending_requests.insert(ref);
+            if (ref->priority() < priority)
+                priority = ref->priority();
         }
 
         void DeleteWalkReq(DBTable::DBTableWalkRef ref) {
@@ -140,6 +163,8 @@ private:
             return !pending_requests.empty();
         }
         DBTable *table;
+        DBTable::WalkPriority priority;
+        uint64_t requested_at;
         WalkReqList pending_requests;
     };
 
@@ -155,7 +180,8 @@ private:
 
     // Create a DBTable Walker
     DBTable::DBTableWalkRef AllocWalker(DBTable *table, DBTable::WalkFn walk_fn,
-                       DBTable::WalkCompleteFn walk_complete);
+                       DBTable::WalkCompleteFn walk_complete,
+                       DBTable::WalkPriority priority);
 
     // Release the Walker
     void ReleaseWalker(DBTable::DBTableWalkRef &walk);
@@ -175,17 +201,26 @@ private:
 
     bool InvokeWalkCb(DBTablePartBase *part, DBEntryBase *entry);
 
+    void FillWalkRequest(const WalkRequestInfo *info, bool in_progress,
+                         uint64_t now,
+                         std::vector<ShowDBTableWalkRequest> *requests);
+
     boost::scoped_ptr<TaskTrigger> walk_request_trigger_;
     boost::scoped_ptr<TaskTrigger> walk_done_trigger_;
 
     // Mutex to protect walk_request_list_ and walk_request_set_ as
     // Walk can be requested from task which may run concurrently
     std::mutex mutex_;
-    WalkRequestInfoList walk_request_list_;
+    WalkRequestInfoList walk_request_list_[DBTable::WALK_PRIORITY_COUNT];
     WalkRequestInfoSet walk_request_set_;
 
     WalkReqList current_table_walk_;
 
+    // Information about current walk, protected by mutex_.
+    WalkRequestInfoPtr current_walk_info_;
+    uint64_t current_walk_started_at_;
+    std::atomic<uint64_t> current_walk_entry_count_;
+
     DISALLOW_COPY_AND_ASSIGN(DBTableWalkMgr);
 };
 
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <set>
+#include <vector>
+
+#include <boost/bind/bind.hpp>
+#include <boost/function.hpp>
+
+#include "db/db_arena.h"
+
+#include "base/logging.h"
+#include "base/task.h"
+#include "base/test/task_test_util.h"
+#include "testing/gunit.h"
+
+class ArenaObject {
+public:
+    explicit ArenaObject(int value) : value_(value) { }
+    virtual ~ArenaObject() { }
+
+    static void *operator new(size_t size) {
+        return DBArena::GetInstance()->Alloc(size);
+    }
+    static void operator delete(void *ptr, size_t size) {
+        DBArena::GetInstance()->Free(ptr, size);
+    }
+
+    int value() const { return value_; }
+
+private:
+    int value_;
+};
+
+class LargeArenaObject : public ArenaObject {
+public:
+    explicit LargeArenaObject(int value) : ArenaObject(value) { }
+
+private:
+    char data_[DBArena::kMaxObjectSize];
+};
+
+// Runs the function in a db::DBTable task of the given instance.
+class ArenaTask : public Task {
+public:
+    typedef boost::function<void(void)> TaskFn;
+
+    ArenaTask(int instance, TaskFn fn) :
+        Task(TaskScheduler::GetInstance()->GetTaskId("db::DBTable"), instance),
+        fn_(fn) {
+    }
+
+    bool Run() {
+        fn_();
+        return true;
+    }
+    std::string Description() const { return "ArenaTask"; }
+
+private:
+    TaskFn fn_;
+};
+
+class DBArenaTest : public ::testing::Test {
+protected:
+    DBArenaTest() : arena_(DBArena::GetInstance()) {
+    }
+
+    void RunTask(int instance, ArenaTask::TaskFn fn) {
+        TaskScheduler::GetInstance()->Enqueue(new ArenaTask(instance, fn));
+        task_util::WaitForIdle();
+    }
+
+    void AllocObjects(std::vector<ArenaObject *> *objects, size_t count) {
+        for (size_t idx = 0; idx < count; ++idx) {
+            objects->push_back(new ArenaObject(idx));
+        }
+    }
+
+    void FreeObjects(std::vector<ArenaObject *> *objects) {
+        for (size_t idx = 0; idx < objects->size(); ++idx) {
+            delete objects->at(idx);
+        }
+        objects->clear();
+    }
+
+    DBArena *arena_;
+};
+
+// Objects are packed in slabs and empty slabs are returned.
+TEST_F(DBArenaTest, AllocFree) {
+    if (!arena_->enabled())
+        return;
+
+    const size_t count = 4 * DBArena::kSlabSize / DBArena::kAlignment;
+    uint64_t bytes_in_use = arena_->bytes_in_use();
+    uint64_t slab_count = arena_->slab_count();
+
+    std::vector<ArenaObject *> objects;
+    AllocObjects(&objects, count);
+    EXPECT_LT(bytes_in_use, arena_->bytes_in_use());
+    EXPECT_LE(slab_count + 4, arena_->slab_count());
+    for (size_t idx = 0; idx < count; ++idx) {
+        EXPECT_EQ(static_cast<int>(idx), objects[idx]->value());
+    }
+
+    // All slabs but the one kept for the size class are released.
+    FreeObjects(&objects);
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+    EXPECT_GE(slab_count + 1, arena_->slab_count());
+
+    // The slab kept for the size class is reused.
+    uint64_t slab_count_after_free = arena_->slab_count();
+    ArenaObject *object = new ArenaObject(1);
+    EXPECT_EQ(slab_count_after_free, arena_->slab_count());
+    delete object;
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+}
+
+// Objects freed by a task of another instance go back to the slabs of the
+// shard they were allocated from, which are then released.
+TEST_F(DBArenaTest, FreeOtherShard) {
+    if (!arena_->enabled())
+        return;
+
+    const size_t count = 4 * DBArena::kSlabSize / DBArena::kAlignment;
+    uint64_t bytes_in_use = arena_->bytes_in_use();
+    uint64_t slab_count = arena_->slab_count();
+
+    std::vector<ArenaObject *> objects;
+    RunTask(1, boost::bind(&DBArenaTest::AllocObjects, this, &objects,
+                           count));
+    uint64_t slab_count_in_use = arena_->slab_count();
+    EXPECT_LE(slab_count + 4, slab_count_in_use);
+
+    RunTask(2, boost::bind(&DBArenaTest::FreeObjects, this, &objects));
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+    EXPECT_GE(slab_count + 1, arena_->slab_count());
+
+    // Allocating again in the first shard reuses its remaining slab instead
+    // of the objects being stranded in the second shard.
+    RunTask(1, boost::bind(&DBArenaTest::AllocObjects, this, &objects,
+                           count));
+    EXPECT_EQ(slab_count_in_use, arena_->slab_count());
+    RunTask(1, boost::bind(&DBArenaTest::FreeObjects, this, &objects));
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+    EXPECT_GE(slab_count + 1, arena_->slab_count());
+}
+
+// Objects larger than the biggest size class come from the heap.
+TEST_F(DBArenaTest, LargeObject) {
+    uint64_t bytes_in_use = arena_->bytes_in_use();
+    ArenaObject *object = new LargeArenaObject(1);
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+    EXPECT_EQ(1, object->value());
+    delete object;
+    EXPECT_EQ(bytes_in_use, arena_->bytes_in_use());
+}
+
+int main(int argc, char **argv) {
+    LoggingInit();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <boost/bind/bind.hpp>
+
+#include "db/db.h"
+#include "db/db_table.h"
+#include "db/db_entry.h"
+#include "db/db_client.h"
+#include "db/db_partition.h"
+#include "base/task.h"
+#include "base/test/task_test_util.h"
+
+#include "base/logging.h"
+#include "base/task_annotations.h"
+#include "testing/gunit.h"
+
+using namespace boost::placeholders;
+
+#define ENQUEUE_COUNT (10*1000)
+#define ENQUEUE_BATCH_SIZE 256
+
+struct VlanTableReqKey : public DBRequestKey {
+    VlanTableReqKey(uint32_t id) : id_(id) {}
+    uint32_t id_;
+};
+
+struct VlanTableReqData : public DBRequestData {
+    VlanTableReqData(uint32_t value) : value_(value) {};
+    uint32_t value_;
+};
+
+class Vlan : public DBEntry {
+public:
+    Vlan(uint32_t id) : id_(id), value_(0) { }
+
+    bool IsLess(const DBEntry &rhs) const {
+        const Vlan &a = static_cast<const Vlan &>(rhs);
+        return id_ < a.id_;
+    }
+
+    void SetKey(const DBRequestKey *key) {
+        const VlanTableReqKey *k = static_cast<const VlanTableReqKey *>(key);
+        id_ = k->id_;
+    }
+
+    std::string ToString() const {
+        return "Vlan";
+    }
+
+    virtual KeyPtr GetDBRequestKey() const {
+        VlanTableReqKey *key = new VlanTableReqKey(id_);
+        return KeyPtr(key);
+    }
+
+    uint32_t id() const { return id_; }
+    void set_value(uint32_t value) { value_ = value; }
+    uint32_t value() const { return value_; }
+
+private:
+    uint32_t id_;
+    uint32_t value_;
+    DISALLOW_COPY_AND_ASSIGN(Vlan);
+};
+
+class VlanTable : public DBTable {
+public:
+    VlanTable(DB *db) : DBTable(db, "__vlan__.0") { }
+    ~VlanTable() { }
+
+    virtual std::unique_ptr<DBEntry> AllocEntry(const DBRequestKey *key) const {
+        const VlanTableReqKey *vkey = static_cast<const VlanTableReqKey *>(key);
+        return std::unique_ptr<DBEntry>(new Vlan(vkey->id_));
+    };
+
+    size_t Hash(const DBEntry *entry) const {
+        return static_cast<const Vlan *>(entry)->id();
+    }
+
+    size_t Hash(const DBRequestKey *key) const {
+        return static_cast<const VlanTableReqKey *>(key)->id_;
+    }
+
+    virtual DBEntry *Add(const DBRequest *req) {
+        const VlanTableReqKey *key = static_cast<const VlanTableReqKey *>
+            (req->key.get());
+        const VlanTableReqData *data = static_cast<const VlanTableReqData *>
+            (req->data.get());
+        Vlan *vlan = new Vlan(key->id_);
+        vlan->set_value(data->value_);
+        return vlan;
+    };
+
+    virtual bool OnChange(DBEntry *entry, const DBRequest *req) {
+        const VlanTableReqData *data = static_cast<const VlanTableReqData *>
+            (req->data.get());
+        Vlan *vlan = static_cast<Vlan *>(entry);
+        vlan->set_value(data->value_);
+        return true;
+    };
+
+    static DBTableBase *CreateTable(DB *db, const std::string &name) {
+        VlanTable *table = new VlanTable(db);
+        table->Init();
+        return table;
+    }
+
+    DISALLOW_COPY_AND_ASSIGN(VlanTable);
+};
+
+class DBEnqueueTest : public ::testing::Test {
+public:
+    DBEnqueueTest() {
+        table_ = static_cast<VlanTable *>(db_.CreateTable("db.test.vlan.0"));
+    }
+
+    virtual void TearDown() {
+        for (uint32_t id = 0; id < ENQUEUE_COUNT; ++id) {
+            DBRequest req(DBRequest::DB_ENTRY_DELETE);
+            req.key.reset(new VlanTableReqKey(id));
+            table_->Enqueue(&req);
+        }
+        task_util::WaitForIdle();
+        EXPECT_EQ(0, table_->Size());
+    }
+
+    DBRequest *MakeRequest(uint32_t id, uint32_t value) {
+        DBRequest *req = new DBRequest(DBRequest::DB_ENTRY_ADD_CHANGE);
+        req->key.reset(new VlanTableReqKey(id));
+        req->data.reset(new VlanTableReqData(value));
+        return req;
+    }
+
+    // Enqueue add/change requests for all entries in batches.
+    void EnqueueBatch(uint32_t count, uint32_t batch_size, uint32_t value) {
+        DBTableBase::RequestList req_list;
+        req_list.reserve(batch_size);
+        for (uint32_t id = 0; id < count; ++id) {
+            req_list.push_back(MakeRequest(id, value));
+            if (req_list.size() == batch_size || id == count - 1) {
+                table_->EnqueueBatch(req_list);
+                STLDeleteValues(&req_list);
+            }
+        }
+        task_util::WaitForIdle();
+    }
+
+    void VerifyValue(uint32_t count, uint32_t value) {
+        ConcurrencyScope scope("db::DBTable");
+        EXPECT_EQ(count, table_->Size());
+        for (uint32_t id = 0; id < count; ++id) {
+            VlanTableReqKey key(id);
+            Vlan *vlan = static_cast<Vlan *>(table_->Find(&key));
+            ASSERT_TRUE(vlan != NULL);
+            EXPECT_EQ(value, vlan->value());
+        }
+    }
+
+protected:
+    DB db_;
+    VlanTable *table_;
+};
+
+// Requests for the same entry in a batch are applied in order.
+TEST_F(DBEnqueueTest, BatchOrder) {
+    DBTableBase::RequestList req_list;
+    for (uint32_t value = 1; value <= 16; ++value) {
+        for (uint32_t id = 0; id < ENQUEUE_COUNT; id += ENQUEUE_COUNT / 8) {
+            req_list.push_back(MakeRequest(id, value));
+        }
+    }
+    table_->EnqueueBatch(req_list);
+    STLDeleteValues(&req_list);
+    task_util::WaitForIdle();
+
+    ConcurrencyScope scope("db::DBTable");
+    EXPECT_EQ(8, table_->Size());
+    for (uint32_t id = 0; id < ENQUEUE_COUNT; id += ENQUEUE_COUNT / 8) {
+        VlanTableReqKey key(id);
+        Vlan *vlan = static_cast<Vlan *>(table_->Find(&key));
+        ASSERT_TRUE(vlan != NULL);
+        EXPECT_EQ(16, vlan->value());
+    }
+}
+
+// Batched requests add and change all entries across partitions.
+TEST_F(DBEnqueueTest, Batch) {
+    EnqueueBatch(ENQUEUE_COUNT, ENQUEUE_BATCH_SIZE, 1);
+    VerifyValue(ENQUEUE_COUNT, 1);
+    EnqueueBatch(ENQUEUE_COUNT, ENQUEUE_BATCH_SIZE, 2);
+    VerifyValue(ENQUEUE_COUNT, 2);
+}
+
+void RegisterFactory() {
+    DB::RegisterFactory("db.test.vlan.0", &VlanTable::CreateTable);
+}
+
+int main(int argc, char **argv) {
+    LoggingInit();
+    ::testing::InitGoogleTest(&argc, argv);
+
+    RegisterFactory();
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "db/db.h"
+#include "db/db_table.h"
+#include "db/db_entry.h"
+#include "db/db_flat_index.h"
+#include "db/db_table_partition.h"
+#include "base/task.h"
+#include "base/test/task_test_util.h"
+
+#include "base/logging.h"
+#include "base/task_annotations.h"
+#include "testing/gunit.h"
+
+#define INDEX_COUNT (64*1024)
+
+struct VlanTableReqKey : public DBRequestKey {
+    VlanTableReqKey(uint32_t id) : id_(id) {}
+    uint32_t id_;
+};
+
+class Vlan : public DBEntry {
+public:
+    Vlan(uint32_t id) : id_(id) { }
+
+    bool IsLess(const DBEntry &rhs) const {
+        const Vlan &a = static_cast<const Vlan &>(rhs);
+        return id_ < a.id_;
+    }
+
+    void SetKey(const DBRequestKey *key) {
+        const VlanTableReqKey *k = static_cast<const VlanTableReqKey *>(key);
+        id_ = k->id_;
+    }
+
+    std::string ToString() const {
+        return "Vlan";
+    }
+
+    virtual KeyPtr GetDBRequestKey() const {
+        VlanTableReqKey *key = new VlanTableReqKey(id_);
+        return KeyPtr(key);
+    }
+
+    uint32_t id() const { return id_; }
+
+private:
+    uint32_t id_;
+    DISALLOW_COPY_AND_ASSIGN(Vlan);
+};
+
+class VlanTable : public DBTable {
+public:
+    VlanTable(DB *db, const std::string &name, PartitionIndexType index_type)
+        : DBTable(db, name), index_type_(index_type) {
+    }
+
+    virtual std::unique_ptr<DBEntry> AllocEntry(const DBRequestKey *key) const {
+        const VlanTableReqKey *vkey = static_cast<const VlanTableReqKey *>(key);
+        return std::unique_ptr<DBEntry>(new Vlan(vkey->id_));
+    };
+
+    virtual PartitionIndexType GetPartitionIndexType() const {
+        return index_type_;
+    }
+
+    static DBTableBase *CreateTreeTable(DB *db, const std::string &name) {
+        VlanTable *table = new VlanTable(db, name, PARTITION_INDEX_TREE);
+        table->Init();
+        return table;
+    }
+
+    static DBTableBase *CreateFlatTable(DB *db, const std::string &name) {
+        VlanTable *table = new VlanTable(db, name, PARTITION_INDEX_FLAT);
+        table->Init();
+        return table;
+    }
+
+private:
+    PartitionIndexType index_type_;
+    DISALLOW_COPY_AND_ASSIGN(VlanTable);
+};
+
+class DBIndexTest : public ::testing::Test {
+protected:
+    DBIndexTest() : flat_table_(NULL) {
+        tree_table_ = static_cast<VlanTable *>(
+            db_.CreateTable("db.test.tree.0"));
+        for (uint32_t id = 0; id < INDEX_COUNT; ++id) {
+            ids_.push_back(id);
+        }
+        std::random_shuffle(ids_.begin(), ids_.end());
+    }
+
+    virtual void TearDown() {
+        DBTable::SetFlatIndex(false);
+    }
+
+    void CreateFlatTable() {
+        flat_table_ = static_cast<VlanTable *>(
+            db_.CreateTable("db.test.flat.0"));
+    }
+
+    static DBTablePartition *GetPartition(VlanTable *table) {
+        return static_cast<DBTablePartition *>(table->GetTablePartition(0));
+    }
+
+    // Insert, look up, walk and remove INDEX_COUNT entries in random order
+    // directly in a partition of the table.
+    void Verify(VlanTable *table) {
+        DBTablePartition *tpart = GetPartition(table);
+
+        // Keep the notification task from running while entries are added.
+        TaskScheduler::GetInstance()->Stop();
+        {
+            ConcurrencyScope scope("db::DBTable");
+            for (size_t idx = 0; idx < ids_.size(); ++idx) {
+                tpart->Add(new Vlan(ids_[idx]));
+            }
+        }
+        TaskScheduler::GetInstance()->Start();
+        task_util::WaitForIdle();
+
+        ConcurrencyScope scope("db::DBTable");
+        EXPECT_EQ(ids_.size(), tpart->size());
+
+        for (size_t idx = 0; idx < ids_.size(); ++idx) {
+            Vlan key(ids_[idx]);
+            EXPECT_TRUE(tpart->FindNoLock(&key) != NULL);
+        }
+
+        uint32_t count = 0;
+        for (DBEntry *entry = tpart->GetFirst(); entry;
+             entry = tpart->GetNext(entry)) {
+            EXPECT_EQ(count, static_cast<Vlan *>(entry)->id());
+            count++;
+        }
+        EXPECT_EQ(ids_.size(), count);
+
+        for (size_t idx = 0; idx < ids_.size(); ++idx) {
+            Vlan key(ids_[idx]);
+            tpart->Delete(tpart->FindNoLock(&key));
+        }
+        EXPECT_EQ(0, tpart->size());
+    }
+
+    DB db_;
+    VlanTable *tree_table_;
+    VlanTable *flat_table_;
+    std::vector<uint32_t> ids_;
+};
+
+// Verify the flat index against std::set with random inserts and erases.
+TEST_F(DBIndexTest, FlatIndex) {
+    DBFlatIndex index;
+    std::set<uint32_t> ids;
+    std::vector<Vlan *> entries;
+    for (uint32_t id = 0; id < 16 * DBFlatIndex::kMaxChunkSize; ++id) {
+        entries.push_back(new Vlan(2 * id));
+    }
+    std::random_shuffle(entries.begin(), entries.end());
+
+    for (size_t idx = 0; idx < entries.size(); ++idx) {
+        EXPECT_TRUE(index.insert(entries[idx]));
+        ids.insert(entries[idx]->id());
+    }
+    for (size_t idx = 0; idx < entries.size(); ++idx) {
+        Vlan duplicate(entries[idx]->id());
+        EXPECT_FALSE(index.insert(&duplicate));
+    }
+    EXPECT_EQ(ids.size(), index.size());
+    EXPECT_LT(1, index.chunk_count());
+
+    // Erase every other entry and an absent key.
+    for (size_t idx = 0; idx < entries.size(); idx += 2) {
+        EXPECT_TRUE(index.erase(entries[idx]));
+        ids.erase(entries[idx]->id());
+    }
+    Vlan absent(1);
+    EXPECT_FALSE(index.erase(&absent));
+    EXPECT_EQ(ids.size(), index.size());
+
+    // Walk in order.
+    std::set<uint32_t>::const_iterator it = ids.begin();
+    for (DBEntry *entry = index.first(); entry;
+         entry = index.upper_bound(entry), ++it) {
+        ASSERT_TRUE(it != ids.end());
+        EXPECT_EQ(*it, static_cast<Vlan *>(entry)->id());
+    }
+    EXPECT_TRUE(it == ids.end());
+
+    // Lookups for present and absent keys.
+    for (uint32_t id = 0; id <= 2 * entries.size(); ++id) {
+        Vlan key(id);
+        DBEntry *entry = index.find(&key);
+        EXPECT_EQ(ids.count(id) != 0, entry != NULL);
+
+        std::set<uint32_t>::const_iterator lower = ids.lower_bound(id);
+        entry = index.lower_bound(&key);
+        if (lower == ids.end()) {
+            EXPECT_TRUE(entry == NULL);
+        } else {
+            ASSERT_TRUE(entry != NULL);
+            EXPECT_EQ(*lower, static_cast<Vlan *>(entry)->id());
+        }
+    }
+
+    for (size_t idx = 1; idx < entries.size(); idx += 2) {
+        EXPECT_TRUE(index.erase(entries[idx]));
+    }
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(0, index.chunk_count());
+    EXPECT_TRUE(index.first() == NULL);
+    STLDeleteValues(&entries);
+}
+
+// Tables use the tree unless the flat index is enabled.
+TEST_F(DBIndexTest, FlatIndexDisabled) {
+    CreateFlatTable();
+    EXPECT_FALSE(GetPartition(tree_table_)->use_flat_index());
+    EXPECT_FALSE(GetPartition(flat_table_)->use_flat_index());
+    Verify(tree_table_);
+    Verify(flat_table_);
+}
+
+// Only tables that opt in use the flat index once it is enabled.
+TEST_F(DBIndexTest, FlatIndexEnabled) {
+    DBTable::SetFlatIndex(true);
+    CreateFlatTable();
+    EXPECT_FALSE(GetPartition(tree_table_)->use_flat_index());
+    EXPECT_TRUE(GetPartition(flat_table_)->use_flat_index());
+    Verify(tree_table_);
+    Verify(flat_table_);
+}
+
+void RegisterFactory() {
+    DB::RegisterFactory("db.test.tree.0", &VlanTable::CreateTreeTable);
+    DB::RegisterFactory("db.test.flat.0", &VlanTable::CreateFlatTable);
+}
+
+int main(int argc, char **argv) {
+    LoggingInit();
+    ::testing::InitGoogleTest(&argc, argv);
+
+    RegisterFactory();
+
+    return RUN_ALL_TESTS();
+}
@@ -12,6 +12,7 @@
 #include "db/db_client.h"
 #include "db/db_partition.h"
 #include "db/db_table_walker.h"
+#include "db/db_types.h"
 #include "base/time_util.h"
 
 #include "base/logging.h"
@@ -276,6 +277,64 @@ TEST_F(DBTest, Find) {
     del_notification = 0;
 }
 
+// Queue depth, runs and yields are counted for the partition that requests
+// hash to.
+TEST_F(DBTest, PartitionStats) {
+    const int partition_count = DB::PartitionCount();
+    const int num_entries = 256;
+
+    tid_ = itbl->Register(boost::bind(&DBTest::DBTestListener, this, _1, _2));
+    TASK_UTIL_EXPECT_EQ(tid_, 0);
+    adc_notification = 0;
+    del_notification = 0;
+    DBPartition *partition = db_.GetPartition(0);
+    uint64_t total_request_count = partition->total_request_count();
+    uint64_t run_count = partition->run_count();
+    uint64_t yield_count = partition->yield_count();
+
+    // Enqueue all requests before the partition starts running.
+    TaskScheduler::GetInstance()->Stop();
+    for (int idx = 0; idx < num_entries; ++idx) {
+        DBRequest addReq;
+        addReq.key.reset(new VlanTableReqKey(idx * partition_count));
+        addReq.data.reset(new VlanTableReqData("DB Test Vlan"));
+        addReq.oper = DBRequest::DB_ENTRY_ADD_CHANGE;
+        itbl->Enqueue(&addReq);
+    }
+    EXPECT_EQ(num_entries, partition->request_queue_len());
+    EXPECT_LE(static_cast<uint64_t>(num_entries - 1),
+              partition->max_request_queue_len());
+    TaskScheduler::GetInstance()->Start();
+    TASK_UTIL_EXPECT_EQ(num_entries, adc_notification);
+    TASK_UTIL_EXPECT_EQ(num_entries, itbl->Size());
+    TASK_UTIL_EXPECT_EQ(0, partition->request_queue_len());
+    EXPECT_EQ(total_request_count + num_entries,
+              partition->total_request_count());
+    EXPECT_LT(run_count, partition->run_count());
+    EXPECT_LT(yield_count, partition->yield_count());
+
+    ShowDBPartition stats;
+    partition->FillStats(&stats);
+    EXPECT_EQ(0U, stats.get_index());
+    EXPECT_EQ(partition->total_request_count(),
+              stats.get_total_request_count());
+    EXPECT_EQ(partition->yield_count(), stats.get_yields());
+
+    // Delete all entries
+    for (int idx = 0; idx < num_entries; ++idx) {
+        DBRequest delReq;
+        delReq.key.reset(new VlanTableReqKey(idx * partition_count));
+        delReq.oper = DBRequest::DB_ENTRY_DELETE;
+        itbl->Enqueue(&delReq);
+    }
+    TASK_UTIL_EXPECT_EQ(num_entries, del_notification);
+    TASK_UTIL_EXPECT_EQ(0, itbl->Size());
+
+    itbl->Unregister(tid_);
+    adc_notification = 0;
+    del_notification = 0;
+}
+
 void RegisterFactory() {
     DB::RegisterFactory("db.test.vlan.0", &VlanTable::CreateTable);
     DB::RegisterFactory("db.test.vlan.1", &VlanTable::CreateTable);
@@ -26,6 +26,8 @@ void AgentStats::Reset() {
     pkt_invalid_mpls_hdr_ = pkt_invalid_ip_pkt_ = pkt_drop_due_to_disable_tnl_ = 0;
     pkt_invalid_frm_tor_ = pkt_drop_due_to_decode_error_ = pkt_drop_due_to_invalid_ethertype_ = 0;
     pkt_drop_due_to_flow_trap_ = 0;
+    pkt_rx_batches_ = pkt_rx_batch_pkts_ = pkt_rx_max_batch_ = 0;
+    pkt_rx_batch_usecs_ = 0;
     flow_created_ = pkt_fragments_dropped_ = hold_flow_count_ = 0;
     flow_aged_ = flow_drop_due_to_max_limit_ = 0;
     flow_drop_due_to_linklocal_limit_ = ipc_in_msgs_ = 0;
@@ -61,6 +63,10 @@ void AgentStatsReq::HandleRequest() const {
         pkt->set_pkt_drop_due_to_decode_error(stats->pkt_drop_due_to_decode_error());
         pkt->set_pkt_drop_due_to_invalid_ethertype(stats->pkt_drop_due_to_invalid_ethertype());
         pkt->set_pkt_drop_due_to_flow_trap(stats->pkt_drop_due_to_flow_trap());
+        pkt->set_pkt_rx_batches(stats->pkt_rx_batches());
+        pkt->set_pkt_rx_batch_pkts(stats->pkt_rx_batch_pkts());
+        pkt->set_pkt_rx_max_batch(stats->pkt_rx_max_batch());
+        pkt->set_pkt_rx_cost_nsecs(stats->pkt_rx_cost_nsecs());
         pkt->set_context(context());
         pkt->set_more(true);
         pkt->Response();
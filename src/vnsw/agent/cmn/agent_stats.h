@@ -35,7 +35,8 @@ public:
         pkt_no_handler_(0U), pkt_fragments_dropped_(0U), pkt_dropped_(0U),
         pkt_invalid_mpls_hdr_(0U), pkt_invalid_ip_pkt_(0U), pkt_drop_due_to_disable_tnl_(0U),
         pkt_invalid_frm_tor_(0U), pkt_drop_due_to_decode_error_(0U), pkt_drop_due_to_invalid_ethertype_(0U),
-        pkt_drop_due_to_flow_trap_(0U),
+        pkt_drop_due_to_flow_trap_(0U), pkt_rx_batches_(0U),
+        pkt_rx_batch_pkts_(0U), pkt_rx_max_batch_(0U), pkt_rx_batch_usecs_(0U),
         max_flow_count_(0),
         flow_drop_due_to_max_limit_(0), flow_drop_due_to_linklocal_limit_(0),
         flow_stats_update_timeout_(kFlowStatsUpdateInterval),
@@ -164,6 +165,26 @@ public:
     void incr_pkt_dropped() {pkt_dropped_++;}
     uint64_t pkt_dropped() const {return pkt_dropped_;}
 
+    // Packets read from control interface in one read event and time taken
+    // to read and process them
+    void incr_pkt_rx_batch(uint32_t count, uint64_t usecs) {
+        pkt_rx_batches_++;
+        pkt_rx_batch_pkts_ += count;
+        pkt_rx_batch_usecs_ += usecs;
+        if (count > pkt_rx_max_batch_)
+            pkt_rx_max_batch_ = count;
+    }
+    uint64_t pkt_rx_batches() const {return pkt_rx_batches_;}
+    uint64_t pkt_rx_batch_pkts() const {return pkt_rx_batch_pkts_;}
+    uint32_t pkt_rx_max_batch() const {return pkt_rx_max_batch_;}
+    uint64_t pkt_rx_batch_usecs() const {return pkt_rx_batch_usecs_;}
+    // Average cost of receiving a packet in nsecs
+    uint64_t pkt_rx_cost_nsecs() const {
+        if (pkt_rx_batch_pkts_ == 0)
+            return 0;
+        return (pkt_rx_batch_usecs_ * 1000) / pkt_rx_batch_pkts_;
+    }
+
     void incr_ipc_in_msgs() {ipc_in_msgs_++;}
     uint64_t ipc_in_msgs() const {return ipc_out_msgs_;}
 
@@ -252,6 +273,10 @@ private:
     uint64_t pkt_drop_due_to_decode_error_;
     uint64_t pkt_drop_due_to_invalid_ethertype_;
     uint64_t pkt_drop_due_to_flow_trap_;
+    uint64_t pkt_rx_batches_;
+    uint64_t pkt_rx_batch_pkts_;
+    uint32_t pkt_rx_max_batch_;
+    uint64_t pkt_rx_batch_usecs_;
 
     // Flow stats
     std::atomic<uint32_t> flow_count_;
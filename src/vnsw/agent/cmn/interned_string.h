@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef __AGENT_INTERNED_STRING_H__
+#define __AGENT_INTERNED_STRING_H__
+
+#include <string>
+#include <boost/flyweight.hpp>
+
+// String shared by all the objects holding the same value, such as the VM
+// name or ACE uuid kept in every flow.
+//
+// Creating or assigning an InternedString from a std::string looks up the
+// value in a global table under a mutex. Copying an InternedString only
+// updates a refcount, so values are interned when the config changes and
+// flows copy the interned value from the config object.
+struct InternedStringTag { };
+typedef boost::flyweights::flyweight<std::string,
+        boost::flyweights::tag<InternedStringTag> > InternedString;
+
+#endif  // __AGENT_INTERNED_STRING_H__
@@ -36,6 +36,8 @@ protected:
 
     void AsyncRead();
     void ReadHandler(const boost::system::error_code &err, std::size_t length);
+    std::size_t ReadNonBlocking(uint8_t *buff, std::size_t len,
+                                boost::system::error_code &error);
     void WriteHandler(const boost::system::error_code &error,
                       std::size_t length, uint8_t *buff);
 
@@ -82,6 +84,8 @@ public:
 private:
     void AsyncRead();
     void ReadHandler(const boost::system::error_code &err, std::size_t length);
+    std::size_t ReadNonBlocking(uint8_t *buff, std::size_t len,
+                                boost::system::error_code &error);
     void WriteHandler(const boost::system::error_code &error,
                       std::size_t length, PacketBufferPtr pkt, uint8_t *buff);
     void CreateUnixSocket();
@@ -74,7 +74,8 @@ void Pkt0Interface::WriteHandler(const boost::system::error_code &error,
 
 
 void Pkt0Interface::AsyncRead() {
-    read_buff_ = new uint8_t[kMaxPacketSize];
+    Agent *agent = pkt_handler()->agent();
+    read_buff_ = agent->pkt()->packet_buffer_manager()->AllocateRxBuffer();
     input_.async_read_some(
             boost::asio::buffer(read_buff_, kMaxPacketSize),
             boost::bind(&Pkt0Interface::ReadHandler, this,
@@ -96,16 +97,28 @@ void Pkt0Interface::ReadHandler(const boost::system::error_code &error,
     }
 
     if (!error) {
-        Agent *agent = pkt_handler()->agent();
-        PacketBufferPtr pkt(agent->pkt()->packet_buffer_manager()->Allocate
-            (PktHandler::RX_PACKET, read_buff_, kMaxPacketSize, 0, length,
-             0));
-        VrouterControlInterface::Process(pkt);
+        uint8_t *buff = read_buff_;
+        read_buff_ = NULL;
+        // Drain packets already queued on the interface before waiting for
+        // the next read event
+        ProcessReadBatch(buff, length,
+                         boost::bind(&Pkt0Interface::ReadNonBlocking, this,
+                                     _1, _2, _3));
     }
 
     AsyncRead();
 }
 
+std::size_t Pkt0Interface::ReadNonBlocking(uint8_t *buff, std::size_t len,
+                                           boost::system::error_code &error) {
+    if (input_.non_blocking() == false) {
+        input_.non_blocking(true, error);
+        if (error)
+            return 0;
+    }
+    return input_.read_some(boost::asio::buffer(buff, len), error);
+}
+
 int Pkt0Interface::Send(uint8_t *buff, uint16_t buff_len,
                         const PacketBufferPtr &pkt) {
     std::vector<boost::asio::const_buffer> buff_list;
@@ -179,7 +192,8 @@ void Pkt0Socket::ShutdownControlInterface() {
 }
 
 void Pkt0Socket::AsyncRead() {
-    read_buff_ = new uint8_t[kMaxPacketSize];
+    Agent *agent = pkt_handler()->agent();
+    read_buff_ = agent->pkt()->packet_buffer_manager()->AllocateRxBuffer();
     socket_.async_receive(
             boost::asio::buffer(read_buff_, kMaxPacketSize),
             boost::bind(&Pkt0Socket::ReadHandler, this,
@@ -247,16 +261,26 @@ void Pkt0Socket::ReadHandler(const boost::system::error_code &error,
     }
 
     if (!error) {
-        Agent *agent = pkt_handler()->agent();
-        PacketBufferPtr pkt(agent->pkt()->packet_buffer_manager()->Allocate
-            (PktHandler::RX_PACKET, read_buff_, kMaxPacketSize, 0, length,
-             0));
-        VrouterControlInterface::Process(pkt);
+        uint8_t *buff = read_buff_;
+        read_buff_ = NULL;
+        ProcessReadBatch(buff, length,
+                         boost::bind(&Pkt0Socket::ReadNonBlocking, this,
+                                     _1, _2, _3));
     }
 
     AsyncRead();
 }
 
+std::size_t Pkt0Socket::ReadNonBlocking(uint8_t *buff, std::size_t len,
+                                        boost::system::error_code &error) {
+    if (socket_.non_blocking() == false) {
+        socket_.non_blocking(true, error);
+        if (error)
+            return 0;
+    }
+    return socket_.receive(boost::asio::buffer(buff, len), 0, error);
+}
+
 void Pkt0Socket::WriteHandler(const boost::system::error_code &error,
                               std::size_t length, PacketBufferPtr pkt,
                               uint8_t *buff) {
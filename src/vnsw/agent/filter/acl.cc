@@ -24,6 +24,7 @@
 
 #include <filter/acl.h>
 #include <cmn/agent_cmn.h>
+#include <init/agent_param.h>
 #include <oper/vn.h>
 #include <oper/sg.h>
 #include <oper/vrf.h>
@@ -44,6 +45,11 @@ FlowPolicyInfo::FlowPolicyInfo(const std::string &u)
       src_match_vn(), dst_match_vn(), acl_name() {
 }
 
+FlowPolicyInfo::FlowPolicyInfo(const InternedString &u)
+    : uuid(u), drop(false), terminal(false), other(false),
+      src_match_vn(), dst_match_vn(), acl_name() {
+}
+
 bool AclDBEntry::IsLess(const DBEntry &rhs) const {
     const AclDBEntry &a = static_cast<const AclDBEntry &>(rhs);
     return (uuid_ < a.uuid_);
@@ -116,6 +122,7 @@ DBEntry *AclTable::OperDBAdd(const DBRequest *req) {
          ++it) {
         acl->AddAclEntry(*it, acl->acl_entries_);
     }
+    acl->UpdateClassifier(classifier_enable());
 
     AclSandeshData sandesh_data;
     acl->SetAclSandeshData(sandesh_data);
@@ -147,6 +154,7 @@ bool AclTable::OperDBOnChange(DBEntry *entry, const DBRequest *req) {
 
     if (data->ace_id_to_del_) {
         acl->DeleteAclEntry(data->ace_id_to_del_);
+        acl->UpdateClassifier(classifier_enable());
         return true;
     }
 
@@ -175,7 +183,9 @@ bool AclTable::OperDBOnChange(DBEntry *entry, const DBRequest *req) {
         }
     }
 
-    if (changed == false) {
+    if (changed) {
+        acl->UpdateClassifier(classifier_enable());
+    } else {
         //Remove temporary create acl entries
         AclDBEntry::AclEntries::iterator iter;
         iter = entries.begin();
@@ -208,6 +218,10 @@ bool AclTable::OperDBDelete(DBEntry *entry, const DBRequest *req) {
     return true;
 }
 
+bool AclTable::classifier_enable() const {
+    return agent()->params()->acl_classifier();
+}
+
 void AclTable::ActionInit() {
     ta_map_["deny"] = TrafficAction::DENY;
     ta_map_["pass"] = TrafficAction::PASS;
@@ -773,6 +787,7 @@ bool AclDBEntry::DeleteAclEntry(const uint32_t acl_entry_id)
         AclEntryID ace_id(acl_entry_id);
         if (ace_id == iter->id()) {
             AclEntry *ae = iter.operator->();
+            classifier_.reset();
             acl_entries_.erase(acl_entries_.iterator_to(*iter));
             ACL_TRACE(Info, "acl entry " + integerToString(acl_entry_id) + " deleted");
             delete ae;
@@ -785,6 +800,7 @@ bool AclDBEntry::DeleteAclEntry(const uint32_t acl_entry_id)
 
 void AclDBEntry::DeleteAllAclEntries()
 {
+    classifier_.reset();
     AclEntries::iterator iter;
     iter = acl_entries_.begin();
     while (iter != acl_entries_.end()) {
@@ -798,90 +814,136 @@ void AclDBEntry::DeleteAllAclEntries()
 bool AclDBEntry::PacketMatch(const PacketHeader &packet_header,
                              MatchAclParams &m_acl, FlowPolicyInfo *info) const
 {
-    AclEntries::const_iterator iter;
     bool ret_val = false;
     m_acl.terminal_rule = false;
     m_acl.action_info.action = 0;
 
+    if (classifier_.get() != NULL) {
+        const AclClassifier::RuleIndexList &list =
+            classifier_->Lookup(packet_header.protocol);
+        AclClassifier::RuleIndexList::const_iterator it;
+        for (it = list.begin(); it != list.end(); ++it) {
+            const AclClassifier::Rule &rule = classifier_->rule(*it);
+            if (rule.MayMatch(packet_header, info != NULL) == false) {
+                continue;
+            }
+            if (AclEntryPacketMatch(*rule.entry, packet_header, m_acl, info)) {
+                ret_val = true;
+                if (m_acl.terminal_rule)
+                    return ret_val;
+            }
+        }
+        return ret_val;
+    }
+
+    AclEntries::const_iterator iter;
     for (iter = acl_entries_.begin();
          iter != acl_entries_.end();
          ++iter) {
-        /* Check  if packet and acl_entry address_family match */
-        if (iter->family() != Address::UNSPEC &&
-            packet_header.family != Address::UNSPEC &&
-            packet_header.family != iter->family()) {
-            continue;
+        if (AclEntryPacketMatch(*iter, packet_header, m_acl, info)) {
+            ret_val = true;
+            if (m_acl.terminal_rule)
+                return ret_val;
         }
-        const AclEntry::ActionList &al = iter->PacketMatch(packet_header, info);
-    AclEntry::ActionList::const_iterator al_it;
-    for (al_it = al.begin(); al_it != al.end(); ++al_it) {
-         TrafficAction *ta = static_cast<TrafficAction *>(*al_it.operator->());
-         m_acl.action_info.action |= 1 << ta->action();
-         if (ta->action_type() == TrafficAction::MIRROR_ACTION) {
-             MirrorAction *a = static_cast<MirrorAction *>(*al_it.operator->());
-                 MirrorActionSpec as;
-         as.ip = a->GetIp();
-         as.port = a->GetPort();
-                 as.vrf_name = a->vrf_name();
-                 as.analyzer_name = a->GetAnalyzerName();
-                 as.encap = a->GetEncap();
-                 m_acl.action_info.mirror_l.push_back(as);
-         }
-         if (ta->action_type() == TrafficAction::VRF_TRANSLATE_ACTION) {
-             const VrfTranslateAction *a =
-                 static_cast<VrfTranslateAction *>(*al_it.operator->());
-             VrfTranslateActionSpec vrf_translate_action(a->vrf_name(),
-                                                         a->ignore_acl());
-             m_acl.action_info.vrf_translate_action_ = vrf_translate_action;
-         }
-         if (ta->action_type() == TrafficAction::QOS_ACTION) {
-             const QosConfigAction *a =
-                 static_cast<const QosConfigAction *>(*al_it.operator->());
-             if (a->qos_config_ref() != NULL) {
-                 QosConfigActionSpec qos_action_spec(a->name());
-                 if (a->qos_config_ref() &&
-                     a->qos_config_ref()->IsDeleted() == false) {
-                     qos_action_spec.set_id(a->qos_config_ref()->id());
-                     m_acl.action_info.qos_config_action_ = qos_action_spec;
-                 }
-             }
-         }
+    }
+    return ret_val;
+}
 
-         if (info && ta->IsDrop()) {
-             if (!info->drop) {
-                 info->drop = true;
-                 info->terminal = false;
-                 info->other = false;
-                 info->uuid = iter->uuid();
-                 info->acl_name = GetName();
-             }
-         }
+bool AclDBEntry::AclEntryPacketMatch(const AclEntry &ace,
+                                     const PacketHeader &packet_header,
+                                     MatchAclParams &m_acl,
+                                     FlowPolicyInfo *info) const
+{
+    /* Check  if packet and acl_entry address_family match */
+    if (ace.family() != Address::UNSPEC &&
+        packet_header.family != Address::UNSPEC &&
+        packet_header.family != ace.family()) {
+        return false;
     }
-        if (!(al.empty())) {
-            ret_val = true;
-            m_acl.ace_id_list.push_back(iter->id());
-            if (iter->IsTerminal()) {
-                m_acl.terminal_rule = true;
-                /* Set uuid only if it is NOT already set as
-                 * drop/terminal uuid */
-                if (info && !info->drop && !info->terminal) {
-                    info->terminal = true;
-                    info->other = false;
-                    info->uuid = iter->uuid();
-                    info->acl_name = GetName();
+    const AclEntry::ActionList &al = ace.PacketMatch(packet_header, info);
+    AclEntry::ActionList::const_iterator al_it;
+    for (al_it = al.begin(); al_it != al.end(); ++al_it) {
+        TrafficAction *ta = static_cast<TrafficAction *>(*al_it.operator->());
+        m_acl.action_info.action |= 1 << ta->action();
+        if (ta->action_type() == TrafficAction::MIRROR_ACTION) {
+            MirrorAction *a = static_cast<MirrorAction *>(*al_it.operator->());
+            MirrorActionSpec as;
+            as.ip = a->GetIp();
+            as.port = a->GetPort();
+            as.vrf_name = a->vrf_name();
+            as.analyzer_name = a->GetAnalyzerName();
+            as.encap = a->GetEncap();
+            m_acl.action_info.mirror_l.push_back(as);
+        }
+        if (ta->action_type() == TrafficAction::VRF_TRANSLATE_ACTION) {
+            const VrfTranslateAction *a =
+                static_cast<VrfTranslateAction *>(*al_it.operator->());
+            VrfTranslateActionSpec vrf_translate_action(a->vrf_name(),
+                                                        a->ignore_acl());
+            m_acl.action_info.vrf_translate_action_ = vrf_translate_action;
+        }
+        if (ta->action_type() == TrafficAction::QOS_ACTION) {
+            const QosConfigAction *a =
+                static_cast<const QosConfigAction *>(*al_it.operator->());
+            if (a->qos_config_ref() != NULL) {
+                QosConfigActionSpec qos_action_spec(a->name());
+                if (a->qos_config_ref() &&
+                    a->qos_config_ref()->IsDeleted() == false) {
+                    qos_action_spec.set_id(a->qos_config_ref()->id());
+                    m_acl.action_info.qos_config_action_ = qos_action_spec;
                 }
-                return ret_val;
             }
-            /* If the ace action is not drop and if ace is not terminal rule
-             * then set the uuid with the first matching uuid */
-            if (info && !info->drop && !info->terminal && !info->other) {
-                info->other = true;
-                info->uuid = iter->uuid();
+        }
+
+        if (info && ta->IsDrop()) {
+            if (!info->drop) {
+                info->drop = true;
+                info->terminal = false;
+                info->other = false;
+                info->uuid = ace.interned_uuid();
                 info->acl_name = GetName();
             }
         }
     }
-    return ret_val;
+
+    if (al.empty()) {
+        return false;
+    }
+
+    m_acl.ace_id_list.push_back(ace.id());
+    if (ace.IsTerminal()) {
+        m_acl.terminal_rule = true;
+        /* Set uuid only if it is NOT already set as
+         * drop/terminal uuid */
+        if (info && !info->drop && !info->terminal) {
+            info->terminal = true;
+            info->other = false;
+            info->uuid = ace.interned_uuid();
+            info->acl_name = GetName();
+        }
+        return true;
+    }
+    /* If the ace action is not drop and if ace is not terminal rule
+     * then set the uuid with the first matching uuid */
+    if (info && !info->drop && !info->terminal && !info->other) {
+        info->other = true;
+        info->uuid = ace.interned_uuid();
+        info->acl_name = GetName();
+    }
+    return true;
+}
+
+void AclDBEntry::UpdateClassifier(bool enable) {
+    classifier_.reset();
+    if (enable == false)
+        return;
+
+    AclClassifier::AclEntryList entries;
+    AclEntries::const_iterator it;
+    for (it = acl_entries_.begin(); it != acl_entries_.end(); ++it) {
+        entries.push_back(it.operator->());
+    }
+    classifier_.reset(new AclClassifier(entries));
 }
 
 const AclEntry*
@@ -14,6 +14,7 @@
 #include <filter/acl_entry_match.h>
 #include <filter/acl_entry_spec.h>
 #include <filter/acl_entry.h>
+#include <filter/acl_classifier.h>
 #include <filter/packet_header.h>
 
 struct FlowKey;
@@ -21,7 +22,7 @@ class VnEntry;
 class Interface;
 
 struct FlowPolicyInfo {
-    std::string uuid;
+    InternedString uuid;
     bool drop;
     bool terminal;
     bool other;
@@ -29,6 +30,7 @@ struct FlowPolicyInfo {
     std::string dst_match_vn;  // destination VN that matched
     std::string acl_name;
     FlowPolicyInfo(const std::string &u);
+    explicit FlowPolicyInfo(const InternedString &u);
 };
 
 struct FlowAction {
@@ -127,6 +129,10 @@ public:
     // Packet Match
     bool PacketMatch(const PacketHeader &packet_header, MatchAclParams &m_acl,
                      FlowPolicyInfo *info) const;
+    // Rebuild the classifier after a change to entries. The classifier is
+    // used by PacketMatch when enabled
+    void UpdateClassifier(bool enable);
+    const AclClassifier *classifier() const { return classifier_.get(); }
     bool Changed(const AclEntries &new_acl_entries) const;
     uint32_t ace_count() const { return acl_entries_.size();}
     bool IsRulePresent(const std::string &uuid) const;
@@ -136,10 +142,17 @@ public:
     const AclEntry* GetAclEntryAtIndex(uint32_t) const;
 private:
     friend class AclTable;
+    // Match packet against an entry and update m_acl and info on a match
+    bool AclEntryPacketMatch(const AclEntry &ace,
+                             const PacketHeader &packet_header,
+                             MatchAclParams &m_acl,
+                             FlowPolicyInfo *info) const;
+
     boost::uuids::uuid uuid_;
     bool dynamic_acl_;
     std::string name_;
     AclEntries acl_entries_;
+    std::unique_ptr<AclClassifier> classifier_;
     DISALLOW_COPY_AND_ASSIGN(AclDBEntry);
 };
 
@@ -194,6 +207,7 @@ public:
     void Notify(DBTablePartBase *partition, DBEntryBase *e);
     void AddUnresolvedEntry(AclDBEntry *entry);
     void DeleteUnresolvedEntry(AclDBEntry *entry);
+    bool classifier_enable() const;
 private:
     bool SubnetTypeEqual(const autogen::SubnetType &lhs,
                          const autogen::SubnetType &rhs) const;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <map>
+#include <netinet/in.h>
+
+#include <filter/acl_classifier.h>
+#include <filter/acl_entry.h>
+#include <filter/acl_entry_match.h>
+#include <filter/packet_header.h>
+
+static void SetProtocolRange(std::bitset<AclClassifier::kProtocolCount> *set,
+                             uint16_t min, uint16_t max) {
+    for (uint32_t proto = min;
+         proto <= max && proto < AclClassifier::kProtocolCount; proto++) {
+        set->set(proto);
+    }
+}
+
+AclClassifier::Rule::Rule(const AclEntry *ace) :
+    entry(ace), protocols(), dst_ports(), updates_info(false) {
+    protocols.set();
+    for (uint32_t i = 0; i < ace->match_count(); i++) {
+        const AclEntryMatch *match = ace->Get(i);
+        switch (match->type()) {
+        case AclEntryMatch::PROTOCOL_MATCH: {
+            const ProtocolMatch *proto_match =
+                static_cast<const ProtocolMatch *>(match);
+            std::bitset<kProtocolCount> set;
+            RangeSList::const_iterator it =
+                proto_match->protocol_ranges().begin();
+            for (; it != proto_match->protocol_ranges().end(); ++it) {
+                SetProtocolRange(&set, it->min, it->max);
+            }
+            protocols &= set;
+            break;
+        }
+
+        case AclEntryMatch::SERVICE_GROUP_MATCH: {
+            const ServiceGroupMatch *sg_match =
+                static_cast<const ServiceGroupMatch *>(match);
+            std::bitset<kProtocolCount> set;
+            ServiceGroupMatch::ServicePortList::const_iterator it =
+                sg_match->service_port_list().begin();
+            for (; it != sg_match->service_port_list().end(); ++it) {
+                SetProtocolRange(&set, it->protocol.min, it->protocol.max);
+            }
+            protocols &= set;
+            break;
+        }
+
+        case AclEntryMatch::DESTINATION_PORT_MATCH: {
+            const DstPortMatch *port_match =
+                static_cast<const DstPortMatch *>(match);
+            RangeSList::const_iterator it = port_match->port_ranges().begin();
+            for (; it != port_match->port_ranges().end(); ++it) {
+                dst_ports.push_back(std::make_pair(it->min, it->max));
+            }
+            // Port match without ranges fails for every TCP and UDP packet
+            if (dst_ports.empty()) {
+                protocols.reset(IPPROTO_TCP);
+                protocols.reset(IPPROTO_UDP);
+            }
+            break;
+        }
+
+        case AclEntryMatch::ADDRESS_MATCH: {
+            const AddressMatch *addr_match =
+                static_cast<const AddressMatch *>(match);
+            if (addr_match->addr_type() == AddressMatch::NETWORK_ID)
+                updates_info = true;
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+bool AclClassifier::Rule::MayMatch(const PacketHeader &header,
+                                   bool update_info) const {
+    if (update_info && updates_info)
+        return true;
+
+    if (protocols.test(header.protocol) == false)
+        return false;
+
+    if (dst_ports.empty())
+        return true;
+
+    if (header.protocol != IPPROTO_TCP && header.protocol != IPPROTO_UDP)
+        return true;
+
+    std::vector<std::pair<uint16_t, uint16_t> >::const_iterator it;
+    for (it = dst_ports.begin(); it != dst_ports.end(); ++it) {
+        if (header.dst_port >= it->first && header.dst_port <= it->second)
+            return true;
+    }
+    return false;
+}
+
+AclClassifier::AclClassifier(const AclEntryList &entries) {
+    rules_.reserve(entries.size());
+    for (AclEntryList::const_iterator it = entries.begin();
+         it != entries.end(); ++it) {
+        rules_.push_back(Rule(*it));
+    }
+
+    // Build the list of rules for each protocol, sharing identical lists
+    std::map<RuleIndexList, uint32_t> list_map;
+    for (uint32_t proto = 0; proto < kProtocolCount; proto++) {
+        RuleIndexList list;
+        for (uint32_t i = 0; i < rules_.size(); i++) {
+            if (rules_[i].updates_info || rules_[i].protocols.test(proto))
+                list.push_back(i);
+        }
+
+        std::pair<std::map<RuleIndexList, uint32_t>::iterator, bool> ret =
+            list_map.insert(std::make_pair(list, lists_.size()));
+        if (ret.second)
+            lists_.push_back(list);
+        list_index_[proto] = ret.first->second;
+    }
+}
+
+AclClassifier::~AclClassifier() {
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef __AGENT_ACL_CLASSIFIER_H__
+#define __AGENT_ACL_CLASSIFIER_H__
+
+#include <bitset>
+#include <utility>
+#include <vector>
+
+#include <cmn/agent_cmn.h>
+
+class AclEntry;
+struct PacketHeader;
+
+/////////////////////////////////////////////////////////////////////////////
+// Classifier compiled from the entries of an ACL to reduce the entries
+// evaluated for a packet.
+//
+// Entries are classified on the IP protocol. For every protocol, the
+// classifier keeps the ordered list of entries that can match a packet of
+// the protocol. Protocols with the same list of entries share the list, so
+// an ACL with rules on tcp, udp and any protocol keeps 3 or 4 lists.
+// Entries of a list are further checked against destination port ranges of
+// TCP and UDP packets before the entry is evaluated.
+//
+// Entries matching on virtual-network update src_match_vn and dst_match_vn
+// of FlowPolicyInfo even when the entry does not match. Such entries are
+// kept in every list and are always evaluated when FlowPolicyInfo is passed,
+// so that the result is the same as evaluating all entries in order.
+//
+// The classifier keeps pointers to the entries and must be rebuilt whenever
+// the entries of the ACL change.
+/////////////////////////////////////////////////////////////////////////////
+class AclClassifier {
+public:
+    static const uint32_t kProtocolCount = 256;
+
+    struct Rule {
+        explicit Rule(const AclEntry *ace);
+
+        // Returns false if the entry can not match the packet. Entries
+        // updating FlowPolicyInfo are never skipped if update_info is set
+        bool MayMatch(const PacketHeader &header, bool update_info) const;
+
+        const AclEntry *entry;
+        std::bitset<kProtocolCount> protocols;
+        // Destination port ranges for TCP and UDP, empty to match any port
+        std::vector<std::pair<uint16_t, uint16_t> > dst_ports;
+        bool updates_info;
+    };
+
+    typedef std::vector<const AclEntry *> AclEntryList;
+    typedef std::vector<Rule> RuleList;
+    typedef std::vector<uint32_t> RuleIndexList;
+
+    explicit AclClassifier(const AclEntryList &entries);
+    ~AclClassifier();
+
+    const Rule &rule(uint32_t index) const { return rules_[index]; }
+    size_t rule_count() const { return rules_.size(); }
+    // Ordered list of index of the rules to evaluate for the protocol
+    const RuleIndexList &Lookup(uint8_t protocol) const {
+        return lists_[list_index_[protocol]];
+    }
+    size_t list_count() const { return lists_.size(); }
+
+private:
+    RuleList rules_;
+    std::vector<RuleIndexList> lists_;
+    uint8_t list_index_[kProtocolCount];
+    DISALLOW_COPY_AND_ASSIGN(AclClassifier);
+};
+
+#endif  // __AGENT_ACL_CLASSIFIER_H__
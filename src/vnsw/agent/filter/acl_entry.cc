@@ -276,7 +276,7 @@ void AclEntry::SetAclEntrySandeshData(AclEntrySandeshData &data) const {
         data.ace_id = id_.id_;
     }
     // UUID
-    data.uuid = uuid_;
+    data.uuid = uuid_.get();
 
     // Setting ether_type based on AclEntry address_family
     data.ether_type = "IPv4";
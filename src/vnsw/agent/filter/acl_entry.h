@@ -11,6 +11,7 @@
 #include <boost/uuid/uuid.hpp>
 
 #include <cmn/agent_cmn.h>
+#include <cmn/interned_string.h>
 #include <cmn/agent.h>
 
 #include <agent_types.h>
@@ -118,7 +119,9 @@ public:
     bool IsTerminal() const;
 
     const AclEntryID& id() const { return id_; }
-    const std::string &uuid() const { return uuid_; }
+    const std::string &uuid() const { return uuid_.get(); }
+    // Uuid shared with the flows matching the entry
+    const InternedString &interned_uuid() const { return uuid_; }
 
     boost::intrusive::list_member_hook<> acl_list_node;
 
@@ -128,6 +131,7 @@ public:
     const AclEntryMatch* Get(uint32_t index) const {
         return matches_[index];
     }
+    uint32_t match_count() const { return matches_.size(); }
     const Address::Family& family() const { return family_ ;}
 
 private:
@@ -136,7 +140,7 @@ private:
     std::vector<AclEntryMatch *> matches_;
     ActionList actions_;
     MirrorEntryRef mirror_entry_;
-    std::string uuid_;
+    InternedString uuid_;
     Address::Family family_;
     DISALLOW_COPY_AND_ASSIGN(AclEntry);
 };
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <stdlib.h>
+#include "base/os.h"
+#include <test_cmn_util.h>
+#include <filter/acl.h>
+#include <filter/packet_header.h>
+
+void RouterIdDepInit(Agent *agent) {
+}
+
+namespace {
+static const int kVnCount = 4;
+static const uint32_t kPacketCount = 1000;
+
+class AclClassifierTest : public ::testing::Test {
+public:
+    AclClassifierTest() :
+        acl_(StringToUuid("00000000-0000-0000-0000-000000000001")),
+        compiled_acl_(StringToUuid("00000000-0000-0000-0000-000000000002")) {
+        for (int i = 0; i < kVnCount; i++) {
+            vn_list_[i].insert("vn" + integerToString(i));
+        }
+    }
+
+    virtual void SetUp() {
+        srand(0);
+    }
+
+    virtual void TearDown() {
+        acl_.DeleteAllAclEntries();
+        compiled_acl_.DeleteAllAclEntries();
+        packets_.clear();
+    }
+
+    static uint16_t RandomProtocol() {
+        static const uint8_t protocols[] = {
+            IPPROTO_TCP, IPPROTO_UDP, IPPROTO_ICMP, IPPROTO_SCTP, 47
+        };
+        return protocols[rand() % (sizeof(protocols) / sizeof(protocols[0]))];
+    }
+
+    static RangeSpec MakeRange(uint16_t min, uint16_t max) {
+        RangeSpec range;
+        range.min = min;
+        range.max = max;
+        return range;
+    }
+
+    static std::string RandomAddress() {
+        return "10.0." + integerToString(rand() % 4) + "." +
+            integerToString(rand() % 256);
+    }
+
+    // Rule on protocol, ports and address similar to a network policy or
+    // security group
+    static AclEntrySpec RandomRule(uint32_t id) {
+        AclEntrySpec spec;
+        spec.id = id;
+        spec.rule_uuid = "rule-" + integerToString(id);
+        spec.terminal = (rand() % 8) == 0;
+
+        uint16_t proto = RandomProtocol();
+        switch (rand() % 8) {
+        case 0:
+            break;
+        case 1:
+            spec.protocol.push_back(MakeRange(0, 255));
+            break;
+        case 2:
+            spec.protocol.push_back(MakeRange(IPPROTO_TCP, IPPROTO_UDP));
+            break;
+        default:
+            spec.protocol.push_back(MakeRange(proto, proto));
+            break;
+        }
+
+        if (rand() % 4) {
+            uint16_t port = rand() % 1024;
+            spec.dst_port.push_back(MakeRange(port, port + rand() % 2 * 100));
+        }
+        if (rand() % 8 == 0) {
+            spec.src_port.push_back(MakeRange(1024, 65535));
+        }
+        if (rand() % 8 == 0) {
+            ServicePort service_port;
+            service_port.protocol.min = service_port.protocol.max = proto;
+            service_port.src_port.min = 0;
+            service_port.src_port.max = 65535;
+            service_port.dst_port.min = 0;
+            service_port.dst_port.max = rand() % 1024;
+            spec.service_group.push_back(service_port);
+        }
+
+        switch (rand() % 4) {
+        case 0:
+            spec.src_addr_type = AddressMatch::IP_ADDR;
+            spec.BuildAddressInfo(RandomAddress(), 24 + rand() % 9,
+                                  &spec.src_ip_list);
+            break;
+        case 1:
+            spec.src_addr_type = AddressMatch::NETWORK_ID;
+            spec.src_policy_id_str = "vn" + integerToString(rand() % kVnCount);
+            break;
+        default:
+            break;
+        }
+        if (rand() % 4 == 0) {
+            spec.dst_addr_type = AddressMatch::NETWORK_ID;
+            spec.dst_policy_id_str = "vn" + integerToString(rand() % kVnCount);
+        }
+
+        ActionSpec action;
+        action.ta_type = TrafficAction::SIMPLE_ACTION;
+        action.simple_action = (rand() % 4) ? TrafficAction::PASS :
+            TrafficAction::DENY;
+        spec.action_l.push_back(action);
+        return spec;
+    }
+
+    void AddRules(uint32_t count) {
+        AclDBEntry::AclEntries entries;
+        AclDBEntry::AclEntries compiled_entries;
+        for (uint32_t id = 1; id <= count; id++) {
+            AclEntrySpec spec = RandomRule(id);
+            acl_.AddAclEntry(spec, entries);
+            compiled_acl_.AddAclEntry(spec, compiled_entries);
+        }
+        acl_.SetAclEntries(entries);
+        compiled_acl_.SetAclEntries(compiled_entries);
+        compiled_acl_.UpdateClassifier(true);
+    }
+
+    void AddPackets(uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            PacketHeader hdr;
+            hdr.family = Address::INET;
+            hdr.src_ip = IpAddress::from_string(RandomAddress());
+            hdr.dst_ip = IpAddress::from_string(RandomAddress());
+            hdr.protocol = (rand() % 8) ? RandomProtocol() : rand() % 256;
+            hdr.src_port = rand() % 65536;
+            hdr.dst_port = (rand() % 2) ? rand() % 1200 : rand() % 65536;
+            hdr.src_policy_id = &vn_list_[rand() % kVnCount];
+            hdr.dst_policy_id = &vn_list_[rand() % kVnCount];
+            hdr.src_sg_id_l = NULL;
+            hdr.dst_sg_id_l = NULL;
+            packets_.push_back(hdr);
+        }
+    }
+
+    // Match all packets with and without classifier and compare results
+    void Verify() {
+        for (uint32_t i = 0; i < packets_.size(); i++) {
+            MatchAclParams m_acl;
+            MatchAclParams compiled_m_acl;
+            FlowPolicyInfo info("");
+            FlowPolicyInfo compiled_info("");
+            bool ret = acl_.PacketMatch(packets_[i], m_acl, &info);
+            EXPECT_EQ(ret, compiled_acl_.PacketMatch(packets_[i],
+                                                     compiled_m_acl,
+                                                     &compiled_info));
+            EXPECT_TRUE(m_acl.ace_id_list == compiled_m_acl.ace_id_list);
+            EXPECT_EQ(m_acl.terminal_rule, compiled_m_acl.terminal_rule);
+            EXPECT_EQ(m_acl.action_info.action,
+                      compiled_m_acl.action_info.action);
+            EXPECT_EQ(info.uuid, compiled_info.uuid);
+            EXPECT_EQ(info.drop, compiled_info.drop);
+            EXPECT_EQ(info.terminal, compiled_info.terminal);
+            EXPECT_EQ(info.other, compiled_info.other);
+            EXPECT_EQ(info.src_match_vn, compiled_info.src_match_vn);
+            EXPECT_EQ(info.dst_match_vn, compiled_info.dst_match_vn);
+
+            MatchAclParams no_info_m_acl;
+            EXPECT_EQ(ret, compiled_acl_.PacketMatch(packets_[i],
+                                                     no_info_m_acl, NULL));
+            EXPECT_TRUE(m_acl.ace_id_list == no_info_m_acl.ace_id_list);
+            EXPECT_EQ(m_acl.action_info.action,
+                      no_info_m_acl.action_info.action);
+        }
+    }
+
+    VnListType vn_list_[kVnCount];
+    AclDBEntry acl_;
+    AclDBEntry compiled_acl_;
+    std::vector<PacketHeader> packets_;
+};
+
+// Classifier results match linear match of the entries
+TEST_F(AclClassifierTest, Verify) {
+    AddRules(200);
+    AddPackets(10 * kPacketCount);
+    Verify();
+    EXPECT_EQ(200U, compiled_acl_.classifier()->rule_count());
+}
+
+// Lists are shared by protocols with the same entries
+TEST_F(AclClassifierTest, SharedList) {
+    AclDBEntry::AclEntries entries;
+    AclEntrySpec spec;
+    spec.id = 1;
+    spec.terminal = false;
+    spec.protocol.push_back(MakeRange(IPPROTO_TCP, IPPROTO_TCP));
+    ActionSpec action;
+    action.ta_type = TrafficAction::SIMPLE_ACTION;
+    action.simple_action = TrafficAction::PASS;
+    spec.action_l.push_back(action);
+    compiled_acl_.AddAclEntry(spec, entries);
+    spec.id = 2;
+    spec.protocol.clear();
+    compiled_acl_.AddAclEntry(spec, entries);
+    compiled_acl_.SetAclEntries(entries);
+    compiled_acl_.UpdateClassifier(true);
+
+    const AclClassifier *classifier = compiled_acl_.classifier();
+    EXPECT_EQ(2U, classifier->list_count());
+    EXPECT_EQ(2U, classifier->Lookup(IPPROTO_TCP).size());
+    EXPECT_EQ(1U, classifier->Lookup(IPPROTO_UDP).size());
+    EXPECT_EQ(1U, classifier->Lookup(IPPROTO_ICMP).size());
+
+    compiled_acl_.DeleteAclEntry(1);
+    EXPECT_TRUE(compiled_acl_.classifier() == NULL);
+    compiled_acl_.UpdateClassifier(false);
+    EXPECT_TRUE(compiled_acl_.classifier() == NULL);
+}
+} //namespace
+
+int main (int argc, char **argv) {
+    GETUSERARGS();
+    client = TestInit(init_file, ksync_init);
+
+    int ret = RUN_ALL_TESTS();
+    TestShutdown();
+    delete client;
+    return ret;
+}
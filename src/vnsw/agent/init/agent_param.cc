@@ -708,6 +708,8 @@ void AgentParam::ParseFlowArguments
                           "FLOWS.update_tokens");
     GetOptValue<bool>(var_map, flow_hash_excl_rid_,
                       "FLOWS.hash_exclude_router_id");
+    GetOptValue<bool>(var_map, flow_hash_index_, "FLOWS.hash_index");
+    GetOptValue<bool>(var_map, acl_classifier_, "FLOWS.acl_classifier");
     GetOptValue<uint16_t>(var_map, max_sessions_per_aggregate_,
                           "FLOWS.max_sessions_per_aggregate");
     GetOptValue<uint16_t>(var_map, max_aggregates_per_session_endpoint_,
@@ -1385,6 +1387,8 @@ void AgentParam::LogConfig() const {
     LOG(DEBUG, "Flow ksync-tokens           : " << flow_ksync_tokens_);
     LOG(DEBUG, "Flow del-tokens             : " << flow_del_tokens_);
     LOG(DEBUG, "Flow update-tokens          : " << flow_update_tokens_);
+    LOG(DEBUG, "Flow hash index             : " << flow_hash_index_);
+    LOG(DEBUG, "ACL classifier              : " << acl_classifier_);
     LOG(DEBUG, "Pin flow netlink task to CPU: "
         << ksync_thread_cpu_pin_policy_);
     LOG(DEBUG, "Maximum sessions            : " << max_sessions_per_aggregate_);
@@ -1551,6 +1555,8 @@ AgentParam::AgentParam(bool enable_flow_options,
         flow_thread_count_(Agent::kDefaultFlowThreadCount),
         flow_trace_enable_(true),
         flow_hash_excl_rid_(false),
+        flow_hash_index_(false),
+        acl_classifier_(false),
         flow_latency_limit_(Agent::kDefaultFlowLatencyLimit),
         max_sessions_per_aggregate_(Agent::kMaxSessions),
         max_aggregates_per_session_endpoint_(Agent::kMaxSessionAggs),
@@ -2009,6 +2015,10 @@ AgentParam::AgentParam(bool enable_flow_options,
              "Number of update-tokens")
             ("FLOWS.hash_exclude_router_id", opt::value<bool>(),
              "Exclude router-id in hash calculation")
+            ("FLOWS.hash_index", opt::value<bool>()->default_value(false),
+             "Index flows in a hash table instead of a tree")
+            ("FLOWS.acl_classifier", opt::value<bool>()->default_value(false),
+             "Match flows against ACLs using a classifier built on ACL change")
             ("FLOWS.index_sm_log_count", opt::value<uint16_t>()->default_value(Agent::kDefaultFlowIndexSmLogCount),
              "Index Sm Log Count")
             ("FLOWS.latency_limit", opt::value<uint16_t>()->default_value(Agent::kDefaultFlowLatencyLimit),
@@ -431,6 +431,12 @@ public:
 
     bool flow_use_rid_in_hash() const { return !flow_hash_excl_rid_; }
 
+    bool flow_hash_index() const { return flow_hash_index_; }
+    void set_flow_hash_index(bool val) { flow_hash_index_ = val; }
+
+    bool acl_classifier() const { return acl_classifier_; }
+    void set_acl_classifier(bool val) { acl_classifier_ = val; }
+
     uint16_t flow_task_latency_limit() const { return flow_latency_limit_; }
     void set_flow_task_latency_limit(uint16_t count) {
         flow_latency_limit_ = count;
@@ -792,6 +798,8 @@ private:
     uint16_t flow_thread_count_;
     bool flow_trace_enable_;
     bool flow_hash_excl_rid_;
+    bool flow_hash_index_;
+    bool acl_classifier_;
     uint16_t flow_latency_limit_;
     uint16_t max_sessions_per_aggregate_;
     uint16_t max_aggregates_per_session_endpoint_;
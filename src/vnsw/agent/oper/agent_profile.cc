@@ -147,8 +147,13 @@ void ProfileData::FlowStats::Reset() {
     reval_count_ = 0;
     recompute_count_ = 0;
     pkt_handler_queue_.Reset();
-    flow_mgmt_queue_.Reset();
     flow_update_queue_.Reset();
+    for (uint16_t i = 0; i < flow_mgmt_queue_.size(); i++) {
+        flow_mgmt_queue_[i].Reset();
+    }
+    for (uint16_t i = 0; i < flow_mgmt_db_queue_.size(); i++) {
+        flow_mgmt_db_queue_[i].Reset();
+    }
     for (uint16_t i = 0; i < flow_event_queue_.size(); i++) {
         flow_event_queue_[i].Reset();
     }
@@ -437,7 +442,7 @@ void SandeshTaskStatsRequest::HandleRequest() const {
 }
 
 static void GetOneQueueSummary(SandeshFlowQueueSummaryOneInfo *one,
-                               ProfileData::WorkQueueStats *stats) {
+                               const ProfileData::WorkQueueStats *stats) {
     one->set_qcount(stats->queue_count_);
     one->set_enqueues(stats->enqueue_count_);
     one->set_dequeues(stats->dequeue_count_);
@@ -446,6 +451,33 @@ static void GetOneQueueSummary(SandeshFlowQueueSummaryOneInfo *one,
     one->set_busy_msec(stats->busy_time_);
 }
 
+// Summary of a queue partitioned by flow table along with the per partition
+// summary
+static void GetQueueListSummary(SandeshFlowQueueSummaryOneInfo *summary,
+        std::vector<SandeshFlowQueueSummaryOneInfo> *partition_list,
+        const std::vector<ProfileData::WorkQueueStats> &stats_list) {
+    ProfileData::WorkQueueStats total;
+    total.Reset();
+    std::vector<ProfileData::WorkQueueStats>::const_iterator it =
+        stats_list.begin();
+    while (it != stats_list.end()) {
+        total.queue_count_ += it->queue_count_;
+        total.enqueue_count_ += it->enqueue_count_;
+        total.dequeue_count_ += it->dequeue_count_;
+        total.busy_time_ += it->busy_time_;
+        total.start_count_ += it->start_count_;
+        if (it->max_queue_count_ > total.max_queue_count_) {
+            total.max_queue_count_ = it->max_queue_count_;
+        }
+
+        SandeshFlowQueueSummaryOneInfo one;
+        GetOneQueueSummary(&one, &(*it));
+        partition_list->push_back(one);
+        it++;
+    }
+    GetOneQueueSummary(summary, &total);
+}
+
 static void GetQueueSummaryInfo(SandeshFlowQueueSummaryInfo *info, int index,
                                 ProfileData *data) {
     ProfileData::FlowStats *flow_stats = &data->flow_;
@@ -563,8 +595,17 @@ static void GetQueueSummaryInfo(SandeshFlowQueueSummaryInfo *info, int index,
     info->set_flow_ksync_queue(one);
 
     // flow_mgmt_queue
-    GetOneQueueSummary(&one, &flow_stats->flow_mgmt_queue_);
+    std::vector<SandeshFlowQueueSummaryOneInfo> partition_list;
+    GetQueueListSummary(&one, &partition_list, flow_stats->flow_mgmt_queue_);
     info->set_flow_mgmt_queue(one);
+    info->set_flow_mgmt_partition_queue(partition_list);
+
+    // flow_mgmt_db_queue
+    partition_list.clear();
+    GetQueueListSummary(&one, &partition_list,
+                        flow_stats->flow_mgmt_db_queue_);
+    info->set_flow_mgmt_db_queue(one);
+    info->set_flow_mgmt_db_partition_queue(partition_list);
 
     // flow_update_queue
     GetOneQueueSummary(&one, &flow_stats->flow_update_queue_);
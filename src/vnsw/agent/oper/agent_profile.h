@@ -62,8 +62,9 @@ public:
         uint64_t evict_count_;
         FlowTokenStats token_stats_;
         WorkQueueStats pkt_handler_queue_;
-        WorkQueueStats flow_mgmt_queue_;
         WorkQueueStats flow_update_queue_;
+        std::vector<WorkQueueStats> flow_mgmt_queue_;
+        std::vector<WorkQueueStats> flow_mgmt_db_queue_;
         std::vector<WorkQueueStats> flow_event_queue_;
         std::vector<WorkQueueStats> flow_tokenless_queue_;
         std::vector<WorkQueueStats> flow_delete_queue_;
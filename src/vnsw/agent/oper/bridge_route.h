@@ -21,6 +21,9 @@ public:
     virtual Agent::RouteTableType GetTableType() const {
         return Agent::BRIDGE;
     }
+    virtual PartitionIndexType GetPartitionIndexType() const {
+        return PARTITION_INDEX_FLAT;
+    }
     virtual AgentSandeshPtr GetAgentSandesh(const AgentSandeshArguments *args,
                                             const std::string &context);
 
@@ -8,6 +8,7 @@
 #include <atomic>
 
 #include <cmn/agent_cmn.h>
+#include <cmn/interned_string.h>
 #include <oper/oper_db.h>
 #include <agent_types.h>
 
@@ -42,7 +43,9 @@ public:
     virtual KeyPtr GetDBRequestKey() const;
     virtual void SetKey(const DBRequestKey *key);
     virtual string ToString() const;
-    const string &GetCfgName() const { return name_; }
+    const string &GetCfgName() const { return name_.get(); }
+    // Name shared with the flows of the VM
+    const InternedString &cfg_name() const { return name_; }
     void SetCfgName(std::string name) { name_ = name; }
 
     const boost::uuids::uuid &GetUuid() const { return uuid_; }
@@ -70,7 +73,7 @@ private:
     void SetInterfacesDropNewFlows(bool drop_new_flows) const;
     friend class VmTable;
     boost::uuids::uuid uuid_;
-    std::string name_;
+    InternedString name_;
     mutable std::atomic<int> flow_count_;
     mutable std::atomic<int> linklocal_flow_count_;
     mutable bool drop_new_flows_;
@@ -22,6 +22,8 @@ class PktHandler;
 class ControlInterface {
 public:
     static const uint32_t kMaxPacketSize = 9060;
+    // Max packets read from the interface on one read event
+    static const uint32_t kMaxReadBatch = 32;
 
     ControlInterface() { }
     virtual ~ControlInterface() { }
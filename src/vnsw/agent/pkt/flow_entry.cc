@@ -64,6 +64,30 @@ const std::map<FlowEntry::FlowPolicyState, const char*>
         (NON_IP_FLOW,              "00000000-0000-0000-0000-000000000006")
         (BGPROUTERSERVICE_FLOW,    "00000000-0000-0000-0000-000000000007");
 
+static std::vector<InternedString> BuildFlowPolicyStateUuids() {
+    std::vector<InternedString> uuids;
+    std::map<FlowEntry::FlowPolicyState, const char*>::const_iterator it;
+    for (it = FlowEntry::FlowPolicyStateStr.begin();
+         it != FlowEntry::FlowPolicyStateStr.end(); ++it) {
+        assert(static_cast<size_t>(it->first) == uuids.size());
+        uuids.push_back(InternedString(std::string(it->second)));
+    }
+    return uuids;
+}
+
+// Flows take the interned value, so that setting the state of a flow does
+// not look up the string in the intern table
+const InternedString &FlowEntry::FlowPolicyStateUuid(FlowPolicyState state) {
+    static const std::vector<InternedString> uuids =
+        BuildFlowPolicyStateUuids();
+    return uuids.at(state);
+}
+
+static const InternedString &EmptyInternedString() {
+    static const InternedString empty;
+    return empty;
+}
+
 const std::map<uint16_t, const char*>
     FlowEntry::FlowDropReasonStr = boost::assign::map_list_of
         ((uint16_t)DROP_UNKNOWN,                 "UNKNOWN")
@@ -314,7 +338,7 @@ void FlowData::Reset() {
     rpf_plen = Address::kMaxV4PrefixLen;
     rpf_vrf = VrfEntry::kInvalidIndex;
     disable_validation = false;
-    vm_cfg_name = "";
+    vm_cfg_name = EmptyInternedString();
     bgp_as_a_service_sport = 0;
     bgp_as_a_service_dport = 0;
     acl_assigned_vrf_index_ = VrfEntry::kInvalidIndex;
@@ -483,13 +507,13 @@ void FlowEntry::Reset() {
     flags_ = 0;
     hbs_intf_ = FlowEntry::HBS_INTERFACE_INVALID;
     short_flow_reason_ = SHORT_UNKNOWN;
-    peer_vrouter_ = "";
+    peer_vrouter_ = Ip4Address();
     tunnel_type_ = TunnelType::INVALID;
     on_tree_ = false;
     fip_ = 0;
     fip_vmi_ = VmInterfaceKey(AgentKey::ADD_DEL_CHANGE, nil_uuid(), "");
     refcount_ = 0;
-    nw_ace_uuid_ = FlowPolicyStateStr.at(NOT_EVALUATED);
+    nw_ace_uuid_ = FlowPolicyStateUuid(NOT_EVALUATED);
     fsc_ = NULL;
     trace_ = false;
     event_logs_.reset();
@@ -580,10 +604,7 @@ void intrusive_ptr_release(FlowEntry *fe) {
                 proto->ForceEnqueueFreeFlowReference(ref);
                 return;
             }
-            FlowTable::FlowEntryMap::iterator it =
-                flow_table->flow_entry_map_.find(fe->key());
-            assert(it != flow_table->flow_entry_map_.end());
-            flow_table->flow_entry_map_.erase(it);
+            assert(flow_table->flow_entry_map_.Erase(fe->key()));
             flow_table->agent()->stats()->decr_flow_count();
         }
         flow_table->free_list()->Free(fe);
@@ -609,6 +630,18 @@ static std::size_t HashIp(std::size_t hash, const IpAddress &ip) {
     }
     return hash;
 }
+
+std::size_t FlowKey::Hash() const {
+    std::size_t hash = 0;
+    hash = HashCombine(hash, family);
+    hash = HashCombine(hash, nh);
+    hash = HashIp(hash, src_addr);
+    hash = HashIp(hash, dst_addr);
+    hash = HashCombine(hash, protocol);
+    hash = HashCombine(hash, src_port);
+    hash = HashCombine(hash, dst_port);
+    return hash;
+}
 bool FlowEntry::InitFlowCmn(const PktFlowInfo *info, const PktControlInfo *ctrl,
                             const PktControlInfo *rev_ctrl,
                             FlowEntry *rflow) {
@@ -1080,7 +1113,7 @@ void FlowEntry::RevFlowDepInfo(RevFlowDepParams *params) {
     FlowEntry *rev_flow = reverse_flow_entry();
     if (rev_flow) {
         params->rev_uuid_ = rev_flow->uuid();
-        params->vm_cfg_name_ = rev_flow->data().vm_cfg_name;
+        params->vm_cfg_name_ = rev_flow->data().vm_cfg_name.get();
         params->sg_uuid_ = rev_flow->sg_rule_uuid();
         params->rev_egress_uuid_ = rev_flow->egress_uuid();
         params->nw_ace_uuid_ = rev_flow->nw_ace_uuid();
@@ -1645,18 +1678,19 @@ uint32_t FlowEntry::InterfaceKeyToId(Agent *agent, const VmInterfaceKey &key) {
     return Interface::kInvalidIndex;
 }
 
-const std::string FlowEntry::InterfaceIdToVmCfgName(Agent *agent, uint32_t id) {
+const InternedString &FlowEntry::InterfaceIdToVmCfgName(Agent *agent,
+                                                        uint32_t id) {
     if (id != Interface::kInvalidIndex) {
         const VmInterface *itf = dynamic_cast <const VmInterface *>
             (agent->interface_table()->FindInterface(id));
         if (itf) {
             const VmEntry *vm = itf->vm();
             if (vm) {
-                return vm->GetCfgName();
+                return vm->cfg_name();
             }
         }
     }
-    return "";
+    return EmptyInternedString();
 }
 /////////////////////////////////////////////////////////////////////////////
 // Routines to compute ACL to be applied (including network-policy, SG and
@@ -2236,11 +2270,11 @@ uint32_t FlowEntry::MatchAcl(const PacketHeader &hdr,
              * IMPLICIT_ALLOW
              */
             if (is_flags_set(FlowEntry::LinkLocalFlow)) {
-                info->uuid = FlowPolicyStateStr.at(LINKLOCAL_FLOW);
+                info->uuid = FlowPolicyStateUuid(LINKLOCAL_FLOW);
             } else if (is_flags_set(FlowEntry::Multicast)) {
-                info->uuid = FlowPolicyStateStr.at(MULTICAST_FLOW);
+                info->uuid = FlowPolicyStateUuid(MULTICAST_FLOW);
             } else if (is_flags_set(FlowEntry::BgpRouterService)) {
-                info->uuid = FlowPolicyStateStr.at(BGPROUTERSERVICE_FLOW);
+                info->uuid = FlowPolicyStateUuid(BGPROUTERSERVICE_FLOW);
             } else {
                 /* We need to make sure that info is not already populated
                  * before setting it to IMPLICIT_ALLOW. This is required
@@ -2249,7 +2283,7 @@ uint32_t FlowEntry::MatchAcl(const PacketHeader &hdr,
                  * for MatchAcl calls with in_acl and out_acl
                  */
                 if (!info->terminal && !info->other) {
-                    info->uuid = FlowPolicyStateStr.at(IMPLICIT_ALLOW);
+                    info->uuid = FlowPolicyStateUuid(IMPLICIT_ALLOW);
                 }
             }
         }
@@ -2264,7 +2298,7 @@ uint32_t FlowEntry::MatchAcl(const PacketHeader &hdr,
         (pkt_handler->IsGwPacket(data_.intf_entry.get(), hdr.dst_ip) ||
          pkt_handler->IsGwPacket(data_.intf_entry.get(), hdr.src_ip))) {
         if (info) {
-            info->uuid = FlowPolicyStateStr.at(DEFAULT_GW_ICMP_OR_DNS);
+            info->uuid = FlowPolicyStateUuid(DEFAULT_GW_ICMP_OR_DNS);
         }
         return (1 << TrafficAction::PASS);
     }
@@ -2296,7 +2330,7 @@ uint32_t FlowEntry::MatchAcl(const PacketHeader &hdr,
         action = (1 << TrafficAction::DENY) |
             (1 << TrafficAction::IMPLICIT_DENY);
         if (info) {
-            info->uuid = FlowPolicyStateStr.at(IMPLICIT_DENY);
+            info->uuid = FlowPolicyStateUuid(IMPLICIT_DENY);
             info->drop = true;
         }
     }
@@ -2424,7 +2458,7 @@ void FlowEntry::SessionMatch(SessionPolicy *sp, SessionPolicy *rsp,
                              bool is_sg) {
 
     FlowEntry *rflow = reverse_flow_entry();
-    const string value = FlowPolicyStateStr.at(NOT_EVALUATED);
+    const InternedString &value = FlowPolicyStateUuid(NOT_EVALUATED);
     FlowPolicyInfo acl_info(value);
     FlowPolicyInfo out_acl_info(value);
     FlowPolicyInfo rev_acl_info(value);
@@ -2562,7 +2596,7 @@ bool FlowEntry::DoPolicy() {
     data_.match_p.aps_policy.ResetAction();
     data_.match_p.fwaas_policy.ResetAction();
 
-    const string value = FlowPolicyStateStr.at(NOT_EVALUATED);
+    const InternedString &value = FlowPolicyStateUuid(NOT_EVALUATED);
     FlowPolicyInfo nw_acl_info(value);
 
     FlowEntry *rflow = reverse_flow_entry();
@@ -3597,6 +3631,14 @@ const std::string FlowEntry::RemotePrefix() const {
                              key_.src_addr);
 }
 
+/* Returns empty string if the peer vrouter is not known */
+const std::string FlowEntry::peer_vrouter() const {
+    if (peer_vrouter_.is_unspecified()) {
+        return "";
+    }
+    return peer_vrouter_.to_string();
+}
+
 void FlowEntry::FillUveVnAceInfo(FlowUveVnAcePolicyInfo *info) const {
     const VnEntry *vn = vn_entry();
     info->vn_ = vn? vn->GetName() : "";
@@ -15,6 +15,7 @@
 #include <base/address.h>
 #include <db/db_table_walker.h>
 #include <cmn/agent_cmn.h>
+#include <cmn/interned_string.h>
 #include <oper/mirror_table.h>
 #include <filter/traffic_action.h>
 #include <filter/acl_entry.h>
@@ -198,6 +199,8 @@ struct FlowKey {
         return true;
     }
 
+    std::size_t Hash() const;
+
     void Reset() {
         family = Address::UNSPEC;
         nh = -1;
@@ -354,7 +357,8 @@ struct FlowData {
 
     bool disable_validation; // ignore RPF on specific flows (like BFD health check)
 
-    std::string vm_cfg_name;
+    // Interned name of the VM, copied from the VmEntry
+    InternedString vm_cfg_name;
     uint32_t acl_assigned_vrf_index_;
     uint32_t qos_config_idx;
     uint16_t allocated_port_;
@@ -521,6 +525,8 @@ class FlowEntry {
     static const uint32_t kInvalidFlowHandle=0xFFFFFFFF;
     static const uint8_t kMaxMirrorsPerFlow=0x2;
     static const std::map<FlowPolicyState, const char*> FlowPolicyStateStr;
+    // Interned FlowPolicyStateStr value of the state
+    static const InternedString &FlowPolicyStateUuid(FlowPolicyState state);
     static const std::map<uint16_t, const char*> FlowDropReasonStr;
     static const uint32_t kFlowRetryAttempts = 5;
     // Don't go beyond PCAP_END, pcap type is one byte
@@ -633,13 +639,13 @@ class FlowEntry {
     const std::string &sg_rule_uuid() const {
         return data_.match_p.sg_policy.rule_uuid_;
     }
-    const std::string &nw_ace_uuid() const { return nw_ace_uuid_; }
+    const std::string &nw_ace_uuid() const { return nw_ace_uuid_.get(); }
     const std::string fw_policy_name_uuid() const;
     const std::string fw_policy_uuid() const;
     const std::string RemotePrefix() const;
     const TagList &remote_tagset() const;
     const TagList &local_tagset() const;
-    const std::string &peer_vrouter() const { return peer_vrouter_; }
+    const std::string peer_vrouter() const;
     TunnelType tunnel_type() const { return tunnel_type_; }
 
     uint16_t short_flow_reason() const { return short_flow_reason_; }
@@ -795,7 +801,7 @@ private:
     VmInterfaceKey InterfaceIdToKey(Agent *agent, uint32_t id);
     void GetSourceRouteInfo(const AgentRoute *rt);
     void GetDestRouteInfo(const AgentRoute *rt);
-    const std::string InterfaceIdToVmCfgName(Agent *agent, uint32_t id);
+    const InternedString &InterfaceIdToVmCfgName(Agent *agent, uint32_t id);
     const VrfEntry *GetDestinationVrf() const;
     bool SetQosConfigIndex();
     void SetAclInfo(SessionPolicy *sp, SessionPolicy *rsp,
@@ -823,11 +829,11 @@ private:
     uint16_t short_flow_reason_;
     boost::uuids::uuid uuid_;
     boost::uuids::uuid egress_uuid_;
-    std::string sg_rule_uuid_;
-    std::string nw_ace_uuid_;
+    // Interned uuid of the network policy ACE, copied from the AclEntry
+    InternedString nw_ace_uuid_;
     //IP address of the src vrouter for egress flows and dst vrouter for
     //ingress flows. Used only during flow-export
-    std::string peer_vrouter_;
+    Ip4Address peer_vrouter_;
     //Underlay IP protocol type. Used only during flow-export
     TunnelType tunnel_type_;
     // Is flow-entry on the tree
@@ -859,7 +865,6 @@ private:
     // Field used by flow-mgmt module. Its stored here to optimize flow-mgmt
     // and avoid lookups
     FlowMgmtEntryInfoPtr flow_mgmt_info_;
-    const std::string fw_policy_;
     // Transaction id is used to detect old/stale vrouter add-ack response for
     // reverse flow handle allocation requests. It can happen if flow are
     // evicted from vrouter just after add-ack response sent to agent
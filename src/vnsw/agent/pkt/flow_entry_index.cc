@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <pkt/flow_entry_index.h>
+
+/////////////////////////////////////////////////////////////////////////////
+// FlowEntryIndex iterator
+/////////////////////////////////////////////////////////////////////////////
+FlowEntry *FlowEntryIndex::iterator::operator*() const {
+    if (index_->type_ == TREE)
+        return tree_it_->second;
+    return index_->slots_[slot_].flow;
+}
+
+FlowEntryIndex::iterator &FlowEntryIndex::iterator::operator++() {
+    if (index_->type_ == TREE) {
+        ++tree_it_;
+    } else {
+        slot_ = index_->NextUsedSlot(slot_ + 1);
+    }
+    return *this;
+}
+
+bool FlowEntryIndex::iterator::operator==(const iterator &rhs) const {
+    if (index_->type_ == TREE)
+        return tree_it_ == rhs.tree_it_;
+    return slot_ == rhs.slot_;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// FlowEntryIndex routines
+/////////////////////////////////////////////////////////////////////////////
+FlowEntryIndex::FlowEntryIndex(Type type) :
+    type_(type), size_(0), deleted_(0) {
+}
+
+FlowEntryIndex::~FlowEntryIndex() {
+    assert(size_ == 0);
+}
+
+void FlowEntryIndex::set_type(Type type) {
+    assert(size_ == 0);
+    type_ = type;
+    slots_.clear();
+    deleted_ = 0;
+}
+
+// Fold the FlowKey hash to 32 bits, which is stored in the slot
+uint32_t FlowEntryIndex::Hash(const FlowKey &key) {
+    uint64_t hash = key.Hash();
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+// Returns index of the slot with the key or slot_count() if key is not found
+size_t FlowEntryIndex::FindSlot(const FlowKey &key, uint32_t hash) const {
+    if (slots_.empty())
+        return slots_.size();
+
+    size_t mask = slots_.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const Slot &entry = slots_[slot];
+        if (entry.state == SLOT_EMPTY)
+            return slots_.size();
+        if (entry.state == SLOT_USED && entry.hash == hash &&
+            entry.flow->key().IsEqual(key)) {
+            return slot;
+        }
+    }
+}
+
+size_t FlowEntryIndex::NextUsedSlot(size_t slot) const {
+    while (slot < slots_.size() && slots_[slot].state != SLOT_USED) {
+        slot++;
+    }
+    return slot;
+}
+
+// Move used slots to a new table of slot_count slots, dropping deleted slots
+void FlowEntryIndex::Rebuild(size_t slot_count) {
+    SlotList slots(slot_count);
+    size_t mask = slot_count - 1;
+    for (SlotList::const_iterator it = slots_.begin(); it != slots_.end();
+         ++it) {
+        if (it->state != SLOT_USED)
+            continue;
+        size_t slot = it->hash & mask;
+        while (slots[slot].state != SLOT_EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = *it;
+    }
+    slots_.swap(slots);
+    deleted_ = 0;
+}
+
+FlowEntry *FlowEntryIndex::Find(const FlowKey &key) const {
+    if (type_ == TREE) {
+        Tree::const_iterator it = tree_.find(key);
+        return (it != tree_.end()) ? it->second : NULL;
+    }
+
+    size_t slot = FindSlot(key, Hash(key));
+    return (slot != slots_.size()) ? slots_[slot].flow : NULL;
+}
+
+FlowEntry *FlowEntryIndex::Insert(FlowEntry *flow) {
+    if (type_ == TREE) {
+        std::pair<Tree::iterator, bool> ret =
+            tree_.insert(std::make_pair(flow->key(), flow));
+        if (ret.second)
+            size_++;
+        return ret.first->second;
+    }
+
+    // Keep the load, including deleted slots, under 75%. Table is rebuilt
+    // for at least twice the number of flows, so it also shrinks after most
+    // of the flows are deleted
+    if ((size_ + deleted_ + 1) * 4 > slots_.size() * 3) {
+        size_t slot_count = kMinSlotCount;
+        while (slot_count < (size_ + 1) * 2) {
+            slot_count *= 2;
+        }
+        Rebuild(slot_count);
+    }
+
+    uint32_t hash = Hash(flow->key());
+    size_t mask = slots_.size() - 1;
+    size_t free_slot = slots_.size();
+    size_t slot = hash & mask;
+    for (; ; slot = (slot + 1) & mask) {
+        Slot &entry = slots_[slot];
+        if (entry.state == SLOT_EMPTY)
+            break;
+        if (entry.state == SLOT_DELETED) {
+            if (free_slot == slots_.size())
+                free_slot = slot;
+            continue;
+        }
+        if (entry.hash == hash && entry.flow->key().IsEqual(flow->key()))
+            return entry.flow;
+    }
+
+    // Reuse the first deleted slot in the probe sequence if any
+    if (free_slot != slots_.size()) {
+        slot = free_slot;
+        deleted_--;
+    }
+    Slot &entry = slots_[slot];
+    entry.flow = flow;
+    entry.hash = hash;
+    entry.state = SLOT_USED;
+    size_++;
+    return flow;
+}
+
+bool FlowEntryIndex::Erase(const FlowKey &key) {
+    if (type_ == TREE) {
+        if (tree_.erase(key) == 0)
+            return false;
+        size_--;
+        return true;
+    }
+
+    size_t slot = FindSlot(key, Hash(key));
+    if (slot == slots_.size())
+        return false;
+    Slot &entry = slots_[slot];
+    entry.flow = NULL;
+    entry.state = SLOT_DELETED;
+    size_--;
+    deleted_++;
+    return true;
+}
+
+FlowEntryIndex::iterator FlowEntryIndex::begin() const {
+    if (type_ == TREE)
+        return iterator(this, tree_.begin());
+    return iterator(this, NextUsedSlot(0));
+}
+
+FlowEntryIndex::iterator FlowEntryIndex::end() const {
+    if (type_ == TREE)
+        return iterator(this, tree_.end());
+    return iterator(this, slots_.size());
+}
+
+FlowEntryIndex::iterator FlowEntryIndex::upper_bound(const FlowKey &key) const {
+    if (type_ == TREE)
+        return iterator(this, tree_.upper_bound(key));
+
+    if (slots_.empty())
+        return end();
+    uint32_t hash = Hash(key);
+    size_t slot = FindSlot(key, hash);
+    if (slot == slots_.size())
+        return iterator(this, NextUsedSlot(hash & (slots_.size() - 1)));
+    return iterator(this, NextUsedSlot(slot + 1));
+}
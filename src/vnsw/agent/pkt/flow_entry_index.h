@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef __AGENT_FLOW_ENTRY_INDEX_H__
+#define __AGENT_FLOW_ENTRY_INDEX_H__
+
+#include <map>
+#include <vector>
+#include <pkt/flow_entry.h>
+
+struct Inet4FlowKeyCmp {
+    bool operator()(const FlowKey &lhs, const FlowKey &rhs) const {
+        const FlowKey &lhs_base = static_cast<const FlowKey &>(lhs);
+        return lhs_base.IsLess(rhs);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Index of flows in a FlowTable keyed by FlowKey.
+//
+// Flows are kept either in a std::map (TREE) or in an open addressing hash
+// table with linear probing (HASH). Each slot of the hash table keeps the
+// hash of the FlowKey along with the flow, so a probe compares the FlowKey
+// only when the hash matches and the table is grown without hashing the keys
+// again.
+//
+// An erased slot is marked deleted instead of moving other entries back, so
+// iterators stay valid across an erase. Deleted slots are reclaimed when the
+// table is rebuilt on an insert, which invalidates iterators.
+//
+// The hash table is iterated in slot order. upper_bound() continues after the
+// slot of the key or, if the key is not present, from the slot the key hashes
+// to. Paged iteration (e.g. flow introspect) may hence repeat or miss flows
+// when the table changes between pages.
+/////////////////////////////////////////////////////////////////////////////
+class FlowEntryIndex {
+public:
+    enum Type {
+        TREE,
+        HASH
+    };
+
+    static const size_t kMinSlotCount = 1024;
+
+    typedef std::map<FlowKey, FlowEntry *, Inet4FlowKeyCmp> Tree;
+
+    class iterator {
+    public:
+        iterator() : index_(NULL), slot_(0) { }
+
+        FlowEntry *operator*() const;
+        iterator &operator++();
+        bool operator==(const iterator &rhs) const;
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+    private:
+        friend class FlowEntryIndex;
+
+        iterator(const FlowEntryIndex *index, Tree::const_iterator tree_it)
+            : index_(index), tree_it_(tree_it), slot_(0) {
+        }
+        iterator(const FlowEntryIndex *index, size_t slot)
+            : index_(index), slot_(slot) {
+        }
+
+        const FlowEntryIndex *index_;
+        Tree::const_iterator tree_it_;
+        size_t slot_;
+    };
+
+    explicit FlowEntryIndex(Type type = TREE);
+    ~FlowEntryIndex();
+
+    Type type() const { return type_; }
+    // Type can only be changed when the index is empty
+    void set_type(Type type);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t slot_count() const { return slots_.size(); }
+
+    FlowEntry *Find(const FlowKey &key) const;
+    // Add flow to the index unless there is a flow with the same key.
+    // Returns the flow in the index.
+    FlowEntry *Insert(FlowEntry *flow);
+    bool Erase(const FlowKey &key);
+
+    iterator begin() const;
+    iterator end() const;
+    iterator upper_bound(const FlowKey &key) const;
+
+private:
+    enum SlotState {
+        SLOT_EMPTY,
+        SLOT_DELETED,
+        SLOT_USED
+    };
+
+    struct Slot {
+        Slot() : flow(NULL), hash(0), state(SLOT_EMPTY) { }
+        FlowEntry *flow;
+        uint32_t hash;
+        uint32_t state;
+    };
+    typedef std::vector<Slot> SlotList;
+
+    static uint32_t Hash(const FlowKey &key);
+    size_t FindSlot(const FlowKey &key, uint32_t hash) const;
+    size_t NextUsedSlot(size_t slot) const;
+    void Rebuild(size_t slot_count);
+
+    Type type_;
+    Tree tree_;
+    SlotList slots_;
+    size_t size_;
+    size_t deleted_;
+    DISALLOW_COPY_AND_ASSIGN(FlowEntryIndex);
+};
+
+#endif  // __AGENT_FLOW_ENTRY_INDEX_H__
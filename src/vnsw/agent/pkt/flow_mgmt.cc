@@ -40,6 +40,7 @@ FlowMgmtManager::FlowMgmtManager(Agent *agent, uint16_t table_index) :
     request_queue_.set_name("Flow management");
     request_queue_.set_measure_busy_time(agent->MeasureQueueDelay());
     db_event_queue_.set_name("Flow DB Event Queue");
+    db_event_queue_.set_measure_busy_time(agent->MeasureQueueDelay());
     for (uint8_t count = 0; count < MAX_XMPP_SERVERS; count++) {
         bgp_as_a_service_flow_mgmt_tree_[count].reset(
             new BgpAsAServiceFlowMgmtTree(this, count));
@@ -190,6 +190,21 @@
 //
 // When Flow Management Dbclient module receives FREE_DBENTRY event, it will
 // ignore the message if gen-id does not match with latest value.
+//
+// Partitioning:
+// -------------
+// Flow Management module is partitioned by FlowTable. PktModule creates one
+// FlowMgmtManager per FlowTable and flows of a FlowTable are managed only by
+// the FlowMgmtManager with same table_index. Each FlowMgmtManager has,
+// - Its own FlowMgmtDbClient. DB notifications are hence fanned out to all
+//   partitions, each partition keeping its own DBState and gen-id
+// - Its own FlowMgmtTree instances, tracking only flows of its FlowTable
+// - Its own request and DB event work-queues running in instance
+//   table_index of kTaskFlowMgmt task
+//
+// So, revaluation of flows on a change to a DBEntry runs in parallel across
+// partitions. Queue statistics for each partition are available in the
+// flow queue summary of agent profile.
 ////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////
@@ -308,6 +323,7 @@ public:
     }
 
     const FlowMgmtQueue *request_queue() const { return &request_queue_; }
+    const FlowMgmtQueue *db_event_queue() const { return &db_event_queue_; }
     const FlowMgmtQueue *log_queue() const { return log_queue_; }
     void DisableWorkQueue(bool disable) { request_queue_.set_disable(disable); }
     void BgpAsAServiceNotify(const boost::uuids::uuid &vm_uuid,
@@ -881,9 +881,15 @@ void FlowProto::SetProfileData(ProfileData *data) {
     data->flow_.flow_delete_queue_.resize(flow_table_list_.size());
     data->flow_.flow_tokenless_queue_.resize(flow_table_list_.size());
     data->flow_.flow_ksync_queue_.resize(flow_table_list_.size());
-    for (uint16_t i = 0; i < flow_table_list_.size(); i++) {
+    data->flow_.flow_mgmt_queue_.resize(mgr_list.size());
+    data->flow_.flow_mgmt_db_queue_.resize(mgr_list.size());
+    for (uint16_t i = 0; i < mgr_list.size(); i++) {
         SetFlowMgmtQueueStats(agent(), mgr_list[i]->request_queue(),
-                              &data->flow_.flow_mgmt_queue_);
+                              &data->flow_.flow_mgmt_queue_[i]);
+        SetFlowMgmtQueueStats(agent(), mgr_list[i]->db_event_queue(),
+                              &data->flow_.flow_mgmt_db_queue_[i]);
+    }
+    for (uint16_t i = 0; i < flow_table_list_.size(); i++) {
         SetFlowEventQueueStats(agent(), flow_event_queue_[i]->queue(),
                                &data->flow_.flow_event_queue_[i]);
         SetFlowEventQueueStats(agent(), flow_delete_queue_[i]->queue(),
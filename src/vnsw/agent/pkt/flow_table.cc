@@ -80,6 +80,9 @@ void FlowTable::Init() {
     flow_delete_task_id_ = agent_->task_scheduler()->GetTaskId(kTaskFlowDelete);
     flow_ksync_task_id_ = agent_->task_scheduler()->GetTaskId(kTaskFlowKSync);
     flow_logging_task_id_ = agent_->task_scheduler()->GetTaskId(kTaskFlowLogging);
+    if (agent_->params()->flow_hash_index()) {
+        flow_entry_map_.set_type(FlowEntryMap::HASH);
+    }
     FlowEntry::Init();
     return;
 }
@@ -120,14 +123,7 @@ bool FlowTable::ConcurrencyCheck(int task_id) {
 
 FlowEntry *FlowTable::Find(const FlowKey &key) {
     assert(ConcurrencyCheck(flow_task_id_) == true);
-    FlowEntryMap::iterator it;
-
-    it = flow_entry_map_.find(key);
-    if (it != flow_entry_map_.end()) {
-        return it->second;
-    } else {
-        return NULL;
-    }
+    return flow_entry_map_.Find(key);
 }
 
 void FlowTable::Copy(FlowEntry *lhs, FlowEntry *rhs, bool update) {
@@ -146,15 +142,13 @@ void FlowTable::Copy(FlowEntry *lhs, FlowEntry *rhs, bool update) {
 
 FlowEntry *FlowTable::Locate(FlowEntry *flow, uint64_t time) {
     assert(ConcurrencyCheck(flow_task_id_) == true);
-    std::pair<FlowEntryMap::iterator, bool> ret;
-    ret = flow_entry_map_.insert(FlowEntryMapPair(flow->key(), flow));
-    if (ret.second == true) {
+    FlowEntry *ret = flow_entry_map_.Insert(flow);
+    if (ret == flow) {
         agent_->stats()->incr_flow_created();
-        ret.first->second->set_on_tree();
-        return flow;
+        flow->set_on_tree();
     }
 
-    return ret.first->second;
+    return ret;
 }
 
 void FlowTable::Add(FlowEntry *flow, FlowEntry *rflow) {
@@ -416,12 +410,12 @@ void FlowTable::DeleteAll() {
 
     it = flow_entry_map_.begin();
     while (it != flow_entry_map_.end()) {
-        FlowEntry *entry = it->second;
+        FlowEntry *entry = *it;
         FlowEntry *reverse_entry = NULL;
         ++it;
         if (it != flow_entry_map_.end() &&
-            it->second == entry->reverse_flow_entry()) {
-            reverse_entry = it->second;
+            *it == entry->reverse_flow_entry()) {
+            reverse_entry = *it;
             ++it;
         }
         FLOW_LOCK(entry, reverse_entry, FlowEvent::DELETE_FLOW);
@@ -37,6 +37,7 @@
 #include <pkt/pkt_init.h>
 #include <pkt/pkt_flow_info.h>
 #include <pkt/flow_entry.h>
+#include <pkt/flow_entry_index.h>
 #include <sandesh/sandesh_trace.h>
 #include <oper/vn.h>
 #include <oper/vm.h>
@@ -141,7 +142,8 @@ private:
 //   responsible to generate KSync events. It is run in a single task context
 //
 //   Functionality of FlowTable:
-//   1. Manage flow_entry_map_ which contains all flows
+//   1. Manage flow_entry_map_ which contains all flows. It is a tree or a
+//      hash table based on the FLOWS.hash_index agent parameter
 //   2. Enforce the per-VM flow limits
 //   3. Generate events to KSync and FlowMgmt modueles
 /////////////////////////////////////////////////////////////////////////////
@@ -152,20 +154,12 @@ struct FlowTaskMsg : public InterTaskMsg {
     FlowEntryPtr fe_ptr;
 };
 
-struct Inet4FlowKeyCmp {
-    bool operator()(const FlowKey &lhs, const FlowKey &rhs) const {
-        const FlowKey &lhs_base = static_cast<const FlowKey &>(lhs);
-        return lhs_base.IsLess(rhs);
-    }
-};
-
 class FlowTable {
 public:
     static const uint32_t kPortNatFlowTableInstance = 0;
     static const uint32_t kInvalidFlowTableInstance = 0xFF;
 
-    typedef std::map<FlowKey, FlowEntry *, Inet4FlowKeyCmp> FlowEntryMap;
-    typedef std::pair<FlowKey, FlowEntry *> FlowEntryMapPair;
+    typedef FlowEntryIndex FlowEntryMap;
     typedef boost::function<bool(FlowEntry *flow)> FlowEntryCb;
     typedef std::vector<FlowEntryPtr> FlowIndexTree;
 
@@ -7,10 +7,16 @@
 #include <pkt/control_interface.h>
 
 PacketBufferManager::PacketBufferManager(PktModule *pkt_module) :
-    alloc_(0), free_(0), pkt_module_(pkt_module) {
+    alloc_(0), free_(0), pkt_module_(pkt_module), rx_buffer_alloc_(0),
+    rx_buffer_reuse_(0) {
 }
 
 PacketBufferManager::~PacketBufferManager() {
+    for (std::vector<uint8_t *>::iterator it = rx_buffer_pool_.begin();
+         it != rx_buffer_pool_.end(); ++it) {
+        delete [] *it;
+    }
+    rx_buffer_pool_.clear();
 }
 
 PacketBufferPtr PacketBufferManager::Allocate(uint32_t module, uint16_t len,
@@ -31,6 +37,53 @@ PacketBufferPtr PacketBufferManager::Allocate(uint32_t module, uint8_t *buff,
     return ptr;
 }
 
+uint16_t PacketBufferManager::rx_buffer_len() const {
+    return ControlInterface::kMaxPacketSize;
+}
+
+std::size_t PacketBufferManager::rx_buffer_pool_size() {
+    std::scoped_lock lock(rx_buffer_mutex_);
+    return rx_buffer_pool_.size();
+}
+
+uint8_t *PacketBufferManager::AllocateRxBuffer() {
+    {
+        std::scoped_lock lock(rx_buffer_mutex_);
+        if (rx_buffer_pool_.empty() == false) {
+            uint8_t *buff = rx_buffer_pool_.back();
+            rx_buffer_pool_.pop_back();
+            rx_buffer_reuse_++;
+            return buff;
+        }
+        rx_buffer_alloc_++;
+    }
+    return new uint8_t[rx_buffer_len()];
+}
+
+void PacketBufferManager::FreeRxBuffer(uint8_t *buff) {
+    {
+        std::scoped_lock lock(rx_buffer_mutex_);
+        if (rx_buffer_pool_.size() < kMaxRxBufferPoolSize) {
+            rx_buffer_pool_.push_back(buff);
+            return;
+        }
+    }
+    delete [] buff;
+}
+
+PacketBufferPtr PacketBufferManager::AllocateRx(uint32_t module,
+                                                uint8_t *buff,
+                                                uint16_t data_len,
+                                                uint32_t mdata) {
+    boost::shared_array<uint8_t> rx_buff
+        (buff, boost::bind(&PacketBufferManager::FreeRxBuffer, this, _1));
+    PacketBufferPtr ptr(new PacketBuffer(this, module, rx_buff,
+                                         rx_buffer_len(), 0, data_len,
+                                         mdata));
+    alloc_++;
+    return ptr;
+}
+
 void PacketBufferManager::FreeIndication(PacketBuffer *pkt) {
     free_++;
 }
@@ -48,6 +101,14 @@ PacketBuffer::PacketBuffer(PacketBufferManager *mgr, uint32_t module,
     data_len_(data_len), module_(module), mdata_(mdata), mgr_(mgr) {
 }
 
+PacketBuffer::PacketBuffer(PacketBufferManager *mgr, uint32_t module,
+                           const boost::shared_array<uint8_t> &buff,
+                           uint16_t len, uint16_t data_offset,
+                           uint16_t data_len, uint32_t mdata) :
+    buffer_(buff), buffer_len_(len), data_(buffer_.get() + data_offset),
+    data_len_(data_len), module_(module), mdata_(mdata), mgr_(mgr) {
+}
+
 PacketBuffer::~PacketBuffer() {
     mgr_->FreeIndication(this);
     data_ = NULL;
@@ -6,6 +6,8 @@
 #define vnsw_agent_pkt_packet_buffer_hpp
 
 #include <string>
+#include <vector>
+#include <mutex>
 #include <stdint.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/shared_array.hpp>
@@ -44,6 +46,11 @@ private:
                  uint16_t len, uint16_t data_offset, uint16_t data_len,
                  uint32_t mdata);
 
+    // Create PacketBuffer from memory shared with the owner of buff
+    PacketBuffer(PacketBufferManager *mgr, uint32_t module,
+                 const boost::shared_array<uint8_t> &buff, uint16_t len,
+                 uint16_t data_offset, uint16_t data_len, uint32_t mdata);
+
     boost::shared_array<uint8_t> buffer_;
     uint16_t buffer_len_;
 
@@ -56,8 +63,16 @@ private:
     DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
 
+// Packets read from the control interface are received in buffers of
+// ControlInterface::kMaxPacketSize bytes. Such receive buffers are recycled
+// through a pool instead of being freed when the PacketBuffer is released,
+// so that a burst of trapped packets does not allocate a large buffer per
+// packet. The pool is bounded by kMaxRxBufferPoolSize and is protected by a
+// mutex since PacketBuffers are released from different tasks.
 class PacketBufferManager {
 public:
+    static const uint32_t kMaxRxBufferPoolSize = 256;
+
     PacketBufferManager(PktModule *pkt_module);
     virtual ~PacketBufferManager();
 
@@ -66,6 +81,20 @@ public:
     PacketBufferPtr Allocate(uint32_t module, uint8_t *buff, uint16_t len,
                              uint16_t data_offset, uint16_t data_len,
                              uint32_t mdata);
+
+    // Get a receive buffer of rx_buffer_len() bytes from the pool
+    uint8_t *AllocateRxBuffer();
+    // Return a receive buffer, which was not used for a packet, to the pool
+    void FreeRxBuffer(uint8_t *buff);
+    // Create PacketBuffer for a packet of data_len bytes read into a buffer
+    // from AllocateRxBuffer. The buffer goes back to the pool on release
+    PacketBufferPtr AllocateRx(uint32_t module, uint8_t *buff,
+                               uint16_t data_len, uint32_t mdata);
+    uint16_t rx_buffer_len() const;
+    uint64_t rx_buffer_alloc() const { return rx_buffer_alloc_; }
+    uint64_t rx_buffer_reuse() const { return rx_buffer_reuse_; }
+    std::size_t rx_buffer_pool_size();
+
 private:
     friend class PacketBuffer;
     void FreeIndication(PacketBuffer *);
@@ -74,6 +103,11 @@ private:
     uint64_t free_;
     PktModule *pkt_module_;
 
+    std::mutex rx_buffer_mutex_;
+    std::vector<uint8_t *> rx_buffer_pool_;
+    uint64_t rx_buffer_alloc_;
+    uint64_t rx_buffer_reuse_;
+
     DISALLOW_COPY_AND_ASSIGN(PacketBufferManager);
 };
 
@@ -1536,11 +1536,11 @@ void PktFlowInfo::IngressProcess(const PktInfo *pkt, PktControlInfo *in,
             const TunnelNH* tunnel_nh = static_cast<const TunnelNH *>(nh);
             const Ip4Address *ip = tunnel_nh->GetDip();
             if (ip) {
-                peer_vrouter = ip->to_string();
+                peer_vrouter = *ip;
                 tunnel_type = tunnel_nh->GetTunnelType();
             }
         } else {
-            peer_vrouter = agent->router_id().to_string();
+            peer_vrouter = agent->router_id();
         }
     }
 
@@ -1613,7 +1613,7 @@ const NextHop *PktFlowInfo::TunnelToNexthop(const PktInfo *pkt) {
 
 void PktFlowInfo::EgressProcess(const PktInfo *pkt, PktControlInfo *in,
                                 PktControlInfo *out) {
-    peer_vrouter = Ip4Address(pkt->tunnel.ip_saddr).to_string();
+    peer_vrouter = Ip4Address(pkt->tunnel.ip_saddr);
 
     const NextHop *nh = TunnelToNexthop(pkt);
     if (nh == NULL) {
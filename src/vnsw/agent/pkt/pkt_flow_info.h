@@ -195,7 +195,7 @@ public:
     bool                fip_dnat;
     IpAddress           snat_fip;
     uint16_t            short_flow_reason;
-    std::string         peer_vrouter;
+    Ip4Address          peer_vrouter;
     TunnelType          tunnel_type;
 
     // flow entry obtained from flow IPC, which requires recomputation.
@@ -16,6 +16,7 @@
 #include <vrouter/flow_stats/flow_stats_collector.h>
 #include <vrouter/ksync/ksync_init.h>
 #include <vrouter/ksync/ksync_flow_index_manager.h>
+#include <vrouter/ksync/flowtable_ksync.h>
 
 static string InetRouteFlowMgmtKeyToString(uint16_t id,
                                            InetRouteFlowMgmtKey *key) {
@@ -404,7 +405,7 @@ bool PktSandeshFlow::Run() {
     }
 
     while (it != flow_obj->flow_entry_map_.end()) {
-        FlowEntry *fe = it->second;
+        FlowEntry *fe = *it;
         FlowStatsCollector *fec = fe->fsc();
         const FlowExportInfo *info = NULL;
         if (fec) {
@@ -496,18 +497,17 @@ void FetchFlowRecord::HandleRequest() const {
     key.dst_port = (unsigned)get_dst_port();
     key.protocol = get_protocol();
 
-    FlowTable::FlowEntryMap::iterator it;
+    FlowEntry *fe = NULL;
     for (int i = 0; i < agent->flow_thread_count(); i++) {
         flow_obj = agent->pkt()->flow_table(i);
-        it = flow_obj->flow_entry_map_.find(key);
-        if (it != flow_obj->flow_entry_map_.end())
+        fe = flow_obj->flow_entry_map_.Find(key);
+        if (fe != NULL)
             break;
     }
 
     SandeshResponse *resp;
-    if (flow_obj && it != flow_obj->flow_entry_map_.end()) {
+    if (fe != NULL) {
        FlowRecordResp *flow_resp = new FlowRecordResp();
-       FlowEntry *fe = it->second;
        FlowStatsCollector *fec = fe->fsc();
        const FlowExportInfo *info = NULL;
        if (fec) {
@@ -618,7 +618,7 @@ bool PktSandeshFlowStats::Run() {
     }
 
     while (it != flow_obj->flow_entry_map_.end()) {
-        FlowEntry *fe = it->second;
+        FlowEntry *fe = *it;
         const FlowExportInfo *info = NULL;
         if (fe->fsc()) {
             info = fe->fsc()->FindFlowExportInfo(fe);
@@ -728,6 +728,10 @@ void SandeshFlowTableInfoRequest::HandleRequest() const {
     resp->set_total_added(agent->stats()->flow_created());
     resp->set_max_flows(agent->stats()->max_flow_count());
     resp->set_total_deleted(agent->stats()->flow_aged());
+    resp->set_flow_entry_size(sizeof(FlowEntry));
+    resp->set_flow_ksync_entry_size(sizeof(FlowTableKSyncEntry));
+    resp->set_flow_object_size(sizeof(FlowEntry) +
+                               sizeof(FlowTableKSyncEntry));
     std::vector<SandeshFlowTableInfo> info_list;
     for (uint16_t i = 0; i < proto->flow_table_count(); i++) {
         FlowTable *table = proto->GetTable(i);
@@ -737,6 +741,8 @@ void SandeshFlowTableInfoRequest::HandleRequest() const {
         info.set_total_add(table->free_list()->total_alloc());
         info.set_total_del(table->free_list()->total_free());
         info.set_freelist_count(table->free_list()->free_count());
+        info.set_flow_entry_bytes(sizeof(FlowEntry) *
+            (table->Size() + table->free_list()->free_count()));
         info_list.push_back(info);
     }
     resp->set_table_list(info_list);
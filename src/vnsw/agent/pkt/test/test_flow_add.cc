@@ -10,8 +10,28 @@
 #include "ksync/ksync_sock_user.h"
 #include "oper/tunnel_nh.h"
 #include "pkt/flow_table.h"
+#include "vrouter/ksync/flowtable_ksync.h"
 
 #include "test_flow_base.cc"
+
+static void CheckFlowTableInfo(Sandesh *sandesh, uint32_t *count) {
+    SandeshFlowTableInfoResp *resp =
+        dynamic_cast<SandeshFlowTableInfoResp *>(sandesh);
+    if (resp == NULL)
+        return;
+
+    EXPECT_EQ(sizeof(FlowEntry), resp->get_flow_entry_size());
+    EXPECT_EQ(sizeof(FlowTableKSyncEntry), resp->get_flow_ksync_entry_size());
+    EXPECT_EQ(sizeof(FlowEntry) + sizeof(FlowTableKSyncEntry),
+              resp->get_flow_object_size());
+    const std::vector<SandeshFlowTableInfo> &list = resp->get_table_list();
+    for (size_t i = 0; i < list.size(); i++) {
+        EXPECT_EQ(sizeof(FlowEntry) *
+                  (list[i].get_count() + list[i].get_freelist_count()),
+                  list[i].get_flow_entry_bytes());
+    }
+    (*count)++;
+}
 //Ingress flow test (VMport to VMport - Same VN)
 //Flow creation using IP and TCP packets
 TEST_F(FlowTest, FlowAdd_1) {
@@ -85,6 +105,68 @@ TEST_F(FlowTest, FlowAdd_1) {
    EXPECT_TRUE(fe->data().underlay_gw_index_ == 255);
 }
 
+//Flows of a VM share the interned VM name and ACE uuid
+TEST_F(FlowTest, FlowAdd_InternedStrings) {
+    TestFlow flow[] = {
+        {  TestFlowPkt(Address::INET, vm1_ip, vm2_ip, IPPROTO_TCP, 1000, 200,
+                       "vrf5", flow0->id()),
+        {
+            new VerifyVn("vn5", "vn5"),
+            new VerifyVrf("vrf5", "vrf5")
+        }
+        },
+        {  TestFlowPkt(Address::INET, vm1_ip, vm2_ip, IPPROTO_TCP, 1001, 200,
+                       "vrf5", flow0->id()),
+        {
+            new VerifyVn("vn5", "vn5"),
+            new VerifyVrf("vrf5", "vrf5")
+        }
+        }
+    };
+
+    CreateFlow(flow, 2);
+    EXPECT_EQ(4U, get_flow_proto()->FlowCount());
+
+    const FlowEntry *fe1 = flow[0].pkt_.FlowFetch();
+    const FlowEntry *fe2 = flow[1].pkt_.FlowFetch();
+    ASSERT_TRUE(fe1 != NULL);
+    ASSERT_TRUE(fe2 != NULL);
+    const VmEntry *vm = flow0->vm();
+    ASSERT_TRUE(vm != NULL);
+
+    // Flows refer to the name kept in the VmEntry
+    EXPECT_EQ(vm->GetCfgName(), fe1->data().vm_cfg_name.get());
+    EXPECT_EQ(&vm->GetCfgName(), &fe1->data().vm_cfg_name.get());
+    EXPECT_EQ(&vm->GetCfgName(), &fe2->data().vm_cfg_name.get());
+    EXPECT_FALSE(fe1->nw_ace_uuid().empty());
+    EXPECT_EQ(&fe1->nw_ace_uuid(), &fe2->nw_ace_uuid());
+    EXPECT_EQ(agent()->router_id().to_string(), fe1->peer_vrouter());
+}
+
+//Flow table info reports the size of the flow objects
+TEST_F(FlowTest, FlowTableInfo) {
+    TestFlow flow[] = {
+        {  TestFlowPkt(Address::INET, vm1_ip, vm2_ip, IPPROTO_TCP, 1000, 200,
+                       "vrf5", flow0->id()),
+        {
+            new VerifyVn("vn5", "vn5")
+        }
+        }
+    };
+
+    CreateFlow(flow, 1);
+    EXPECT_EQ(2U, get_flow_proto()->FlowCount());
+
+    uint32_t count = 0;
+    SandeshFlowTableInfoRequest *req = new SandeshFlowTableInfoRequest();
+    Sandesh::set_response_callback(boost::bind(CheckFlowTableInfo, _1,
+                                               &count));
+    req->HandleRequest();
+    client->WaitForIdle();
+    req->Release();
+    EXPECT_EQ(1U, count);
+}
+
 //Egress flow test (IP fabric to VMPort - Same VN)
 //Flow creation using GRE packets
 TEST_F(FlowTest, FlowAdd_2) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <algorithm>
+#include <set>
+#include "base/os.h"
+#include "test/test_cmn_util.h"
+#include "test_pkt_util.h"
+#include "pkt/flow_proto.h"
+#include "pkt/flow_entry_index.h"
+
+class FlowIndexTest : public ::testing::Test {
+public:
+    virtual void SetUp() {
+        agent_ = Agent::GetInstance();
+        flow_proto_ = agent_->pkt()->get_flow_proto();
+        flow_table_ = flow_proto_->GetTable(0);
+        free_list_ = flow_table_->free_list();
+    }
+
+    virtual void TearDown() {
+        while (flow_list_.size()) {
+            free_list_->Free(flow_list_.back());
+            flow_list_.pop_back();
+        }
+        client->WaitForIdle();
+    }
+
+    // Forward and reverse keys of a TCP session from 10.x.x.x to 11.x.x.x
+    static FlowKey BuildKey(uint32_t idx, bool reverse) {
+        Ip4Address sip(0x0a000000 + idx);
+        Ip4Address dip(0x0b000000 + idx / 256);
+        uint16_t sport = 1024 + idx % 256;
+        if (reverse)
+            return FlowKey(10, dip, sip, IPPROTO_TCP, 80, sport);
+        return FlowKey(10, sip, dip, IPPROTO_TCP, sport, 80);
+    }
+
+    void AllocateFlows(uint32_t count) {
+        for (uint32_t idx = flow_list_.size(); idx < count; idx++) {
+            flow_list_.push_back(free_list_->Allocate(BuildKey(idx, false)));
+        }
+    }
+
+    Agent *agent_;
+    FlowProto *flow_proto_;
+    FlowTable *flow_table_;
+    FlowEntryFreeList *free_list_;
+    std::vector<FlowEntry *> flow_list_;
+};
+
+// Verify the hash index against the tree with random adds and deletes
+TEST_F(FlowIndexTest, Verify) {
+    const uint32_t kCount = 8 * FlowEntryIndex::kMinSlotCount;
+    AllocateFlows(kCount);
+    std::vector<uint32_t> order;
+    for (uint32_t idx = 0; idx < kCount; idx++) {
+        order.push_back(idx);
+    }
+    std::random_shuffle(order.begin(), order.end());
+
+    FlowEntryIndex tree(FlowEntryIndex::TREE);
+    FlowEntryIndex hash(FlowEntryIndex::HASH);
+    for (uint32_t idx = 0; idx < kCount; idx++) {
+        FlowEntry *flow = flow_list_[order[idx]];
+        EXPECT_EQ(flow, tree.Insert(flow));
+        EXPECT_EQ(flow, hash.Insert(flow));
+        EXPECT_EQ(flow, hash.Insert(flow));
+    }
+    EXPECT_EQ(kCount, hash.size());
+    EXPECT_LE(2 * kCount, hash.slot_count());
+
+    // Delete every other flow, including absent keys
+    for (uint32_t idx = 0; idx < kCount; idx += 2) {
+        const FlowKey &key = flow_list_[order[idx]]->key();
+        EXPECT_TRUE(tree.Erase(key));
+        EXPECT_TRUE(hash.Erase(key));
+        EXPECT_FALSE(hash.Erase(key));
+        EXPECT_FALSE(hash.Erase(BuildKey(idx, true)));
+    }
+    EXPECT_EQ(tree.size(), hash.size());
+
+    for (uint32_t idx = 0; idx < kCount; idx++) {
+        const FlowKey &key = flow_list_[idx]->key();
+        EXPECT_EQ(tree.Find(key), hash.Find(key));
+        EXPECT_TRUE(hash.Find(BuildKey(idx, true)) == NULL);
+    }
+
+    // Walk visits every flow once, also when resumed after each flow
+    std::set<FlowEntry *> walked;
+    for (FlowEntryIndex::iterator it = hash.begin(); it != hash.end(); ++it) {
+        EXPECT_TRUE(walked.insert(*it).second);
+        EXPECT_EQ(*it, tree.Find((*it)->key()));
+    }
+    EXPECT_EQ(hash.size(), walked.size());
+    size_t count = 0;
+    for (FlowEntryIndex::iterator it = hash.begin(); it != hash.end();
+         it = hash.upper_bound((*it)->key())) {
+        count++;
+    }
+    EXPECT_EQ(hash.size(), count);
+
+    // Add back the deleted flows, reusing deleted slots
+    for (uint32_t idx = 0; idx < kCount; idx += 2) {
+        FlowEntry *flow = flow_list_[order[idx]];
+        EXPECT_EQ(flow, hash.Insert(flow));
+    }
+    EXPECT_EQ(kCount, hash.size());
+
+    for (uint32_t idx = 0; idx < kCount; idx++) {
+        EXPECT_TRUE(hash.Erase(flow_list_[idx]->key()));
+        tree.Erase(flow_list_[idx]->key());
+    }
+    EXPECT_TRUE(hash.empty());
+    EXPECT_TRUE(hash.begin() == hash.end());
+}
+
+int main(int argc, char *argv[]) {
+    int ret = 0;
+
+    GETUSERARGS();
+    client = TestInit(init_file, ksync_init, true, true, true, 100*1000);
+    ret = RUN_ALL_TESTS();
+    TestShutdown();
+    delete client;
+    return ret;
+}
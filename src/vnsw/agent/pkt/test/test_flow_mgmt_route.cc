@@ -10,6 +10,7 @@
 #include "oper/tunnel_nh.h"
 #include "pkt/flow_mgmt.h"
 #include "pkt/flow_mgmt/flow_mgmt_dbclient.h"
+#include "oper/agent_profile.h"
 #include <algorithm>
 
 #define vm1_ip "1.1.1.1"
@@ -378,6 +379,38 @@ TEST_F(FlowMgmtRouteTest, RouteAddDelete_6) {
     WAIT_FOR(1000, 10000, (VrfFind("vrf10", true) == false));
 }
 
+// Route add is notified to DB event queue of every partition and queue stats
+// are reported per partition
+TEST_F(FlowMgmtRouteTest, PartitionQueueStats) {
+    std::vector<uint64_t> enqueues;
+    FlowMgmtList::iterator it = flow_mgmt_list_.begin();
+    while (it != flow_mgmt_list_.end()) {
+        enqueues.push_back((*it)->db_event_queue()->NumEnqueues());
+        it++;
+    }
+
+    boost::system::error_code ec;
+    Ip4Address remote_subnet = Ip4Address::from_string("10.10.10.0", ec);
+    Ip4Address remote_compute = Ip4Address::from_string("1.1.1.100", ec);
+    Inet4TunnelRouteAdd(peer_, "vrf1", remote_subnet, 24, remote_compute,
+                        TunnelType::AllType(), 10, "vn1", SecurityGroupList(),
+                        TagList(), PathPreference());
+    client->WaitForIdle();
+
+    for (uint16_t i = 0; i < flow_mgmt_list_.size(); i++) {
+        EXPECT_LT(enqueues[i],
+                  flow_mgmt_list_[i]->db_event_queue()->NumEnqueues());
+    }
+
+    ProfileData data;
+    flow_proto_->SetProfileData(&data);
+    EXPECT_EQ(flow_mgmt_list_.size(), data.flow_.flow_mgmt_queue_.size());
+    EXPECT_EQ(flow_mgmt_list_.size(), data.flow_.flow_mgmt_db_queue_.size());
+
+    DeleteRoute("vrf1", "10.10.10.0", 24, peer_);
+    client->WaitForIdle();
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // UT for bug 1551577
 // Simulate the following scenario,
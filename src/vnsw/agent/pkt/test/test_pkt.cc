@@ -289,6 +289,143 @@ TEST_F(PktTest, tx_vlan_1) {
     client->WaitForIdle();
 }
 
+// Serves count packets, too short to carry an agent header, to
+// ProcessReadBatch and then reports that no more packets are queued
+class TestPktReader {
+public:
+    static const std::size_t kPktLen = 8;
+
+    TestPktReader(uint32_t count) : count_(count), last_buff_(NULL) { }
+    ~TestPktReader() { }
+
+    std::size_t Read(uint8_t *buff, std::size_t len,
+                     boost::system::error_code &error) {
+        last_buff_ = buff;
+        if (count_ == 0) {
+            error = boost::asio::error::would_block;
+            return 0;
+        }
+        count_--;
+        memset(buff, 0, kPktLen);
+        return kPktLen;
+    }
+
+    uint32_t count() const { return count_; }
+    uint8_t *last_buff() const { return last_buff_; }
+
+private:
+    uint32_t count_;
+    uint8_t *last_buff_;
+};
+
+TEST_F(PktTest, RxBufferPool_1) {
+    PacketBufferManager *mgr = agent_->pkt()->packet_buffer_manager();
+
+    // Freed buffer is given back on next allocation
+    uint8_t *buff = mgr->AllocateRxBuffer();
+    std::size_t pool_size = mgr->rx_buffer_pool_size();
+    mgr->FreeRxBuffer(buff);
+    EXPECT_EQ(pool_size + 1, mgr->rx_buffer_pool_size());
+
+    uint64_t reuse = mgr->rx_buffer_reuse();
+    EXPECT_EQ(buff, mgr->AllocateRxBuffer());
+    EXPECT_EQ(reuse + 1, mgr->rx_buffer_reuse());
+    EXPECT_EQ(pool_size, mgr->rx_buffer_pool_size());
+
+    // Buffer goes back to the pool when the packet is released
+    {
+        PacketBufferPtr pkt(mgr->AllocateRx(PktHandler::RX_PACKET, buff,
+                                            TestPktReader::kPktLen, 0));
+        EXPECT_EQ(pool_size, mgr->rx_buffer_pool_size());
+    }
+    EXPECT_EQ(pool_size + 1, mgr->rx_buffer_pool_size());
+}
+
+TEST_F(PktTest, RxBufferPool_2) {
+    PacketBufferManager *mgr = agent_->pkt()->packet_buffer_manager();
+    const std::size_t max_pool_size =
+        PacketBufferManager::kMaxRxBufferPoolSize;
+
+    std::vector<uint8_t *> buff_list;
+    for (uint32_t i = 0; i <= max_pool_size; i++) {
+        buff_list.push_back(mgr->AllocateRxBuffer());
+    }
+    EXPECT_EQ(0U, mgr->rx_buffer_pool_size());
+
+    // Buffers freed beyond the bound are deleted
+    uint64_t alloc = mgr->rx_buffer_alloc();
+    for (std::vector<uint8_t *>::iterator it = buff_list.begin();
+         it != buff_list.end(); ++it) {
+        mgr->FreeRxBuffer(*it);
+    }
+    EXPECT_EQ(max_pool_size, mgr->rx_buffer_pool_size());
+
+    for (uint32_t i = 0; i < max_pool_size; i++) {
+        buff_list[i] = mgr->AllocateRxBuffer();
+    }
+    EXPECT_EQ(alloc, mgr->rx_buffer_alloc());
+    EXPECT_EQ(0U, mgr->rx_buffer_pool_size());
+    for (uint32_t i = 0; i < max_pool_size; i++) {
+        mgr->FreeRxBuffer(buff_list[i]);
+    }
+}
+
+// Packets queued on the interface are processed in the same batch as the
+// packet which woke up the reader
+TEST_F(PktTest, ReadBatch_1) {
+    PacketBufferManager *mgr = agent_->pkt()->packet_buffer_manager();
+    AgentStats *stats = agent_->stats();
+    uint64_t batches = stats->pkt_rx_batches();
+    uint64_t batch_pkts = stats->pkt_rx_batch_pkts();
+    uint64_t invalid = stats->pkt_invalid_agent_hdr();
+
+    TestPktReader reader(4);
+    uint8_t *buff = mgr->AllocateRxBuffer();
+    memset(buff, 0, TestPktReader::kPktLen);
+    uint32_t count = client->agent_init()->pkt0()->ProcessReadBatch
+        (buff, TestPktReader::kPktLen,
+         boost::bind(&TestPktReader::Read, &reader, _1, _2, _3));
+    client->WaitForIdle();
+
+    EXPECT_EQ(5U, count);
+    EXPECT_EQ(0U, reader.count());
+    EXPECT_EQ(batches + 1, stats->pkt_rx_batches());
+    EXPECT_EQ(batch_pkts + 5, stats->pkt_rx_batch_pkts());
+    EXPECT_TRUE(stats->pkt_rx_max_batch() >= 5U);
+    EXPECT_EQ(invalid + 5, stats->pkt_invalid_agent_hdr());
+
+    // Buffer of the failed read is returned to the pool
+    EXPECT_EQ(reader.last_buff(), mgr->AllocateRxBuffer());
+    mgr->FreeRxBuffer(reader.last_buff());
+}
+
+// Batch is limited to kMaxReadBatch packets
+TEST_F(PktTest, ReadBatch_2) {
+    PacketBufferManager *mgr = agent_->pkt()->packet_buffer_manager();
+    AgentStats *stats = agent_->stats();
+    const uint32_t max_batch = ControlInterface::kMaxReadBatch;
+    uint64_t batches = stats->pkt_rx_batches();
+    uint64_t batch_pkts = stats->pkt_rx_batch_pkts();
+    uint64_t invalid = stats->pkt_invalid_agent_hdr();
+
+    TestPktReader reader(2 * max_batch);
+    uint8_t *buff = mgr->AllocateRxBuffer();
+    memset(buff, 0, TestPktReader::kPktLen);
+    uint32_t count = client->agent_init()->pkt0()->ProcessReadBatch
+        (buff, TestPktReader::kPktLen,
+         boost::bind(&TestPktReader::Read, &reader, _1, _2, _3));
+    client->WaitForIdle();
+
+    EXPECT_EQ(max_batch, count);
+    EXPECT_EQ(max_batch + 1, reader.count());
+    EXPECT_EQ(batches + 1, stats->pkt_rx_batches());
+    EXPECT_EQ(batch_pkts + max_batch, stats->pkt_rx_batch_pkts());
+    EXPECT_EQ(max_batch, stats->pkt_rx_max_batch());
+    EXPECT_EQ(invalid + max_batch, stats->pkt_invalid_agent_hdr());
+    EXPECT_EQ((stats->pkt_rx_batch_usecs() * 1000) /
+              stats->pkt_rx_batch_pkts(), stats->pkt_rx_cost_nsecs());
+}
+
 int main(int argc, char *argv[]) {
     GETUSERARGS();
 
@@ -4,8 +4,11 @@
 #ifndef vnsw_agent_pkt_vrouter_pkt_io_hpp
 #define vnsw_agent_pkt_vrouter_pkt_io_hpp
 
+#include "base/time_util.h"
 #include "control_interface.h"
 #include "cmn/agent_stats.h"
+#include "pkt/pkt_init.h"
+#include "pkt/packet_buffer.h"
 #include "vr_types.h"
 #include "vr_defs.h"
 #include "vr_mpls.h"
@@ -116,6 +119,43 @@ public:
         return ControlInterface::Process(hdr, pkt);
     }
 
+    // Non-blocking read of a packet into buff. Sets error when there is no
+    // packet to read
+    typedef boost::function<std::size_t(uint8_t *buff, std::size_t len,
+                                        boost::system::error_code &error)>
+        ReadCallback;
+
+    // Handle packet of length bytes read into buff, a buffer got from
+    // PacketBufferManager::AllocateRxBuffer. Packets already queued on the
+    // interface are then read with read_cb and processed, upto kMaxReadBatch
+    // packets in all, before waiting for the next read event.
+    // Returns number of packets processed
+    uint32_t ProcessReadBatch(uint8_t *buff, std::size_t length,
+                              ReadCallback read_cb) {
+        Agent *agent = pkt_handler()->agent();
+        PacketBufferManager *mgr = agent->pkt()->packet_buffer_manager();
+        uint64_t start = ClockMonotonicUsec();
+        uint32_t count = 0;
+        while (true) {
+            PacketBufferPtr pkt(mgr->AllocateRx(PktHandler::RX_PACKET, buff,
+                                                length, 0));
+            Process(pkt);
+            if (++count >= kMaxReadBatch)
+                break;
+
+            boost::system::error_code error;
+            buff = mgr->AllocateRxBuffer();
+            length = read_cb(buff, mgr->rx_buffer_len(), error);
+            if (error) {
+                mgr->FreeRxBuffer(buff);
+                break;
+            }
+        }
+        agent->stats()->incr_pkt_rx_batch(count,
+                                          ClockMonotonicUsec() - start);
+        return count;
+    }
+
     int EncodeAgentHdr(uint8_t *buff, const AgentHdr &hdr) {
         memset(buff, 0, sizeof(agent_hdr));
 
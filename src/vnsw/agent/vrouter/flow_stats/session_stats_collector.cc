@@ -1376,11 +1376,11 @@ void SessionStatsCollector::CopyFlowInfo(SessionStatsInfo &session,
     }
 
     if (fe->IsIngressFlow()) {
-        info.vm_cfg_name = fe->data().vm_cfg_name;
+        info.vm_cfg_name = fe->data().vm_cfg_name.get();
     } else if (rfe) {
         /* TODO: vm_cfg_name should be passed in RevFlowDepParams because rfe
          * may now point to different UUID altogether */
-        info.vm_cfg_name = rfe->data().vm_cfg_name;
+        info.vm_cfg_name = rfe->data().vm_cfg_name.get();
     }
     string rid = agent_uve_->agent()->router_id().to_string();
     if (fe->is_flags_set(FlowEntry::LocalFlow)) {
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <pugixml/pugixml.hpp>
+
+#include "base/logging.h"
+#include "xml/xml_pugi.h"
+#include "xmpp/xmpp_item_reader.h"
+#include "xmpp/xmpp_proto.h"
+
+#include "testing/gunit.h"
+
+using std::ostringstream;
+using std::string;
+using std::vector;
+
+class XmppDecodeTest : public ::testing::Test {
+protected:
+    static string BuildItem(int idx) {
+        ostringstream oss;
+        oss << "<item id=\"10." << (idx >> 16) << "." << ((idx >> 8) & 0xFF)
+            << "." << (idx & 0xFF) << "/32\"><entry><nlri><af>1</af>"
+            << "<safi>1</safi><address>10." << (idx >> 16) << "."
+            << ((idx >> 8) & 0xFF) << "." << (idx & 0xFF) << "/32</address>"
+            << "</nlri><next-hops><next-hop><af>1</af>"
+            << "<address>192.168.1.1</address><label>" << 16 + idx
+            << "</label><tunnel-encapsulation-list>"
+            << "<tunnel-encapsulation>gre</tunnel-encapsulation>"
+            << "</tunnel-encapsulation-list></next-hop></next-hops>"
+            << "<version>1</version>"
+            << "<virtual-network>default-domain:demo:vn1</virtual-network>"
+            << "<sequence-number>0</sequence-number>"
+            << "<security-group-list><security-group>8000001</security-group>"
+            << "</security-group-list>"
+            << "<local-preference>100</local-preference>"
+            << "</entry></item>";
+        return oss.str();
+    }
+
+    static string BuildStanzaWithItems(const string &items) {
+        return "<iq type=\"set\" from=\"agent@vnsw.contrailsystems.com"
+            "\" to=\"network-control@contrailsystems.com/bgp-peer\" "
+            "id=\"pubsub1\"><pubsub xmlns=\"http://jabber.org/protocol/pubsub"
+            "\"><publish node=\"1/1/blue/10.0.0.1/32\">" + items +
+            "</publish></pubsub></iq>";
+    }
+
+    static string BuildStanza(int count) {
+        string items;
+        for (int idx = 0; idx < count; ++idx) {
+            items += BuildItem(idx);
+        }
+        return BuildStanzaWithItems(items);
+    }
+
+    // Verify that the items read from the text are the same as the ones in
+    // the document.
+    static void VerifyStream(const string &items, size_t count) {
+        string stanza = BuildStanzaWithItems(items);
+        vector<string> document_items, stream_items;
+        EXPECT_EQ(count, DecodeDocument(stanza, &document_items));
+        EXPECT_EQ(count, DecodeStream(stanza, &stream_items));
+        EXPECT_EQ(document_items, stream_items);
+    }
+
+    // Read the items from the text and return the number of bad items.
+    static size_t ReadText(const string &text, vector<string> *items) {
+        XmlPugi dom;
+        EXPECT_NE(-1, dom.LoadDoc(BuildStanzaWithItems("")));
+        XmppItemReader reader(&dom, text);
+        ReadItems(&reader, items);
+        return reader.error_count();
+    }
+
+    // Parse the stanza into a document and read all the items.
+    static size_t DecodeDocument(const string &stanza,
+                                 vector<string> *items) {
+        XmlPugi dom;
+        string text;
+        EXPECT_NE(-1, dom.LoadDoc(stanza));
+        XmppItemReader reader(&dom, text);
+        return ReadItems(&reader, items);
+    }
+
+    // Parse the stanza without the items into a document and read the
+    // items one at a time.
+    static size_t DecodeStream(const string &stanza, vector<string> *items) {
+        string header, text;
+        EXPECT_TRUE(XmppProto::SplitPublishItems(stanza, &header, &text));
+        XmlPugi dom;
+        EXPECT_NE(-1, dom.LoadDoc(header));
+        EXPECT_TRUE(dom.FindNode("publish"));
+        XmppItemReader reader(&dom, text);
+        size_t count = ReadItems(&reader, items);
+        EXPECT_EQ(count, reader.item_count());
+        EXPECT_EQ(0, reader.error_count());
+        return count;
+    }
+
+    static size_t ReadItems(XmppItemReader *reader, vector<string> *items) {
+        size_t count = 0;
+        for (pugi::xml_node item = reader->Next(); item;
+             item = reader->Next()) {
+            EXPECT_STREQ("item", item.name());
+            if (items) {
+                ostringstream oss;
+                item.print(oss, "", pugi::format_raw);
+                items->push_back(oss.str());
+            }
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(XmppDecodeTest, SplitPublishItems) {
+    string header, items;
+    string stanza = BuildStanza(2);
+    EXPECT_TRUE(XmppProto::SplitPublishItems(stanza, &header, &items));
+    EXPECT_EQ(BuildItem(0) + BuildItem(1), items);
+    EXPECT_EQ(stanza.size(), header.size() + items.size());
+    EXPECT_NE(string::npos, header.find("</publish></pubsub></iq>"));
+
+    // Nothing to split without items.
+    EXPECT_FALSE(XmppProto::SplitPublishItems(
+        "<iq type=\"set\"><pubsub><publish node=\"x\"/></pubsub></iq>",
+        &header, &items));
+    EXPECT_FALSE(XmppProto::SplitPublishItems(
+        "<iq type=\"set\"><pubsub><subscribe node=\"x\"/></pubsub></iq>",
+        &header, &items));
+    EXPECT_FALSE(XmppProto::SplitPublishItems(
+        "<iq type=\"set\"><pubsub><publish-options/></pubsub></iq>",
+        &header, &items));
+
+    // Comments outside the publish element are left to the parser.
+    EXPECT_FALSE(XmppProto::SplitPublishItems(
+        "<iq type=\"set\"><pubsub><!-- <publish> --><publish node=\"x\">"
+        "<item id=\"a\"/></publish></pubsub></iq>", &header, &items));
+
+    // A '>' in an attribute value of the publish element.
+    EXPECT_TRUE(XmppProto::SplitPublishItems(
+        "<iq type=\"set\"><pubsub><publish node=\"x>y\">"
+        "<item id=\"a\"/></publish></pubsub></iq>", &header, &items));
+    EXPECT_EQ("<item id=\"a\"/>", items);
+}
+
+// Items read from the text should be the same as the ones in the document.
+TEST_F(XmppDecodeTest, ItemReader) {
+    string stanza = BuildStanza(16);
+    stanza.insert(stanza.find("<item"), "<item id=\"empty\"/>");
+    vector<string> document_items, stream_items;
+    DecodeDocument(stanza, &document_items);
+    DecodeStream(stanza, &stream_items);
+    EXPECT_EQ(17, document_items.size());
+    EXPECT_EQ(document_items, stream_items);
+}
+
+// Comments between and within items.
+TEST_F(XmppDecodeTest, ItemComment) {
+    string items = "<!-- <item id=\"commented\"/> -->" + BuildItem(0) +
+        "<!-- </item> -->" + BuildItem(1);
+    string item = BuildItem(2);
+    item.insert(item.find("<entry>"), "<!-- </item> <item> -->");
+    VerifyStream(items + item, 3);
+}
+
+// CDATA sections with markup in an item.
+TEST_F(XmppDecodeTest, ItemCdata) {
+    string item = BuildItem(0);
+    item.insert(item.find("</virtual-network>"),
+                "<![CDATA[</item><item id=\"x\">]]>");
+    VerifyStream(item + BuildItem(1), 2);
+}
+
+// Quoted attribute values containing '>' and '/>'.
+TEST_F(XmppDecodeTest, ItemQuotedAttribute) {
+    string items = "<item id=\"a>b\"/><item id='c/>'></item>" +
+        BuildItem(0) + "<item id=\"x\"><entry x='/>'/></item>";
+    VerifyStream(items, 4);
+}
+
+// Items that can't be parsed are skipped and counted as errors.
+TEST_F(XmppDecodeTest, ItemParseFailure) {
+    vector<string> items;
+    EXPECT_EQ(0, ReadText("", &items));
+    EXPECT_EQ(0, items.size());
+    EXPECT_EQ(0, ReadText("<!-- no items -->", &items));
+    EXPECT_EQ(0, items.size());
+
+    // Unquoted attribute value.
+    string bad_item = "<item id=\"bad\"><entry x=1></entry></item>";
+    EXPECT_EQ(1, ReadText(BuildItem(0) + bad_item + BuildItem(1), &items));
+    EXPECT_EQ(2, items.size());
+
+    // Only bad items.
+    items.clear();
+    EXPECT_EQ(1, ReadText(bad_item, &items));
+    EXPECT_EQ(0, items.size());
+
+    // Reading stops at an item that isn't terminated.
+    string item = BuildItem(1);
+    EXPECT_EQ(1, ReadText(BuildItem(0) + item.substr(0, item.size() / 2),
+                          &items));
+    EXPECT_EQ(1, items.size());
+    items.clear();
+    EXPECT_EQ(1, ReadText(BuildItem(0) + "<!-- " + BuildItem(1), &items));
+    EXPECT_EQ(1, items.size());
+}
+
+int main(int argc, char **argv) {
+    LoggingInit();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -15,7 +15,8 @@ XmppChannelConfig::XmppChannelConfig(bool isClient) :
      ToAddr(""), FromAddr(""), NodeAddr(""), logUVE(false), auth_enabled(false),
      path_to_server_cert(""), path_to_server_priv_key(""), path_to_ca_cert(""),
      tcp_hold_time(XmppChannelConfig::kTcpHoldTime), gr_helper_disable(false),
-     xmpp_hold_time(90), dscp_value(0), isClient_(isClient)  {
+     xmpp_hold_time(90), dscp_value(0), stream_items(false),
+     isClient_(isClient)  {
 }
 
 int XmppChannelConfig::CompareTo(const XmppChannelConfig &rhs) const {
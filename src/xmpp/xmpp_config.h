@@ -33,6 +33,7 @@ public:
     int xmpp_hold_time; // was uint8_t, but int everywhere
     uint8_t dscp_value;
     std::string xmlns;
+    bool stream_items;
 
     int CompareTo(const XmppChannelConfig &rhs) const;
     static int const default_client_port = 5269;
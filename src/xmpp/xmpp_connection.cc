@@ -56,7 +56,8 @@ XmppConnection::XmppConnection(TcpServer *server,
       from_(config->FromAddr),
       to_(config->ToAddr),
       auth_enabled_(config->auth_enabled),
-      dscp_value_(config->dscp_value), xmlns_(config->xmlns),
+      dscp_value_(config->dscp_value),
+      stream_items_(config->stream_items), xmlns_(config->xmlns),
       state_machine_(XmppStaticObjectFactory::Create<XmppStateMachine>(
           this, config->ClientOnly(), config->auth_enabled, config->xmpp_hold_time)),
       mux_(XmppStaticObjectFactory::Create<XmppChannelMux>(this)) {
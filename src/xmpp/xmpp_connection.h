@@ -229,6 +229,7 @@ public:
     }
     uint8_t dscp_value() const { return dscp_value_; }
     int SetDscpValue(uint8_t value);
+    bool stream_items() const { return stream_items_; }
 
     void inc_connect_error();
     void inc_session_close();
@@ -280,6 +281,7 @@ private:
     std::string to_;
     bool auth_enabled_;
     uint8_t dscp_value_;
+    bool stream_items_;
     std::string xmlns_;
     mutable std::string uve_key_str_;
 
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#include "xmpp/xmpp_item_reader.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "xml/xml_pugi.h"
+#include "xmpp/xmpp_str.h"
+
+using pugi::xml_node;
+using std::string;
+
+XmppItemReader::XmppItemReader(const XmppStanza::XmppMessageIq *iq)
+    : dom_(static_cast<XmlPugi *>(iq->dom.get())),
+      items_(iq->items),
+      pos_(0),
+      started_(false),
+      item_count_(0),
+      error_count_(0),
+      max_item_size_(0) {
+}
+
+XmppItemReader::XmppItemReader(XmlBase *dom, const string &items)
+    : dom_(static_cast<XmlPugi *>(dom)),
+      items_(items),
+      pos_(0),
+      started_(false),
+      item_count_(0),
+      error_count_(0),
+      max_item_size_(0) {
+}
+
+//
+// Return the next item or a null node when there are no more items.
+//
+xml_node XmppItemReader::Next() {
+    xml_node node = items_.empty() ? NextInDom() : NextInText();
+    if (node)
+        item_count_++;
+    return node;
+}
+
+xml_node XmppItemReader::NextInDom() {
+    if (!started_) {
+        started_ = true;
+        node_ = dom_->FindNode("item");
+    } else if (node_) {
+        node_ = node_.next_sibling();
+    }
+    while (node_ && strcmp(node_.name(), "item") != 0) {
+        node_ = node_.next_sibling();
+    }
+    return node_;
+}
+
+//
+// Return the position after the comment, CDATA section, processing
+// instruction or declaration at pos, or npos if it is not terminated.
+//
+static size_t SkipMarkup(const string &text, size_t pos) {
+    const char *terminator;
+    if (text.compare(pos, 4, "<!--") == 0) {
+        terminator = "-->";
+    } else if (text.compare(pos, 9, "<![CDATA[") == 0) {
+        terminator = "]]>";
+    } else if (text.compare(pos, 2, "<?") == 0) {
+        terminator = "?>";
+    } else {
+        terminator = ">";
+    }
+    size_t end = text.find(terminator, pos + 2);
+    if (end == string::npos)
+        return string::npos;
+    return end + strlen(terminator);
+}
+
+static bool IsMarkup(const string &text, size_t pos) {
+    return pos + 1 < text.size() &&
+        (text[pos + 1] == '!' || text[pos + 1] == '?');
+}
+
+//
+// Return the position of the '>' that ends the tag at pos, or npos if it is
+// not terminated. A '>' within a quoted attribute value doesn't end the tag.
+//
+static size_t FindTagEnd(const string &text, size_t pos) {
+    char quote = 0;
+    for (size_t idx = pos + 1; idx < text.size(); ++idx) {
+        char c = text[idx];
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return idx;
+        }
+    }
+    return string::npos;
+}
+
+//
+// Return the position after the end of the element whose start tag is at
+// pos, or npos if the element is not terminated.
+//
+static size_t FindElementEnd(const string &text, size_t pos) {
+    int depth = 0;
+    while ((pos = text.find('<', pos)) != string::npos) {
+        if (IsMarkup(text, pos)) {
+            pos = SkipMarkup(text, pos);
+            if (pos == string::npos)
+                break;
+            continue;
+        }
+        size_t tag_end = FindTagEnd(text, pos);
+        if (tag_end == string::npos)
+            break;
+        if (text[pos + 1] == '/') {
+            depth--;
+        } else if (text[tag_end - 1] != '/') {
+            depth++;
+        }
+        pos = tag_end + 1;
+        if (depth <= 0)
+            return depth == 0 ? pos : string::npos;
+    }
+    return string::npos;
+}
+
+static bool IsItem(const string &text, size_t pos) {
+    static const size_t kItemOpenSize = strlen(sXMPP_ITEM_O);
+    if (text.compare(pos, kItemOpenSize, sXMPP_ITEM_O) != 0)
+        return false;
+    size_t name_end = pos + kItemOpenSize;
+    return name_end < text.size() && (text[name_end] == '>' ||
+        text[name_end] == '/' || isspace(text[name_end]));
+}
+
+//
+// Find the next item element in the text and parse it. Other elements and
+// markup between the items are skipped, as in the dom. An item that can't
+// be parsed is skipped and counted as an error. Reading stops with an error
+// if the end of an element can't be found.
+//
+xml_node XmppItemReader::NextInText() {
+    doc_.reset();
+    while ((pos_ = items_.find('<', pos_)) != string::npos) {
+        size_t start = pos_;
+        if (IsMarkup(items_, start)) {
+            pos_ = SkipMarkup(items_, start);
+        } else {
+            pos_ = FindElementEnd(items_, start);
+        }
+        if (pos_ == string::npos) {
+            error_count_++;
+            break;
+        }
+        if (!IsItem(items_, start))
+            continue;
+
+        size_t size = pos_ - start;
+        pugi::xml_parse_result result =
+            doc_.load_buffer(items_.c_str() + start, size);
+        if (!result) {
+            error_count_++;
+            continue;
+        }
+        if (size > max_item_size_)
+            max_item_size_ = size;
+        return doc_.first_child();
+    }
+
+    pos_ = items_.size();
+    return xml_node();
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 OpenSDN Project. All rights reserved.
+ */
+
+#ifndef __XMPP_ITEM_READER_H__
+#define __XMPP_ITEM_READER_H__
+
+#include <string>
+
+#include <pugixml/pugixml.hpp>
+
+#include "base/util.h"
+#include "xmpp/xmpp_proto.h"
+
+class XmlPugi;
+
+//
+// Iterates over the items published in an iq stanza.
+//
+// If the connection streams items, the items are kept as text in the
+// XmppMessageIq and each one is parsed into a document of its own when the
+// reader gets to it. The document is reused for the next item, so the
+// memory used for parsing is bounded by the size of the largest item rather
+// than that of the stanza. Otherwise the reader simply walks the item nodes
+// in the dom of the stanza.
+//
+// Items in the text that are not well formed are skipped and counted in
+// error_count, so that a null node from Next with a non zero error_count
+// means that the items could not all be read rather than that there were no
+// items in the stanza. Comments, CDATA sections and processing instructions
+// between and within items are handled like the parser does.
+//
+// A node returned by Next is only valid until the following call to Next.
+//
+class XmppItemReader {
+public:
+    explicit XmppItemReader(const XmppStanza::XmppMessageIq *iq);
+    XmppItemReader(XmlBase *dom, const std::string &items);
+
+    pugi::xml_node Next();
+
+    size_t item_count() const { return item_count_; }
+    size_t error_count() const { return error_count_; }
+    size_t max_item_size() const { return max_item_size_; }
+
+private:
+    pugi::xml_node NextInDom();
+    pugi::xml_node NextInText();
+
+    XmlPugi *dom_;
+    const std::string &items_;
+    size_t pos_;
+    bool started_;
+    pugi::xml_node node_;
+    pugi::xml_document doc_;
+    size_t item_count_;
+    size_t error_count_;
+    size_t max_item_size_;
+
+    DISALLOW_COPY_AND_ASSIGN(XmppItemReader);
+};
+
+#endif  // __XMPP_ITEM_READER_H__
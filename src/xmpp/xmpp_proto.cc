@@ -3,6 +3,8 @@
  */
 
 #include "xmpp/xmpp_proto.h"
+#include <ctype.h>
+#include <string.h>
 #include <iostream>
 #include <string>
 #include <boost/algorithm/string/replace.hpp>
@@ -228,6 +230,61 @@ XmppStanza::XmppMessage *XmppProto::Decode(const XmppConnection *connection,
     return msg;
 }
 
+//
+// Split an iq stanza with a publish element into the stanza without the
+// contents of the publish element and the contents themselves i.e. the
+// items. Return false if there's no publish element with contents.
+//
+// The items are found without parsing the stanza. This relies on the stanza
+// having a single publish element and on publish not showing up as the name
+// of any element within an item. Stanzas with comments, CDATA sections or
+// declarations outside the publish element are left to the parser, since
+// they could hide or imitate the publish tags.
+//
+bool XmppProto::SplitPublishItems(const string &ts, string *header,
+                                  string *items) {
+    static const size_t kPublishOpenSize = strlen(sXMPP_PUBLISH_O);
+    size_t start = ts.find(sXMPP_PUBLISH_O);
+    if (start == string::npos)
+        return false;
+    size_t markup = ts.find("<!");
+    if (markup != string::npos && markup < start)
+        return false;
+    size_t name_end = start + kPublishOpenSize;
+    if (name_end >= ts.size() ||
+        (ts[name_end] != '>' && !isspace(ts[name_end]))) {
+        return false;
+    }
+
+    // Find the end of the start tag, skipping quoted attribute values.
+    char quote = 0;
+    for (start = name_end; start < ts.size(); ++start) {
+        if (quote) {
+            if (ts[start] == quote)
+                quote = 0;
+        } else if (ts[start] == '"' || ts[start] == '\'') {
+            quote = ts[start];
+        } else if (ts[start] == '>') {
+            break;
+        }
+    }
+    if (start == ts.size() || ts[start - 1] == '/')
+        return false;
+    start++;
+    size_t end = ts.rfind(sXMPP_PUBLISH_C);
+    if (end == string::npos || end < start)
+        return false;
+    if (ts.find("<!", end) != string::npos)
+        return false;
+
+    items->assign(ts, start, end - start);
+    header->clear();
+    header->reserve(ts.size() - items->size());
+    header->append(ts, 0, start);
+    header->append(ts, end, string::npos);
+    return true;
+}
+
 XmppStanza::XmppMessage *XmppProto::DecodeInternal(
         const XmppConnection *connection, const string &ts, XmlBase *impl) {
     XmppStanza::XmppMessage *ret = nullptr;
@@ -238,8 +295,18 @@ XmppStanza::XmppMessage *XmppProto::DecodeInternal(
 
     if (ts.find(sXMPP_IQ) != string::npos) {
         string ts_tmp = ts;
-
-        if (impl->LoadDoc(ts) == -1) {
+        string items;
+
+        // Only the iq header goes into the document if the items can be
+        // streamed.
+        if (connection && connection->stream_items() &&
+            SplitPublishItems(ts, &ts_tmp, &items)) {
+            if (impl->LoadDoc(ts_tmp) == -1) {
+                XMPP_WARNING(XmppIqMessageParseFail, connection->ToUVEKey(),
+                             XMPP_PEER_DIR_IN);
+                goto done;
+            }
+        } else if (impl->LoadDoc(ts) == -1) {
             XMPP_WARNING(XmppIqMessageParseFail, connection->ToUVEKey(),
                          XMPP_PEER_DIR_IN);
             assert(false);
@@ -247,6 +314,7 @@ XmppStanza::XmppMessage *XmppProto::DecodeInternal(
         }
 
         XmppStanza::XmppMessageIq *msg = new XmppStanza::XmppMessageIq;
+        msg->items.swap(items);
         impl->ReadNode(iq);
         msg->to = XmppProto::GetTo(impl);
         msg->from = XmppProto::GetFrom(impl);
@@ -160,6 +160,11 @@ public:
         std::string action;
         std::string as_node;
         bool is_as_node;
+
+        // Contents of the publish element of a set request if the connection
+        // streams items. The items are not part of the dom in this case and
+        // are parsed one at a time by XmppItemReader.
+        std::string items;
     };
 
     XmppStanza();
@@ -189,6 +194,8 @@ public:
     static int EncodePresence(uint8_t *data, size_t size);
     static int EncodeIq(const XmppMessageIq *iq, XmlBase *doc,
                         uint8_t *data, size_t size);
+    static bool SplitPublishItems(const std::string &ts, std::string *header,
+                                  std::string *items);
 
 private:
     static int EncodeOpen(uint8_t *data, std::string &to, std::string &from,
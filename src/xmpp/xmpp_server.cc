@@ -64,6 +64,7 @@ XmppServer::XmppServer(EventManager *evm, const string &server_addr,
       tcp_hold_time_(config->tcp_hold_time),
       gr_helper_disable_(config->gr_helper_disable),
       dscp_value_(0),
+      stream_items_(false),
       connection_queue_(TaskScheduler::GetInstance()->GetTaskId("bgp::Config"),
           0, boost::bind(&XmppServer::DequeueConnection, this, _1)) {
 
@@ -211,6 +212,7 @@ XmppServer::XmppServer(EventManager *evm, const string &server_addr)
       gr_helper_disable_(false),
       xmpp_config_updater_(NULL),
       dscp_value_(0),
+      stream_items_(false),
       connection_queue_(TaskScheduler::GetInstance()->GetTaskId("bgp::Config"),
           0, boost::bind(&XmppServer::DequeueConnection, this, _1)) {
 }
@@ -227,6 +229,7 @@ XmppServer::XmppServer(EventManager *evm)
       tcp_hold_time_(XmppChannelConfig::kTcpHoldTime),
       gr_helper_disable_(false),
       dscp_value_(0),
+      stream_items_(false),
       connection_queue_(TaskScheduler::GetInstance()->GetTaskId("bgp::Config"),
           0, boost::bind(&XmppServer::DequeueConnection, this, _1)) {
 }
@@ -573,6 +576,7 @@ XmppServerConnection *XmppServer::CreateConnection(XmppSession *session) {
     cfg.logUVE = log_uve_;
     cfg.auth_enabled = auth_enabled_;
     cfg.dscp_value = dscp_value_;
+    cfg.stream_items = stream_items_;
 
     XMPP_DEBUG(XmppCreateConnection, session->ToUVEKey(), XMPP_PEER_DIR_OUT,
                session->ToString());
@@ -102,6 +102,13 @@ public:
     }
     void SetDscpValue(uint8_t value);
     uint8_t dscp_value() const { return dscp_value_; }
+
+    // Keep the items of published iq stanzas as text instead of parsing
+    // them into the document, see XmppItemReader. Applies to connections
+    // accepted after the call.
+    bool stream_items() const { return stream_items_; }
+    void set_stream_items(bool stream_items) { stream_items_ = stream_items; }
+
     const std::string subcluster_name() const {
         return subcluster_name_;
     }
@@ -151,6 +158,7 @@ private:
     bool gr_helper_disable_;
     boost::scoped_ptr<XmppConfigUpdater> xmpp_config_updater_;
     uint8_t dscp_value_;
+    bool stream_items_;
     std::string subcluster_name_;
     WorkQueue<XmppServerConnection *> connection_queue_;
 
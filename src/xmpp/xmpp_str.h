@@ -23,6 +23,10 @@
 #define sXMPP_STREAM_FAILURE_O      "<failure"
 #define sXMPP_STREAM_PROCEED_O      "<proceed"
 #define sXMPP_REQUIRED_O            "<required"
+#define sXMPP_PUBLISH_O             "<publish"
+#define sXMPP_PUBLISH_C             "</publish>"
+#define sXMPP_ITEM_O                "<item"
+#define sXMPP_ITEM_C                "</item>"
 
 
 #define sXMPP_VERSION_1_GLOBAL      "<?xml version='1.0'?>"